@@ -0,0 +1,87 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <dirent.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// Where make bench-pages records pages from the sites the program reads
+#define BENCH_PAGES "bench/pages"
+
+// How long each case is repeated for; the result is the mean per call
+#define BENCH_SECONDS 0.5
+
+// Results fold into this so the compiler can't drop the work
+static volatile size_t bench_sink;
+
+static inline double bench_now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Seconds per call of fn(arg), over at least BENCH_SECONDS
+static inline double bench_run(void (*fn)(void*), void* arg) {
+  long calls = 0;
+  double start = bench_now(), elapsed;
+  do {
+    fn(arg);
+    calls++;
+  } while ((elapsed = bench_now() - start) < BENCH_SECONDS);
+  return elapsed / calls;
+}
+
+static inline void bench_report(const char* name, size_t bytes, double seconds) {
+  printf("  %-32s %9.1f MB/s\n", name, bytes / seconds / 1e6);
+}
+
+typedef struct {
+  char name[256];
+  char* html; // NUL-terminated
+  size_t len;
+} BenchPage;
+
+static inline int bench_is_html(const struct dirent* e) {
+  size_t len = strlen(e->d_name);
+  return len > 5 && strcmp(e->d_name + len - 5, ".html") == 0;
+}
+
+// Reads every .html file in dir, by name; returns how many, 0 if none
+static inline int bench_load_pages(const char* dir, BenchPage** pages) {
+  struct dirent** names;
+  int n = scandir(dir, &names, bench_is_html, alphasort);
+  if (n <= 0) return 0;
+
+  int count = 0;
+  *pages = calloc(n, sizeof(BenchPage));
+  for (int i = 0; i < n; i++) {
+    char path[4096];
+    snprintf(path, sizeof(path), "%s/%s", dir, names[i]->d_name);
+    FILE* f = *pages ? fopen(path, "rb") : NULL;
+    long len = f && fseek(f, 0, SEEK_END) == 0 ? ftell(f) : -1;
+    char* html = len > 0 ? malloc(len + 1) : NULL;
+    if (html) rewind(f);
+    if (html && fread(html, 1, len, f) == (size_t)len) {
+      BenchPage* page = &(*pages)[count++];
+      html[len] = '\0';
+      page->html = html;
+      page->len = len;
+      snprintf(page->name, sizeof(page->name), "%s", names[i]->d_name);
+    } else {
+      free(html);
+    }
+    if (f) fclose(f);
+    free(names[i]);
+  }
+  free(names);
+  return count;
+}
+
+static inline void bench_free_pages(BenchPage* pages, int count) {
+  for (int i = 0; i < count; i++) free(pages[i].html);
+  free(pages);
+}
+
+#endif
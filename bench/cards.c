@@ -0,0 +1,192 @@
+#define _POSIX_C_SOURCE 200809L
+
+// Search-result card parsing: the one-pass Aho-Corasick parser against the
+// strstr() rescans with a fixed 1000-byte skip that it replaced, on
+// recorded search pages (or a directory of them given as the argument)
+// and on synthetic ones with cards shorter and longer than the skip
+
+#include "bench.h"
+#include "webnovel.h"
+
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CARDS 12
+#define OLD_MAX 15 // The old loop could fill this many rows
+
+// A results page of CARDS cards, each padded to about card_bytes
+static char* make_page(size_t card_bytes) {
+  char* html = malloc(CARDS * (card_bytes + 1024) + 1024);
+  size_t n = sprintf(html, "<html><body><div class=\"results\">");
+  for (int i = 0; i < CARDS; i++) {
+    size_t start = n;
+    n += sprintf(html + n,
+                 "<a href=\"/novel/novel-%d\"><div class=\"mantine-Card-root\">"
+                 "<div class=\"mantine-807m0k\">⭐ %d.%d</div>"
+                 "<div class=\"mantine-pdrfb7\">Novel Number %d &amp; Friends</div>"
+                 "<div class=\"mantine-w7z63c\">Views: %d,000</div>"
+                 "<div class=\"mantine-175mpop\">Chapters: %d</div>",
+                 i, 3 + i % 2, i % 10, i, 10 + i, 100 + i);
+    while (n - start < card_bytes) n += sprintf(html + n, "<span class=\"tag\">filler</span>");
+    n += sprintf(html + n, "</div></a>");
+  }
+  sprintf(html + n, "</div></body></html>");
+  return html;
+}
+
+// The parser before the Aho-Corasick pass, kept as it was
+static int extract_strstr(char* html, char titles[][256], char yearly_views[][256], char chapters[][256],
+                          char ratings[][256], char slugs[][256]) {
+  int count = 0;
+  char* card_pos = html;
+  while (count < OLD_MAX) {
+    char* slug_pos = strstr(card_pos, "/novel/");
+    if (!slug_pos) break;
+    slug_pos += 7;
+    char* slug_end = strchr(slug_pos, '"');
+    if (slug_end && slug_end - slug_pos < 100) {
+      int len = slug_end - slug_pos;
+      strncpy(slugs[count], slug_pos, len);
+      slugs[count][len] = '\0';
+    }
+
+    card_pos = strstr(card_pos, "mantine-Card-root");
+    if (!card_pos) break;
+
+    char* rating_pos = strstr(card_pos, "mantine-807m0k");
+    if (rating_pos && (rating_pos = strstr(rating_pos, "⭐"))) {
+      rating_pos += 2;
+      while (*rating_pos && !isdigit((unsigned char)*rating_pos)) rating_pos++;
+      char* rating_end = rating_pos;
+      while (*rating_end && (*rating_end == '.' || isdigit((unsigned char)*rating_end))) rating_end++;
+      int len = rating_end - rating_pos;
+      if (len > 0 && len < 10) {
+        strncpy(ratings[count], rating_pos, len);
+        ratings[count][len] = '\0';
+      }
+    }
+
+    char* title_pos = strstr(card_pos, "mantine-pdrfb7");
+    if (title_pos && (title_pos = strstr(title_pos, ">"))) {
+      title_pos++;
+      char* title_end = strchr(title_pos, '<');
+      if (title_end && title_end - title_pos > 3 && title_end - title_pos < 80) {
+        int len = title_end - title_pos;
+        strncpy(titles[count], title_pos, len);
+        titles[count][len] = '\0';
+      }
+    }
+
+    char* views_pos = strstr(card_pos, "mantine-w7z63c");
+    if (views_pos && (views_pos = strstr(views_pos, "Views:"))) {
+      views_pos += 6;
+      while (*views_pos && !isdigit((unsigned char)*views_pos)) views_pos++;
+      char* views_end = views_pos;
+      while (*views_end && !isspace((unsigned char)*views_end) && *views_end != '<') views_end++;
+      int len = views_end - views_pos;
+      if (len > 0 && len < 20) {
+        strncpy(yearly_views[count], views_pos, len);
+        yearly_views[count][len] = '\0';
+      }
+    }
+
+    char* chap_pos = strstr(card_pos, "mantine-175mpop");
+    if (chap_pos && (chap_pos = strstr(chap_pos, "Chapters:"))) {
+      chap_pos += 9;
+      while (*chap_pos && !isdigit((unsigned char)*chap_pos)) chap_pos++;
+      char* chap_end = chap_pos;
+      while (*chap_end && !isspace((unsigned char)*chap_end) && *chap_end != '<') chap_end++;
+      int len = chap_end - chap_pos;
+      if (len > 0 && len < 20) {
+        strncpy(chapters[count], chap_pos, len);
+        chapters[count][len] = '\0';
+      }
+    }
+
+    count++;
+    card_pos += 1000;
+  }
+  return count;
+}
+
+static char fields[2][5][OLD_MAX][256]; // Old parser's cards, then the new one's
+
+static int run(char* html, int old) {
+  char (*f)[OLD_MAX][256] = fields[!old];
+  memset(f, 0, sizeof(fields[0]));
+  if (old) return extract_strstr(html, f[0], f[1], f[2], f[3], f[4]);
+  return extract_novel_info(html, f[0], f[1], f[2], f[3], f[4]);
+}
+
+// Synthetic cards whose slug and title both name the same novel
+static int correct(int old, int count) {
+  char (*f)[OLD_MAX][256] = fields[!old];
+  int good = 0;
+  for (int i = 0; i < count; i++) {
+    int slug = -1, title = -2;
+    sscanf(f[4][i], "novel-%d", &slug);
+    sscanf(f[0][i], "Novel Number %d", &title);
+    good += slug == title;
+  }
+  return good;
+}
+
+// Old cards whose every field matches the one-pass parser's card
+static int agreeing(int count) {
+  int good = 0;
+  for (int i = 0; i < count; i++) {
+    int same = 1;
+    for (int k = 0; k < 5; k++) same &= strcmp(fields[0][k][i], fields[1][k][i]) == 0;
+    good += same;
+  }
+  return good;
+}
+
+static void run_old(void* html) { bench_sink += run(html, 1); }
+static void run_new(void* html) { bench_sink += run(html, 0); }
+
+// Search pages recorded from wuxia.click by make bench-pages
+static void recorded(const char* dir) {
+  BenchPage* pages = NULL;
+  int count = bench_load_pages(dir, &pages);
+  if (count == 0) {
+    printf(" no recorded pages in %s; make bench-pages fetches some\n", dir);
+    return;
+  }
+
+  for (int i = 0; i < count; i++) {
+    printf(" %s (%zu KB)\n", pages[i].name, pages[i].len / 1024);
+    int found = run(pages[i].html, 0);
+    int old = run(pages[i].html, 1);
+    printf("  strstr, 1000-byte skip: %d cards, %d as the one-pass parser reads them\n", old, agreeing(old));
+    bench_report("strstr, 1000-byte skip", pages[i].len, bench_run(run_old, pages[i].html));
+    printf("  one pass:               %d cards\n", found);
+    bench_report("one pass", pages[i].len, bench_run(run_new, pages[i].html));
+  }
+  bench_free_pages(pages, count);
+}
+
+int main(int argc, char** argv) {
+  static const size_t sizes[] = { 600, 1500, 4000 };
+
+  printf("cards, recorded search pages\n");
+  recorded(argc > 1 ? argv[1] : BENCH_PAGES "/search");
+
+  printf("cards, synthetic (%d per page)\n", CARDS);
+  for (size_t i = 0; i < sizeof(sizes) / sizeof(*sizes); i++) {
+    char* html = make_page(sizes[i]);
+    size_t len = strlen(html);
+    printf(" %zu-byte cards\n", sizes[i]);
+
+    int count = run(html, 1);
+    printf("  strstr, 1000-byte skip: %d cards, %d correct\n", count, correct(1, count));
+    bench_report("strstr, 1000-byte skip", len, bench_run(run_old, html));
+
+    count = run(html, 0);
+    printf("  one pass:               %d cards, %d correct\n", count, correct(0, count));
+    bench_report("one pass", len, bench_run(run_new, html));
+    free(html);
+  }
+  return 0;
+}
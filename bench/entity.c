@@ -0,0 +1,54 @@
+#define _POSIX_C_SOURCE 200809L
+
+// HTML character references: lookups per second through the perfect hash,
+// for the references chapter pages are full of and for the whole mix
+
+#include "bench.h"
+#include "entity.h"
+
+#include <string.h>
+
+static const char* common[] = {
+  "&amp;", "&lt;", "&gt;", "&quot;", "&apos;", "&nbsp;", "&rsquo;", "&lsquo;",
+  "&rdquo;", "&ldquo;", "&mdash;", "&ndash;", "&hellip;", "&#39;", "&#8220;", "&#x2019;",
+};
+
+static const char* mixed[] = {
+  "&amp;", "&hellip;", "&NotSquareSupersetEqual;", "&frac34;", "&eacute;", "&#150;",
+  "&#x1F600;", "&CounterClockwiseContourIntegral;", "&bogus;", "&Aring;", "&zwj;", "&#0;",
+};
+
+typedef struct {
+  const char** refs;
+  size_t lens[16];
+  int count;
+} Refs;
+
+#define ROUNDS 1000
+
+static void decode_all(void* arg) {
+  Refs* r = arg;
+  char out[ENTITY_OUT_MAX];
+  size_t total = 0;
+  for (int round = 0; round < ROUNDS; round++) {
+    for (int i = 0; i < r->count; i++) {
+      size_t out_len = 0;
+      total += entity_decode(r->refs[i], r->lens[i], out, &out_len) + out_len;
+    }
+  }
+  bench_sink += total;
+}
+
+static void measure(const char* name, const char** refs, int count) {
+  Refs r = { refs, {0}, count };
+  for (int i = 0; i < count; i++) r.lens[i] = strlen(refs[i]);
+  double seconds = bench_run(decode_all, &r);
+  printf("  %-32s %9.1f M refs/s\n", name, (double)ROUNDS * count / seconds / 1e6);
+}
+
+int main(void) {
+  printf("entity\n");
+  measure("common in chapters", common, sizeof(common) / sizeof(*common));
+  measure("long, numeric and unknown", mixed, sizeof(mixed) / sizeof(*mixed));
+  return 0;
+}
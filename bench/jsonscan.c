@@ -0,0 +1,121 @@
+#define _POSIX_C_SOURCE 200809L
+
+// Selective JSON reading: a chapter list of the size a long novel has,
+// fed in curl-sized chunks with the selectors chapter_list.c uses, against
+// the cJSON tree it replaced
+
+#include "bench.h"
+#include "jsonscan.h"
+
+#include <cjson/cJSON.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define ENTRIES 3500
+#define CHUNK 16384
+
+typedef struct {
+  char* json;
+  size_t len;
+  long entries; // Records the last run read
+  size_t held;  // Bytes the last run held at most, besides its output
+} List;
+
+// Entries carry the fields the site sends, most of which nobody selects
+static List make_list(void) {
+  List list = { malloc(ENTRIES * 256 + 16), 0, 0, 0 };
+  size_t n = sprintf(list.json, "[");
+  for (int i = 0; i < ENTRIES; i++) {
+    n += sprintf(list.json + n,
+                 "%s{\"id\":%d,\"index\":%d,\"title\":\"Chapter %d: The \\\"Trial\\\" of the Azure Sect\","
+                 "\"novSlugChapSlug\":\"azure-sect-chapter-%d\",\"views\":%d,\"locked\":false,"
+                 "\"created\":\"2023-05-%02dT12:00:00Z\",\"updated\":null,\"tags\":[\"xianxia\",\"sect\"]}",
+                 i ? "," : "", 100000 + i, i, i + 1, i + 1, i * 37, 1 + i % 28);
+  }
+  n += sprintf(list.json + n, "]");
+  list.len = n;
+  return list;
+}
+
+static void count_field(int selector, const char* value, size_t len, void* userdata) {
+  List* list = userdata;
+  if (selector == 2) list->entries++;
+  bench_sink += len + (value != NULL);
+}
+
+static void scan(void* arg) {
+  static const char* const selectors[] = { "[].title", "[].novSlugChapSlug", "[]" };
+  List* list = arg;
+  JsonScan js;
+  list->entries = 0;
+  jsonscan_init(&js, selectors, 3, count_field, list);
+  for (size_t at = 0; at < list->len; at += CHUNK) {
+    size_t len = list->len - at < CHUNK ? list->len - at : CHUNK;
+    if (!jsonscan_feed(&js, list->json + at, len)) break;
+  }
+  bench_sink += jsonscan_finish(&js);
+  // One curl chunk, the scanner and its capture buffer
+  list->held = CHUNK + sizeof(js) + js.value_cap;
+  jsonscan_free(&js);
+}
+
+// Bytes cJSON has allocated now and at most, counted through its hooks
+static size_t heap_now, heap_peak;
+
+static void* counted_malloc(size_t size) {
+  max_align_t* p = malloc(sizeof(max_align_t) + size);
+  if (!p) return NULL;
+  *(size_t*)p = size;
+  heap_now += size;
+  if (heap_now > heap_peak) heap_peak = heap_now;
+  return p + 1;
+}
+
+static void counted_free(void* ptr) {
+  if (!ptr) return;
+  max_align_t* p = (max_align_t*)ptr - 1;
+  heap_now -= *(size_t*)p;
+  free(p);
+}
+
+// The chapter list path before jsonscan, kept as it was: the whole body in
+// memory, parsed into a tree and walked by index
+static void parse_cjson(void* arg) {
+  List* list = arg;
+  list->entries = 0;
+  cJSON* root = cJSON_Parse(list->json);
+  if (cJSON_IsArray(root)) {
+    int size = cJSON_GetArraySize(root);
+    for (int i = 0; i < size && list->entries < ENTRIES; i++) {
+      cJSON* item = cJSON_GetArrayItem(root, i);
+      cJSON* title = cJSON_GetObjectItem(item, "title");
+      if (cJSON_IsString(title) && title->valuestring) bench_sink += strlen(title->valuestring);
+      cJSON* slug = cJSON_GetObjectItem(item, "novSlugChapSlug");
+      if (cJSON_IsString(slug) && slug->valuestring) {
+        bench_sink += strlen(slug->valuestring);
+        list->entries++;
+      }
+    }
+  }
+  cJSON_Delete(root);
+}
+
+int main(void) {
+  List list = make_list();
+  printf("jsonscan (%d entries, %zu KB)\n", ENTRIES, list.len / 1024);
+
+  bench_report("cJSON tree, walked by index", list.len, bench_run(parse_cjson, &list));
+  // Counted on a run of its own, so the hooks stay out of the timing
+  cJSON_Hooks hooks = { counted_malloc, counted_free };
+  cJSON_InitHooks(&hooks);
+  parse_cjson(&list);
+  cJSON_InitHooks(NULL);
+  printf("  %ld entries read, %zu KB held (body %zu KB, tree %zu KB)\n", list.entries,
+         (list.len + heap_peak) / 1024, list.len / 1024, heap_peak / 1024);
+
+  bench_report("chapter list selectors", list.len, bench_run(scan, &list));
+  printf("  %ld entries read, %zu KB held\n", list.entries, list.held / 1024);
+  free(list.json);
+  return 0;
+}
@@ -0,0 +1,169 @@
+#define _POSIX_C_SOURCE 200809L
+
+// Chapter text cleaning: the extractor with textscan runs against the
+// byte-at-a-time loop it replaced, under each kernel this CPU can run, on
+// recorded chapter pages (or a directory of them given as the argument)
+// and on synthetic ones
+
+#include "bench.h"
+#include "extract.h"
+#include "textscan.h"
+
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Pages timed together; a run goes through all of them
+typedef struct {
+  BenchPage* pages;
+  int count;
+  size_t bytes;
+  size_t longest;
+} Corpus;
+
+static const char* words[] = {
+  "the", "cultivator", "looked", "up", "at", "sky", "and", "felt", "his", "qi",
+  "stir", "&rsquo;s", "sect", "elder", "said", "nothing,", "while", "a", "storm", "gathered.",
+};
+
+// About target bytes of chapter page whose paragraphs are para bytes long
+static BenchPage make_page(size_t target, size_t para) {
+  BenchPage page = { "", malloc(target + 4096), 0 };
+  size_t n = 0;
+  unsigned seed = 1;
+  n += sprintf(page.html, "<html><head><title>Chapter</title></head><body>");
+  while (n < target) {
+    n += sprintf(page.html + n, "<p id=\"chapterText\">");
+    size_t start = n;
+    while (n - start < para) {
+      seed = seed * 1103515245u + 12345u;
+      n += sprintf(page.html + n, "%s ", words[(seed >> 16) % (sizeof(words) / sizeof(*words))]);
+    }
+    n += sprintf(page.html + n, "</p>\n");
+  }
+  n += sprintf(page.html + n, "</body></html>");
+  page.len = n;
+  return page;
+}
+
+// The IN_TEXT path before textscan: every byte through isspace() and put()
+static size_t clean_bytewise(const char* html, size_t len, char* out) {
+  static const char marker[] = EXTRACT_MARKER;
+  enum { SEEK, TAG, TEXT } state = SEEK;
+  size_t matched = 0, n = 0;
+  int space = 0;
+
+  for (size_t i = 0; i < len; i++) {
+    char c = html[i];
+    if (state == SEEK) {
+      if (c == marker[matched]) {
+        if (++matched == sizeof(marker) - 1) state = TAG;
+      } else {
+        matched = c == marker[0];
+      }
+    } else if (state == TAG) {
+      if (c == '>') state = TEXT, space = 0;
+    } else if (c == '<') {
+      if (n && out[n - 1] != '\n') out[n++] = '\n', out[n++] = '\n';
+      state = SEEK;
+      matched = 0;
+    } else if (isspace((unsigned char)c)) {
+      space = n > 0;
+    } else {
+      if (space && out[n - 1] != '\n') out[n++] = ' ';
+      space = 0;
+      out[n++] = c;
+    }
+  }
+  return n;
+}
+
+static char* scratch;
+
+static void run_bytewise(void* arg) {
+  Corpus* c = arg;
+  for (int i = 0; i < c->count; i++) bench_sink += clean_bytewise(c->pages[i].html, c->pages[i].len, scratch);
+}
+
+// The kernel alone, stepping over each break it stops at
+static void run_kernel(void* arg) {
+  Corpus* c = arg;
+  size_t total = 0;
+  for (int i = 0; i < c->count; i++) {
+    const char* html = c->pages[i].html;
+    size_t len = c->pages[i].len;
+    for (size_t at = 0; at < len; at++) {
+      size_t n = textscan_plain_run(html + at, len - at);
+      total += n;
+      at += n;
+    }
+  }
+  bench_sink += total;
+}
+
+static void run_extractor(void* arg) {
+  Corpus* c = arg;
+  for (int i = 0; i < c->count; i++) {
+    ChapterExtractor ex;
+    extractor_init(&ex, NULL, NULL);
+    extractor_feed(&ex, c->pages[i].html, c->pages[i].len);
+    size_t len = 0;
+    free(extractor_finish(&ex, &len));
+    bench_sink += len;
+  }
+}
+
+static Corpus corpus(BenchPage* pages, int count) {
+  Corpus c = { pages, count, 0, 0 };
+  for (int i = 0; i < count; i++) {
+    c.bytes += pages[i].len;
+    if (pages[i].len > c.longest) c.longest = pages[i].len;
+  }
+  return c;
+}
+
+static void measure(Corpus* c) {
+  static const char* const kernels[] = { "scalar", "sse2", "avx2" };
+  char name[64];
+
+  scratch = malloc(c->longest * 2);
+  bench_report("byte-at-a-time loop", c->bytes, bench_run(run_bytewise, c));
+
+  for (size_t k = 0; k < sizeof(kernels) / sizeof(*kernels); k++) {
+    if (!textscan_use_kernel(kernels[k])) continue;
+    snprintf(name, sizeof(name), "plain_run_%s", kernels[k]);
+    bench_report(name, c->bytes, bench_run(run_kernel, c));
+    snprintf(name, sizeof(name), "extractor, %s", kernels[k]);
+    bench_report(name, c->bytes, bench_run(run_extractor, c));
+  }
+  free(scratch);
+}
+
+int main(int argc, char** argv) {
+  static const struct { const char* name; size_t para; } cases[] = {
+    { "80 KB, 500-byte paragraphs", 500 },
+    { "80 KB, 40-byte paragraphs", 40 },
+  };
+  const char* dir = argc > 1 ? argv[1] : BENCH_PAGES "/chapter";
+  BenchPage* pages = NULL;
+  int count = bench_load_pages(dir, &pages);
+  Corpus recorded = corpus(pages, count);
+
+  printf("textscan (%s picked at runtime)\n", textscan_kernel());
+  if (recorded.count > 0) {
+    printf(" %d recorded chapter pages, %zu KB\n", recorded.count, recorded.bytes / 1024);
+    measure(&recorded);
+  } else {
+    printf(" no recorded pages in %s; make bench-pages fetches some\n", dir);
+  }
+  bench_free_pages(pages, count);
+
+  for (size_t i = 0; i < sizeof(cases) / sizeof(*cases); i++) {
+    BenchPage page = make_page(80 * 1024, cases[i].para);
+    Corpus synthetic = corpus(&page, 1);
+    printf(" synthetic, %s\n", cases[i].name);
+    measure(&synthetic);
+    free(page.html);
+  }
+  return 0;
+}
@@ -0,0 +1,100 @@
+#!/usr/bin/env python3
+"""Generates src/entity_table.h: the HTML5 named character references in a
+hash-and-displace perfect hash, so lookups are one probe with no collisions.
+
+Run from the repository root: python3 scripts/gen_entities.py
+"""
+
+import html.entities
+
+FNV_OFFSET = 2166136261
+FNV_PRIME = 16777619
+
+
+def fnv1a(name, seed):
+    h = FNV_OFFSET ^ seed
+    for byte in name.encode():
+        h ^= byte
+        h = (h * FNV_PRIME) & 0xFFFFFFFF
+    return h
+
+
+def c_string(data):
+    return '"' + ''.join('\\%03o' % b if b < 0x20 or b > 0x7e or b in (0x22, 0x5c) else chr(b)
+                         for b in data) + '"'
+
+
+def main():
+    entities = {name[:-1]: value for name, value in html.entities.html5.items() if name.endswith(';')}
+    names = sorted(entities)
+
+    bucket_count = len(names) // 4 + 1
+    slot_count = len(names) * 5 // 4
+
+    buckets = [[] for _ in range(bucket_count)]
+    for name in names:
+        buckets[fnv1a(name, 0) % bucket_count].append(name)
+
+    displacement = [0] * bucket_count
+    slots = [None] * slot_count
+    for index in sorted(range(bucket_count), key=lambda b: -len(buckets[b])):
+        bucket = buckets[index]
+        if not bucket:
+            continue
+        for seed in range(1, 1 << 16):
+            targets = [fnv1a(name, seed) % slot_count for name in bucket]
+            if len(set(targets)) == len(targets) and all(slots[t] is None for t in targets):
+                break
+        else:
+            raise SystemExit('no displacement found for bucket %d' % index)
+        displacement[index] = seed
+        for name, target in zip(bucket, targets):
+            slots[target] = name
+
+    longest = max(len(name) for name in names)
+    widest = max(len(value.encode()) for value in entities.values())
+
+    out = []
+    out.append('// Generated by scripts/gen_entities.py from the HTML5 entity list. Do not edit.')
+    out.append('#ifndef ENTITY_TABLE_H')
+    out.append('#define ENTITY_TABLE_H')
+    out.append('')
+    out.append('#include <stdint.h>')
+    out.append('')
+    out.append('#define ENTITY_COUNT %d' % len(names))
+    out.append('#define ENTITY_NAME_MAX %d // Longest name, without & and ;' % longest)
+    out.append('#define ENTITY_UTF8_MAX %d // Longest UTF-8 expansion' % widest)
+    out.append('#define ENTITY_BUCKETS %d' % bucket_count)
+    out.append('#define ENTITY_SLOTS %d' % slot_count)
+    out.append('')
+    out.append('// Only entity.c needs the tables; everyone else just wants the limits')
+    out.append('#ifdef ENTITY_TABLE_IMPL')
+    out.append('')
+    out.append('typedef struct {')
+    out.append('  const char* name;')
+    out.append('  const char* utf8;')
+    out.append('} EntitySlot;')
+    out.append('')
+    out.append('static const uint16_t entity_displacement[ENTITY_BUCKETS] = {')
+    for i in range(0, bucket_count, 12):
+        out.append('  ' + ', '.join(str(d) for d in displacement[i:i + 12]) + ',')
+    out.append('};')
+    out.append('')
+    out.append('static const EntitySlot entity_slots[ENTITY_SLOTS] = {')
+    for name in slots:
+        if name is None:
+            out.append('  { 0, 0 },')
+        else:
+            out.append('  { "%s", %s },' % (name, c_string(entities[name].encode())))
+    out.append('};')
+    out.append('')
+    out.append('#endif')
+    out.append('')
+    out.append('#endif')
+
+    with open('src/entity_table.h', 'w') as f:
+        f.write('\n'.join(out) + '\n')
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,68 @@
+#!/usr/bin/env python3
+"""Records pages from the sites novel-cli reads into bench/pages, so the
+microbenchmarks run on what the parsers really see:
+
+  bench/pages/search/   wuxia.click search results, as webnovel.c asks for them
+  bench/pages/chapter/  chapters of the first novels those searches list
+
+Pages are saved as the server sent them, decompressed. Run from the
+repository root: python3 scripts/record_pages.py [query ...]
+"""
+
+import json
+import os
+import re
+import sys
+import urllib.parse
+import urllib.request
+
+USER_AGENT = 'Mozilla/5.0 (compatible; NovelBot/1.0)'  # HTTP_USER_AGENT in src/http.h
+PAGES = 'bench/pages'
+QUERIES = ['martial', 'system', 'god']
+SEARCH_PAGES = 2
+NOVELS = 2    # Per query
+CHAPTERS = 2  # Per novel
+
+
+def fetch(url):
+    request = urllib.request.Request(url, headers={'User-Agent': USER_AGENT})
+    with urllib.request.urlopen(request, timeout=30) as response:
+        return response.read()
+
+
+def save(folder, name, data):
+    os.makedirs(folder, exist_ok=True)
+    path = os.path.join(folder, re.sub(r'[^A-Za-z0-9._-]', '_', name) + '.html')
+    with open(path, 'wb') as f:
+        f.write(data)
+    print('%s (%d KB)' % (path, len(data) // 1024))
+
+
+def record_search(query, page):
+    url = 'https://wuxia.click/search/%s?page=%d&order_by=-total_views' % (urllib.parse.quote(query), page)
+    html = fetch(url)
+    save(os.path.join(PAGES, 'search'), '%s-%d' % (query, page), html)
+    return html
+
+
+def record_chapters(novel):
+    listing = json.loads(fetch('https://wuxiaworld.eu/api/chapters/%s/' % urllib.parse.quote(novel)))
+    for entry in listing[:CHAPTERS]:
+        chapter = entry['novSlugChapSlug']
+        save(os.path.join(PAGES, 'chapter'), chapter, fetch('https://wuxia.click/chapter/%s' % urllib.parse.quote(chapter)))
+
+
+def main():
+    for query in sys.argv[1:] or QUERIES:
+        novels = []
+        for page in range(1, SEARCH_PAGES + 1):
+            html = record_search(query, page).decode('utf-8', 'replace')
+            for novel in re.findall(r'/novel/([^"]+)"', html):
+                if novel not in novels:
+                    novels.append(novel)
+        for novel in novels[:NOVELS]:
+            record_chapters(novel)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,83 @@
+#include "acmatch.h"
+
+#include <string.h>
+
+void ac_init(ACMatcher* ac) {
+  memset(ac, 0, sizeof(*ac));
+  memset(ac->match, -1, sizeof(ac->match));
+  ac->states = 1; // State 0 is the root
+}
+
+int ac_add(ACMatcher* ac, const char* pattern, int id) {
+  size_t len = strlen(pattern);
+  if (len == 0 || len > 255 || id < 0 || id >= AC_MAX_PATTERNS) return 0;
+
+  // Trie edges live in `next` until ac_build() turns it into a DFA
+  int state = 0;
+  for (size_t i = 0; i < len; i++) {
+    unsigned char c = (unsigned char)pattern[i];
+    if (!ac->next[state][c]) {
+      if (ac->states >= AC_MAX_STATES) return 0;
+      ac->next[state][c] = (uint8_t)ac->states++;
+    }
+    state = ac->next[state][c];
+  }
+  ac->match[state] = (int8_t)id;
+  ac->match_len[state] = (uint8_t)len;
+  return 1;
+}
+
+void ac_build(ACMatcher* ac) {
+  uint8_t queue[AC_MAX_STATES];
+  int head = 0, tail = 0;
+
+  // Depth one falls back to the root
+  for (int c = 0; c < 256; c++) {
+    uint8_t child = ac->next[0][c];
+    if (child) {
+      ac->fail[child] = 0;
+      queue[tail++] = child;
+    }
+  }
+
+  // Breadth first, so every fail target is complete before it's used
+  while (head < tail) {
+    uint8_t state = queue[head++];
+
+    // Inherit the longest suffix match when this state has none of its own
+    if (ac->match[state] < 0 && ac->match[ac->fail[state]] >= 0) {
+      ac->match[state] = ac->match[ac->fail[state]];
+      ac->match_len[state] = ac->match_len[ac->fail[state]];
+    }
+
+    for (int c = 0; c < 256; c++) {
+      uint8_t child = ac->next[state][c];
+      if (child) {
+        ac->fail[child] = ac->next[ac->fail[state]][c];
+        queue[tail++] = child;
+      } else {
+        ac->next[state][c] = ac->next[ac->fail[state]][c];
+      }
+    }
+  }
+  ac->built = 1;
+}
+
+int ac_next(const ACMatcher* ac, int* state, const char** cursor, const char* end, const char** match) {
+  const char* p = *cursor;
+  int s = *state;
+
+  while (p < end) {
+    s = ac->next[s][(unsigned char)*p++];
+    if (ac->match[s] >= 0) {
+      *state = s;
+      *cursor = p;
+      if (match) *match = p - ac->match_len[s];
+      return ac->match[s];
+    }
+  }
+
+  *state = s;
+  *cursor = p;
+  return -1;
+}
@@ -0,0 +1,38 @@
+#ifndef ACMATCH_H
+#define ACMATCH_H
+
+#include <stdint.h>
+
+#define AC_MAX_STATES 256
+#define AC_MAX_PATTERNS 32
+
+/**
+ * Aho-Corasick automaton compiled into a full DFA: every input byte costs
+ * exactly one table lookup, so scanning is linear in the input no matter how
+ * many patterns share prefixes. Sized for a handful of short markers.
+ */
+typedef struct {
+  uint8_t next[AC_MAX_STATES][256];
+  int8_t match[AC_MAX_STATES];       // Pattern id recognised in this state, -1 if none
+  uint8_t match_len[AC_MAX_STATES];
+  uint8_t fail[AC_MAX_STATES];
+  int states;
+  int built;
+} ACMatcher;
+
+void ac_init(ACMatcher* ac);
+
+// Adds a pattern before ac_build(); returns 0 if the automaton is full
+int ac_add(ACMatcher* ac, const char* pattern, int id);
+
+void ac_build(ACMatcher* ac);
+
+/**
+ * Advances *cursor until a pattern ends or `end` is reached. On a match the
+ * pattern id is returned, *match points at its first byte and *cursor just
+ * past it. *state carries the automaton between calls; reset it to 0 after
+ * moving *cursor yourself. Returns -1 when the input is exhausted.
+ */
+int ac_next(const ACMatcher* ac, int* state, const char** cursor, const char* end, const char** match);
+
+#endif
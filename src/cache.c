@@ -2,97 +2,313 @@
 
 #include "cache.h"
 #include "controller.h"
+#include "config.h"
+#include "lru_index.h"
+#include "crc32.h"
+
 #include <stdlib.h>
 #include <string.h>
-#include <dirent.h>
+#include <limits.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 
-void save_to_cache(cJSON* json, char *options[], int count) {
-  char cache_dir[512];
+enum { SEL_COUNT, SEL_TITLE, SEL_URL, SEL_RESULT };
+
+static void book_result_field(int selector, const char* value, size_t len, void* userdata) {
+  BookResults* results = userdata;
+  (void)len;
+
+  switch (selector) {
+    case SEL_COUNT:
+      results->count = atoi(value);
+      break;
+    case SEL_TITLE:
+      free(results->pending_title);
+      results->pending_title = strdup(value);
+      break;
+    case SEL_URL:
+      free(results->pending_url);
+      results->pending_url = strdup(value);
+      break;
+    case SEL_RESULT:
+      // Only the first BOOK_RESULTS_MAX are ever shown
+      if (results->n < BOOK_RESULTS_MAX) {
+        results->titles[results->n] = results->pending_title ? results->pending_title : strdup("");
+        results->urls[results->n] = results->pending_url;
+        results->n++;
+      } else {
+        free(results->pending_title);
+        free(results->pending_url);
+      }
+      results->pending_title = NULL;
+      results->pending_url = NULL;
+      break;
+  }
+}
+
+void book_results_reader(JsonScan* js, BookResults* results) {
+  static const char* const selectors[] = {
+    [SEL_COUNT] = "count",
+    [SEL_TITLE] = "results[].title",
+    [SEL_URL] = "results[].formats." BOOK_PLAIN_FORMAT,
+    [SEL_RESULT] = "results[]",
+  };
+  memset(results, 0, sizeof(*results));
+  jsonscan_init(js, selectors, 4, book_result_field, results);
+}
+
+void book_results_free(BookResults* results) {
+  for (int i = 0; i < results->n; i++) {
+    free(results->titles[i]);
+    free(results->urls[i]);
+  }
+  free(results->pending_title);
+  free(results->pending_url);
+  memset(results, 0, sizeof(*results));
+}
+
+// The search cache lives in cache/ itself, tracked by search.idx
+static LruIndex search_index;
+static int search_opened = 0;
+static SearchCacheStats search_stats;
+
+static int open_search_index(void) {
+  if (search_opened) return search_opened > 0;
+
+  char cache_dir[PATH_MAX];
   get_user_path(cache_dir, "cache", sizeof(cache_dir));
 
-  char cache_path[1024];
-  snprintf(cache_path, sizeof(cache_path), "%s/%s.json", cache_dir, options[count]);
+  int kb = config_get_int("search_cache_kb", SEARCH_CACHE_DEFAULT_KB);
+  if (kb < 0) kb = 0;
+  search_opened = lru_open(&search_index, cache_dir, SEARCH_CACHE_INDEX, (uint64_t)kb << 10) ? 1 : -1;
+  return search_opened > 0;
+}
+
+static void entry_path(char* path, size_t size, char key[LRU_KEY_MAX + 1], const char* name, const char* ext) {
+  lru_file_key(key, name, ext);
+  snprintf(path, size, "%s/%s", search_index.dir, key);
+}
 
-  FILE* cache_file = fopen(cache_path, "w");
-  if (cache_file) {
-    char* json_str = cJSON_Print(json);
-    fprintf(cache_file, "%s", json_str);
-    free(json_str);
-    fclose(cache_file);
+int search_cache_put(const char* name, const char* ext, const void* data, size_t len) {
+  if (!open_search_index()) return 0;
+
+  char key[LRU_KEY_MAX + 1];
+  char path[PATH_MAX + LRU_KEY_MAX + 2];
+  char tmp_path[PATH_MAX + LRU_KEY_MAX + 16];
+  entry_path(path, sizeof(path), key, name, ext);
+  snprintf(tmp_path, sizeof(tmp_path), "%s.tmp.XXXXXX", path);
+
+  // Written aside and renamed in, so a crash never leaves half an entry
+  int fd = mkstemp(tmp_path);
+  if (fd < 0) return 0;
+  int ok = write(fd, data, len) == (ssize_t)len;
+  if (close(fd) != 0) ok = 0;
+  if (ok && rename(tmp_path, path) == 0) {
+    lru_insert(&search_index, key, len);
+    return 1;
   }
-  return;
+  unlink(tmp_path);
+  return 0;
 }
 
-cJSON* load_from_cache(char *book_name) {
-    char cache_dir[512];
-    get_user_path(cache_dir, "cache", sizeof(cache_dir));
-
-    char cache_path[1024];
-    snprintf(cache_path, sizeof(cache_path), "%s/%s.json", cache_dir, book_name);
-    
-    FILE* cache_file = fopen(cache_path, "r");
-    if (cache_file) {
-        cJSON* json = parse_json(cache_file); // parse_json handles fclose
-        return json;
+int search_cache_read(const char* name, const char* ext, search_cache_decode_fn decode, void* userdata) {
+  char key[LRU_KEY_MAX + 1];
+  char path[PATH_MAX + LRU_KEY_MAX + 2];
+  if (!open_search_index()) {
+    search_stats.misses++;
+    return 0;
+  }
+  entry_path(path, sizeof(path), key, name, ext);
+
+  // The index answers misses without touching the directory
+  if (!lru_touch(&search_index, key)) {
+    search_stats.misses++;
+    return 0;
+  }
+
+  int ok = 0;
+  int fd = open(path, O_RDONLY);
+  struct stat st;
+  if (fd >= 0 && fstat(fd, &st) == 0 && st.st_size > 0) {
+    void* data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data != MAP_FAILED) {
+      ok = decode(data, st.st_size, userdata);
+      munmap(data, st.st_size);
     }
+  }
+  if (fd >= 0) close(fd);
+
+  if (!ok) {
+    // Unreadable entries are dropped so the next search refetches
+    lru_remove(&search_index, key);
+    search_stats.misses++;
+    return 0;
+  }
+  search_stats.hits++;
+  return 1;
+}
+
+size_t cache_put_text(unsigned char* p, const char* s, uint16_t len) {
+  memcpy(p, &len, 2);
+  if (s) memcpy(p + 2, s, len);
+  return 2 + (s ? len : 0);
+}
+
+int cache_get_text(const unsigned char** p, const unsigned char* end, char* out, size_t size) {
+  uint16_t len;
+  if (end - *p < 2) return 0;
+  memcpy(&len, *p, 2);
+  if (len >= size || end - *p - 2 < len) return 0;
+  memcpy(out, *p + 2, len);
+  out[len] = '\0';
+  *p += 2 + len;
+  return 1;
+}
+
+uint16_t cache_text_len(const char* s) {
+  size_t len = s ? strlen(s) : 0;
+  return len > CACHE_TEXT_MAX ? CACHE_TEXT_MAX : len;
+}
+
+/*
+ * Search file layout, all integers in host byte order:
+ *
+ *   "NCS3"  u32 crc  i64 fetched_at  u32 count  u32 n
+ *   u16 etag_len  etag  u16 last_modified_len  last_modified
+ *   u16 query_len  query
+ *   n x { u16 title_len  title  u16 url_len  url }
+ *
+ * The CRC covers everything after itself. A url_len of NO_URL marks a book
+ * without a plain-text download. Strings aren't NUL-terminated.
+ */
+#define SEARCH_MAGIC "NCS3"
+#define SEARCH_HEADER 24
+#define NO_URL 0xffff
+
+// Returns a copy of the field at *p, or NULL with *bad set if it overruns end
+static char* get_field(const unsigned char** p, const unsigned char* end, int* bad) {
+  uint16_t len;
+  if (end - *p < 2) {
+    *bad = 1;
+    return NULL;
+  }
+  memcpy(&len, *p, 2);
+  *p += 2;
+  if (len == NO_URL) return NULL;
+  if (end - *p < len) {
+    *bad = 1;
+    return NULL;
+  }
+  char* s = malloc(len + 1);
+  if (!s) {
+    *bad = 1;
     return NULL;
+  }
+  memcpy(s, *p, len);
+  s[len] = '\0';
+  *p += len;
+  return s;
 }
 
-void delete_old_cache() {
-    char cache_dir[512];
-    get_user_path(cache_dir, "cache", sizeof(cache_dir)); // Get the real XDG path
+void save_to_cache(const BookResults* results, const char* book_name) {
+  const HttpValidators* v = &results->validators;
+  uint16_t etag_len = cache_text_len(v->etag), modified_len = cache_text_len(v->last_modified);
+  uint16_t title_len[BOOK_RESULTS_MAX], url_len[BOOK_RESULTS_MAX];
+  uint16_t query_len = cache_text_len(book_name);
+  size_t len = SEARCH_HEADER + 6 + etag_len + modified_len + query_len;
+  for (int i = 0; i < results->n; i++) {
+    title_len[i] = cache_text_len(results->titles[i]);
+    url_len[i] = results->urls[i] ? cache_text_len(results->urls[i]) : NO_URL;
+    len += 4 + title_len[i] + (results->urls[i] ? url_len[i] : 0);
+  }
+
+  unsigned char* buf = malloc(len);
+  if (!buf) return;
+  unsigned char* p = buf + SEARCH_HEADER;
+  p += cache_put_text(p, v->etag, etag_len);
+  p += cache_put_text(p, v->last_modified, modified_len);
+  p += cache_put_text(p, book_name, query_len);
+  for (int i = 0; i < results->n; i++) {
+    p += cache_put_text(p, results->titles[i], title_len[i]);
+    p += cache_put_text(p, results->urls[i], url_len[i]);
+  }
 
-    DIR *dir = opendir(cache_dir);
-    if (!dir) return;
+  int64_t fetched_at = results->fetched_at;
+  uint32_t count = results->count, n = results->n;
+  memcpy(buf, SEARCH_MAGIC, 4);
+  memcpy(buf + 8, &fetched_at, 8);
+  memcpy(buf + 16, &count, 4);
+  memcpy(buf + 20, &n, 4);
+  uint32_t crc = crc32(buf + 8, len - 8);
+  memcpy(buf + 4, &crc, 4);
 
-    struct dirent *entry;
-    int count = 0;
-    char *files[100];
+  search_cache_put(book_name, ".bin", buf, len);
+  free(buf);
+}
 
-    while ((entry = readdir(dir)) != NULL && count < 100) {
-        if (entry->d_name[0] == '.') continue; // Skip . and ..
+typedef struct {
+  const char* query;
+  BookResults* results;
+} SavedSearch;
 
-        char path[1024];
-        snprintf(path, sizeof(path), "%s/%s", cache_dir, entry->d_name);
+// Copies the results out of a mapped cache file; 0 if it's damaged or another query's
+static int decode_results(const unsigned char* data, size_t size, void* userdata) {
+  SavedSearch* saved = userdata;
+  BookResults* results = saved->results;
+  char query[CACHE_QUERY_MAX];
+  uint32_t crc, count, n;
+  int64_t fetched_at;
+  if (size < SEARCH_HEADER || memcmp(data, SEARCH_MAGIC, 4) != 0) return 0;
+  memcpy(&crc, data + 4, 4);
+  memcpy(&fetched_at, data + 8, 8);
+  memcpy(&count, data + 16, 4);
+  memcpy(&n, data + 20, 4);
+  if (n > BOOK_RESULTS_MAX || crc32(data + 8, size - 8) != crc) return 0;
 
-        struct stat st;
-        if (stat(path, &st) == 0 && S_ISREG(st.st_mode)) {
-            files[count++] = strdup(entry->d_name);
-        }
-    }
-    closedir(dir);
-
-    if (count > CACHE_SIZE) {
-        for (int i = 0; i < count - CACHE_SIZE; i++) {
-            char path[1024];
-            snprintf(path, sizeof(path), "%s/%s", cache_dir, files[i]);
-            remove(path);
-        }
+  const unsigned char* p = data + SEARCH_HEADER;
+  const unsigned char* end = data + size;
+  HttpValidators* v = &results->validators;
+  if (!cache_get_text(&p, end, v->etag, sizeof(v->etag)) ||
+      !cache_get_text(&p, end, v->last_modified, sizeof(v->last_modified)) ||
+      !cache_get_text(&p, end, query, sizeof(query)) || strcmp(query, saved->query) != 0) return 0;
+
+  int bad = 0;
+  results->count = count;
+  results->fetched_at = fetched_at;
+  for (uint32_t i = 0; i < n && !bad; i++) {
+    char* title = get_field(&p, end, &bad);
+    char* url = bad ? NULL : get_field(&p, end, &bad);
+    if (!title) bad = 1;
+    if (bad) {
+      free(title);
+      free(url);
+      break;
     }
+    results->titles[results->n] = title;
+    results->urls[results->n] = url;
+    results->n++;
+  }
+  if (bad || p != end) {
+    book_results_free(results);
+    return 0;
+  }
+  return 1;
+}
 
-    for (int i = 0; i < count; i++)
-        free(files[i]);
+int load_from_cache(const char* book_name, BookResults* results) {
+  memset(results, 0, sizeof(*results));
+  SavedSearch saved = { book_name, results };
+  return search_cache_read(book_name, ".bin", decode_results, &saved);
 }
 
-cJSON* parse_json(FILE* fp) {
-  fseek(fp, 0, SEEK_END);
-  long size = ftell(fp);
-  rewind(fp);
-
-  char *buffer = malloc(size + 1);
-  fread(buffer, 1, size, fp);
-  buffer[size] = '\0';
-  fclose(fp);
-
-  cJSON *json = cJSON_Parse(buffer);
-  if (json == NULL) {
-    const char *error_ptr = cJSON_GetErrorPtr();
-    if (error_ptr != NULL) {
-      printf("Error: %s\n", error_ptr);
-    }
-    cJSON_Delete(json);
-    return NULL;
+void search_cache_get_stats(SearchCacheStats* out) {
+  *out = search_stats;
+  if (open_search_index()) {
+    out->entries = search_index.count;
+    out->bytes = search_index.bytes;
+    out->budget = search_index.budget;
+    out->evictions = search_index.evictions;
   }
-  return json;
 }
@@ -2,29 +2,110 @@
 #define CACHE_H
 
 #include <stdio.h>
-#include <cjson/cJSON.h>
+#include <stdint.h>
 
-#define CACHE_SIZE 20
+#include "jsonscan.h"
+#include "revalidate.h"
 
+#define SEARCH_CACHE_INDEX "search.idx"
+#define SEARCH_CACHE_DEFAULT_KB 1024
+#define BOOK_RESULTS_MAX 20
+#define CACHE_QUERY_MAX 256
+#define BOOK_SEARCH_DEFAULT_TTL 86400
+#define BOOK_PLAIN_FORMAT "text/plain; charset=utf-8"
+
+#define PAGE_CACHE_SLOTS 32
+#define PAGE_CARDS_MAX 12
+#define NOVEL_SEARCH_DEFAULT_TTL 600
+
+// One search-result card; the strings point into the page's arena
 typedef struct {
+  const char* title;
+  const char* yearly_views;
+  const char* slug;
+  const char* rating;
+  const char* chapters;
+} NovelCard;
+
+/**
+ * A parsed webnovel search page, cached by (query, page) for the whole
+ * session. All card strings share one allocation sized to fit them.
+ */
+typedef struct {
+  char query[256];
   int page_number;
   int count;
+  NovelCard cards[PAGE_CARDS_MAX];
+  char* arena;
 
-  char titles[12][256];
-  char yearly_views[12][256];
-  char slugs[12][256];
-  char ratings[12][256];
-  char chapters[12][256];
+  time_t fetched_at;
+  HttpValidators validators;
+  Revalidation* revalidation;  // Background check of a stale page, if any
 
+  unsigned long last_used;
   int is_valid;
 } PageCache;
 
-void save_to_cache(cJSON* json, char *options[], int count);
+typedef struct {
+  long hits;
+  long misses;
+  long evictions;
+  long speculated;       // Neighbouring pages fetched before being asked for
+  long speculative_hits; // Page flips those served
+} PageCacheStats;
+
+/**
+ * The parts of a Gutendex search the menu uses: the first BOOK_RESULTS_MAX
+ * titles and their plain-text download links (NULL when a book has none).
+ */
+typedef struct {
+  int count;                        // Total hits reported by Gutendex
+  int n;
+  char* titles[BOOK_RESULTS_MAX];
+  char* urls[BOOK_RESULTS_MAX];
+
+  time_t fetched_at;
+  HttpValidators validators;
+
+  char* pending_title;              // Fields of the result being read
+  char* pending_url;
+} BookResults;
 
-cJSON* load_from_cache(char *book_name);
+// Prepares js to fill results from a Gutendex response
+void book_results_reader(JsonScan* js, BookResults* results);
 
-void delete_old_cache(void);
+void book_results_free(BookResults* results);
+
+void save_to_cache(const BookResults* results, const char* book_name);
+
+int load_from_cache(const char* book_name, BookResults* results);
+
+// Longest string a cache record stores; longer ones are cut
+#define CACHE_TEXT_MAX 0xfffe
+
+// Helpers for u16-length-prefixed strings in cache records
+size_t cache_put_text(unsigned char* p, const char* s, uint16_t len);
+int cache_get_text(const unsigned char** p, const unsigned char* end, char* out, size_t size);
+uint16_t cache_text_len(const char* s);
+
+typedef int (*search_cache_decode_fn)(const unsigned char* data, size_t size, void* userdata);
+
+// Stores an entry with a caller-defined format next to the cached searches
+int search_cache_put(const char* name, const char* ext, const void* data, size_t len);
+
+// Maps the entry and hands it to decode; entries decode rejects are deleted
+int search_cache_read(const char* name, const char* ext, search_cache_decode_fn decode, void* userdata);
+
+typedef struct {
+  long hits;
+  long misses;
+  long evictions;
+  int entries;
+  uint64_t bytes;
+  uint64_t budget;
+} SearchCacheStats;
 
-cJSON* parse_json(FILE *fp);
+// Search results cached on disk, least recently used dropped past "search_cache_kb"
+void search_cache_get_stats(SearchCacheStats* out);
 
 #endif
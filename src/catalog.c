@@ -0,0 +1,407 @@
+#define _POSIX_C_SOURCE 200809L
+#define _DEFAULT_SOURCE // d_type
+
+#include "catalog.h"
+#include "controller.h"
+#include "cache.h"
+#include "crc32.h"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/inotify.h>
+#endif
+
+/*
+ * Saved catalog layout, integers in host byte order:
+ *
+ *   "NLB1"  u32 crc  i64 dir_mtime  u32 count
+ *   count x { i64 size  i64 mtime  i64 read_at  i32 line  u64 pos
+ *             u16-prefixed name and title }
+ *
+ * The CRC covers everything after itself. dir_mtime is the library's
+ * mtime when the catalog last matched it.
+ */
+#define CATALOG_MAGIC "NLB1"
+#define CATALOG_HEADER 20
+#define BOOK_RECORD 36
+
+static struct {
+  CatalogBook* books;
+  int count, cap;
+  int* slots;        // Books by name, open addressing; -1 is empty
+  int slot_count;
+  int64_t dir_mtime;
+  int loaded;
+  int dirty;
+  int watch_fd;      // inotify descriptor, -1 while not watching
+  char dir[PATH_MAX];
+} cat = { .watch_fd = -1 };
+
+static CatalogStats stats;
+
+static uint32_t name_hash(const char* s) {
+  uint32_t h = 2166136261u;
+  for (; *s; s++) h = (h ^ (unsigned char)*s) * 16777619u;
+  return h;
+}
+
+static int rebuild_slots(void) {
+  int size = 64;
+  while (size < cat.count * 2) size *= 2;
+  int* slots = malloc(size * sizeof(int));
+  if (!slots) return 0;
+  memset(slots, -1, size * sizeof(int));
+
+  for (int i = 0; i < cat.count; i++) {
+    uint32_t h = name_hash(cat.books[i].name) & (size - 1);
+    while (slots[h] >= 0) h = (h + 1) & (size - 1);
+    slots[h] = i;
+  }
+  free(cat.slots);
+  cat.slots = slots;
+  cat.slot_count = size;
+  return 1;
+}
+
+static int find_book(const char* name) {
+  if (!cat.slots) return -1;
+  uint32_t h = name_hash(name) & (cat.slot_count - 1);
+  for (; cat.slots[h] >= 0; h = (h + 1) & (cat.slot_count - 1)) {
+    if (strcmp(cat.books[cat.slots[h]].name, name) == 0) return cat.slots[h];
+  }
+  return -1;
+}
+
+// Downloads in progress and hidden files aren't books
+static int ignored(const char* name) {
+  return name[0] == '.' || strstr(name, ".tmp.") != NULL;
+}
+
+static int add_book(const char* name, const char* title) {
+  if (cat.count == cat.cap) {
+    int cap = cat.cap ? cat.cap * 2 : 256;
+    CatalogBook* books = realloc(cat.books, cap * sizeof(CatalogBook));
+    if (!books) return -1;
+    cat.books = books;
+    cat.cap = cap;
+  }
+
+  CatalogBook* b = &cat.books[cat.count];
+  memset(b, 0, sizeof(*b));
+  b->name = strdup(name);
+  if (title) {
+    b->title = strdup(title);
+  } else if (b->name) {
+    size_t len = strlen(name);
+    b->title = strndup(name, len > 4 && strcmp(name + len - 4, ".txt") == 0 ? len - 4 : len);
+  }
+  if (!b->name || !b->title) {
+    free(b->name);
+    free(b->title);
+    return -1;
+  }
+  cat.count++;
+
+  if (cat.count * 2 > cat.slot_count) {
+    if (!rebuild_slots()) return -1;
+  } else {
+    uint32_t h = name_hash(name) & (cat.slot_count - 1);
+    while (cat.slots[h] >= 0) h = (h + 1) & (cat.slot_count - 1);
+    cat.slots[h] = cat.count - 1;
+  }
+  return cat.count - 1;
+}
+
+// Order isn't kept: the last book takes the freed place. The caller
+// rebuilds the slots once it is done removing.
+static void remove_book(int i) {
+  free(cat.books[i].name);
+  free(cat.books[i].title);
+  cat.books[i] = cat.books[--cat.count];
+}
+
+// Applies what is on disk now for one name; returns 1 if the catalog changed
+static int update_book(const char* name) {
+  char path[PATH_MAX + 256];
+  snprintf(path, sizeof(path), "%s/%s", cat.dir, name);
+  struct stat st;
+  int exists = stat(path, &st) == 0 && S_ISREG(st.st_mode);
+
+  int i = find_book(name);
+  if (!exists) {
+    if (i < 0) return 0;
+    remove_book(i);
+    rebuild_slots();
+    return 1;
+  }
+  if (i < 0 && (i = add_book(name, NULL)) < 0) return 0;
+
+  CatalogBook* b = &cat.books[i];
+  if (b->size == (int64_t)st.st_size && b->mtime == (int64_t)st.st_mtime) return 0;
+  b->size = st.st_size;
+  b->mtime = st.st_mtime;
+  return 1;
+}
+
+/**
+ * Lists the directory again. Books already in the catalog are not looked
+ * at beyond their name, since the directory's mtime only moves when files
+ * come and go; a book edited in place reaches the catalog through the
+ * watch's IN_CLOSE_WRITE and IN_ATTRIB. Only new names are stat()ed, which
+ * also tells whether a symlink leads to a book.
+ */
+static void rescan(void) {
+  DIR* d = opendir(cat.dir);
+  if (!d) return;
+  stats.rescans++;
+
+  unsigned char* seen = calloc(cat.count ? cat.count : 1, 1);
+  if (!seen) {
+    closedir(d);
+    return;
+  }
+  int known = cat.count;
+
+  struct dirent* e;
+  while ((e = readdir(d)) != NULL) {
+    if (ignored(e->d_name) || (e->d_type != DT_REG && e->d_type != DT_LNK && e->d_type != DT_UNKNOWN)) continue;
+    int i = find_book(e->d_name);
+    if (i >= 0 && i < known) seen[i] = 1;
+    else if (i < 0) cat.dirty |= update_book(e->d_name);
+  }
+  closedir(d);
+
+  // Backwards, so removal moving the last book down can't skip one
+  for (int i = known - 1; i >= 0; i--) {
+    if (seen[i]) continue;
+    remove_book(i);
+    cat.dirty = 1;
+  }
+  free(seen);
+  rebuild_slots();
+}
+
+static void catalog_path(char* path, size_t size, const char* subfolder) {
+  char dir[PATH_MAX];
+  get_user_path(dir, subfolder, sizeof(dir));
+  snprintf(path, size, "%s/%s", dir, CATALOG_FILE);
+}
+
+static int64_t get_i64(const unsigned char* p) {
+  int64_t v;
+  memcpy(&v, p, 8);
+  return v;
+}
+
+// The whole file in one read; a damaged catalog is just rebuilt
+static void load(void) {
+  char path[PATH_MAX + 16];
+  catalog_path(path, sizeof(path), CATALOG_DIR);
+  int fd = open(path, O_RDONLY);
+  if (fd < 0) {
+    // Earlier builds kept it among the search cache; it is rebuilt here
+    catalog_path(path, sizeof(path), "cache");
+    unlink(path);
+    return;
+  }
+
+  struct stat st = {0};
+  unsigned char* data = NULL;
+  ssize_t got = -1;
+  if (fstat(fd, &st) == 0 && st.st_size >= CATALOG_HEADER && (data = malloc(st.st_size)))
+    got = read(fd, data, st.st_size);
+  close(fd);
+  if (got != st.st_size) {
+    free(data);
+    return;
+  }
+
+  uint32_t crc, count;
+  int ok = memcmp(data, CATALOG_MAGIC, 4) == 0;
+  if (ok) {
+    memcpy(&crc, data + 4, 4);
+    memcpy(&count, data + 16, 4);
+    ok = crc32(data + 8, got - 8) == crc;
+  }
+
+  const unsigned char* p = data + CATALOG_HEADER;
+  const unsigned char* end = data + got;
+  char name[NAME_MAX + 1], title[NAME_MAX + 1];
+  for (uint32_t n = 0; ok && n < count; n++) {
+    ok = end - p >= BOOK_RECORD;
+    const unsigned char* record = p;
+    p += BOOK_RECORD;
+    ok = ok && cache_get_text(&p, end, name, sizeof(name)) && cache_get_text(&p, end, title, sizeof(title));
+    int i = ok ? add_book(name, title) : -1;
+    if (i < 0) {
+      ok = 0;
+      break;
+    }
+
+    CatalogBook* b = &cat.books[i];
+    b->size = get_i64(record);
+    b->mtime = get_i64(record + 8);
+    b->read_at = get_i64(record + 16);
+    memcpy(&b->line, record + 24, 4);
+    memcpy(&b->pos, record + 28, 8);
+  }
+
+  if (ok && p == end) {
+    cat.dir_mtime = get_i64(data + 8);
+  } else {
+    while (cat.count > 0) remove_book(cat.count - 1);
+    rebuild_slots();
+    cat.dir_mtime = 0;
+  }
+  free(data);
+}
+
+// Written aside and renamed in
+static void save(void) {
+  size_t len = CATALOG_HEADER;
+  for (int i = 0; i < cat.count; i++)
+    len += BOOK_RECORD + 4 + cache_text_len(cat.books[i].name) + cache_text_len(cat.books[i].title);
+
+  unsigned char* buf = malloc(len);
+  if (!buf) return;
+  unsigned char* p = buf + CATALOG_HEADER;
+  for (int i = 0; i < cat.count; i++) {
+    const CatalogBook* b = &cat.books[i];
+    memcpy(p, &b->size, 8);
+    memcpy(p + 8, &b->mtime, 8);
+    memcpy(p + 16, &b->read_at, 8);
+    memcpy(p + 24, &b->line, 4);
+    memcpy(p + 28, &b->pos, 8);
+    p += BOOK_RECORD;
+    p += cache_put_text(p, b->name, cache_text_len(b->name));
+    p += cache_put_text(p, b->title, cache_text_len(b->title));
+  }
+
+  uint32_t count = cat.count;
+  memcpy(buf, CATALOG_MAGIC, 4);
+  memcpy(buf + 8, &cat.dir_mtime, 8);
+  memcpy(buf + 16, &count, 4);
+  uint32_t crc = crc32(buf + 8, len - 8);
+  memcpy(buf + 4, &crc, 4);
+
+  char path[PATH_MAX + 16], tmp[PATH_MAX + 32];
+  catalog_path(path, sizeof(path), CATALOG_DIR);
+  snprintf(tmp, sizeof(tmp), "%s.tmp.XXXXXX", path);
+  int fd = mkstemp(tmp);
+  if (fd >= 0) {
+    int ok = write(fd, buf, len) == (ssize_t)len;
+    if (close(fd) != 0) ok = 0;
+    if (!ok || rename(tmp, path) != 0) unlink(tmp);
+    else cat.dirty = 0;
+  }
+  free(buf);
+}
+
+#ifdef __linux__
+static void watch(void) {
+  cat.watch_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (cat.watch_fd < 0) return;
+  uint32_t mask = IN_CREATE | IN_CLOSE_WRITE | IN_ATTRIB | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO |
+                  IN_DELETE_SELF | IN_MOVE_SELF;
+  if (inotify_add_watch(cat.watch_fd, cat.dir, mask) < 0) {
+    close(cat.watch_fd);
+    cat.watch_fd = -1;
+  }
+}
+
+// Applies the queued notifications; 0 if they can't be trusted and a rescan is due
+static int drain(void) {
+  char buf[16384] __attribute__((aligned(__alignof__(struct inotify_event))));
+  ssize_t len;
+  while ((len = read(cat.watch_fd, buf, sizeof(buf))) > 0) {
+    for (char* p = buf; p < buf + len;) {
+      const struct inotify_event* ev = (const struct inotify_event*)p;
+      p += sizeof(struct inotify_event) + ev->len;
+      if (ev->mask & (IN_Q_OVERFLOW | IN_IGNORED | IN_DELETE_SELF | IN_MOVE_SELF)) return 0;
+      if (!ev->len || ignored(ev->name)) continue;
+      cat.dirty |= update_book(ev->name);
+      stats.changes++;
+    }
+  }
+  return 1;
+}
+#endif
+
+int catalog_sync(void) {
+  if (!cat.loaded) {
+    get_user_path(cat.dir, "library", sizeof(cat.dir));
+    load();
+    if (!cat.slots && !rebuild_slots()) return -1;
+    cat.loaded = 1;
+  }
+
+  // Taken first, so a change made while catching up moves it past this
+  struct stat st;
+  if (stat(cat.dir, &st) != 0 || !S_ISDIR(st.st_mode)) return -1;
+  int64_t dir_mtime = st.st_mtime;
+
+#ifdef __linux__
+  if (cat.watch_fd >= 0 && !drain()) {
+    close(cat.watch_fd);
+    cat.watch_fd = -1;
+    cat.dir_mtime = 0;
+  }
+  // Watching starts before the listing, so nothing falls in between
+  if (cat.watch_fd < 0) {
+    watch();
+    if (dir_mtime != cat.dir_mtime) rescan();
+  }
+#else
+  if (dir_mtime != cat.dir_mtime) rescan();
+#endif
+
+  // A directory changed within the last second may change again without
+  // its mtime moving, so that one isn't trusted next time
+  if (time(NULL) - dir_mtime < 2) dir_mtime = 0;
+  if (dir_mtime != cat.dir_mtime) {
+    cat.dir_mtime = dir_mtime;
+    cat.dirty = 1;
+  }
+  if (cat.dirty) save();
+
+  stats.books = cat.count;
+  return cat.count;
+}
+
+const CatalogBook* catalog_book(int i) {
+  return &cat.books[i];
+}
+
+static int by_recency(const void* a, const void* b) {
+  const CatalogBook* x = &cat.books[*(const int*)a];
+  const CatalogBook* y = &cat.books[*(const int*)b];
+  if (x->read_at != y->read_at) return x->read_at < y->read_at ? 1 : -1;
+  int c = strcasecmp(x->title, y->title);
+  return c ? c : strcmp(x->name, y->name);
+}
+
+void catalog_order(int* order) {
+  for (int i = 0; i < cat.count; i++) order[i] = i;
+  qsort(order, cat.count, sizeof(int), by_recency);
+}
+
+void catalog_note_read(int i, int line, size_t pos) {
+  CatalogBook* b = &cat.books[i];
+  b->read_at = time(NULL);
+  b->line = line;
+  b->pos = pos;
+  save();
+}
+
+void catalog_get_stats(CatalogStats* out) {
+  *out = stats;
+}
@@ -0,0 +1,49 @@
+#ifndef CATALOG_H
+#define CATALOG_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Kept out of cache/, whose LRU index would adopt and evict it
+#define CATALOG_DIR "catalog"
+#define CATALOG_FILE "library.cat"
+
+typedef struct {
+  char* name;      // File name in the library
+  char* title;     // The name without ".txt", as listed
+  int64_t size;
+  int64_t mtime;
+  int64_t read_at; // When the reader last closed it, 0 if never
+  int32_t line;    // Where it left off
+  uint64_t pos;
+} CatalogBook;
+
+typedef struct {
+  int books;
+  long rescans; // Library directory listings read this session
+  long changes; // Files updated one by one from change notifications
+} CatalogStats;
+
+/**
+ * Brings the library catalog up to date and returns how many books it
+ * lists, or -1 if the library can't be read. The catalog is kept on disk
+ * and read in one go the first time; after that the directory is only
+ * listed again when its mtime moved, and on Linux inotify reports each
+ * file that changes while the program runs, so no visit rescans it.
+ */
+int catalog_sync(void);
+
+const CatalogBook* catalog_book(int i);
+
+/**
+ * Fills order with every book, most recently read first and the rest by
+ * title. order must hold catalog_sync()'s count.
+ */
+void catalog_order(int* order);
+
+// Records where the reader left a book
+void catalog_note_read(int i, int line, size_t pos);
+
+void catalog_get_stats(CatalogStats* out);
+
+#endif
@@ -0,0 +1,126 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "chapter_cache.h"
+#include "lru_index.h"
+#include "controller.h"
+#include "config.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static LruIndex index;
+static int opened = 0;
+static ChapterCacheStats stats;
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+
+// Call with lock held
+static int ensure_open(void) {
+  if (opened) return opened > 0;
+
+  char dir[PATH_MAX];
+  get_user_path(dir, CHAPTER_CACHE_DIR, sizeof(dir));
+
+  int mb = config_get_int("chapter_cache_mb", CHAPTER_CACHE_DEFAULT_MB);
+  if (mb < 0) mb = 0;
+  opened = lru_open(&index, dir, CHAPTER_CACHE_INDEX, (uint64_t)mb << 20) ? 1 : -1;
+  return opened > 0;
+}
+
+static void cache_path(char* path, size_t size, const char* key) {
+  snprintf(path, size, "%s/%s", index.dir, key);
+}
+
+char* chapter_cache_get(const char* slug) {
+  char key[LRU_KEY_MAX + 1];
+  char path[PATH_MAX + LRU_KEY_MAX + 2];
+  lru_file_key(key, slug, ".txt");
+
+  pthread_mutex_lock(&lock);
+  if (!ensure_open() || !lru_contains(&index, key)) {
+    stats.misses++;
+    pthread_mutex_unlock(&lock);
+    return NULL;
+  }
+  cache_path(path, sizeof(path), key);
+
+  char* text = NULL;
+  FILE* f = fopen(path, "rb");
+  struct stat st;
+  if (f && fstat(fileno(f), &st) == 0 && (text = malloc(st.st_size + 1))) {
+    if (fread(text, 1, st.st_size, f) == (size_t)st.st_size) {
+      text[st.st_size] = '\0';
+    } else {
+      free(text);
+      text = NULL;
+    }
+  }
+  if (f) fclose(f);
+
+  if (text) {
+    lru_touch(&index, key);
+    stats.hits++;
+    stats.bytes_served += st.st_size;
+  } else {
+    // Deleted or truncated behind our back
+    lru_remove(&index, key);
+    stats.misses++;
+  }
+  pthread_mutex_unlock(&lock);
+  return text;
+}
+
+int chapter_cache_has(const char* slug) {
+  char key[LRU_KEY_MAX + 1];
+  lru_file_key(key, slug, ".txt");
+
+  pthread_mutex_lock(&lock);
+  int has = ensure_open() && lru_contains(&index, key);
+  pthread_mutex_unlock(&lock);
+  return has;
+}
+
+void chapter_cache_put(const char* slug, const char* text, size_t len) {
+  char key[LRU_KEY_MAX + 1];
+  char path[PATH_MAX + LRU_KEY_MAX + 2];
+  char tmp[PATH_MAX + LRU_KEY_MAX + 16];
+  lru_file_key(key, slug, ".txt");
+
+  pthread_mutex_lock(&lock);
+  if (!ensure_open() || len > index.budget) {
+    pthread_mutex_unlock(&lock);
+    return;
+  }
+  cache_path(path, sizeof(path), key);
+  pthread_mutex_unlock(&lock);
+
+  // Written aside and renamed in, so readers never see half a chapter
+  snprintf(tmp, sizeof(tmp), "%s.tmp.XXXXXX", path);
+  int fd = mkstemp(tmp);
+  if (fd < 0) return;
+  int ok = write(fd, text, len) == (ssize_t)len;
+  if (close(fd) != 0) ok = 0;
+
+  pthread_mutex_lock(&lock);
+  if (ok && rename(tmp, path) == 0) {
+    lru_insert(&index, key, len);
+    stats.stores++;
+  } else {
+    unlink(tmp);
+  }
+  pthread_mutex_unlock(&lock);
+}
+
+void chapter_cache_get_stats(ChapterCacheStats* out) {
+  pthread_mutex_lock(&lock);
+  ensure_open();
+  *out = stats;
+  out->evictions = index.evictions;
+  out->entries = index.count;
+  out->bytes = index.bytes;
+  out->budget = index.budget;
+  pthread_mutex_unlock(&lock);
+}
@@ -0,0 +1,37 @@
+#ifndef CHAPTER_CACHE_H
+#define CHAPTER_CACHE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define CHAPTER_CACHE_DIR "cache/chapters"
+#define CHAPTER_CACHE_INDEX "chapters.idx"
+#define CHAPTER_CACHE_DEFAULT_MB 64
+
+typedef struct {
+  long hits;
+  long misses;
+  long stores;
+  long evictions;
+  long long bytes_served;  // Chapter text read from disk instead of fetched
+  int entries;
+  uint64_t bytes;          // Currently on disk
+  uint64_t budget;
+} ChapterCacheStats;
+
+/**
+ * Extracted chapter text kept on disk across sessions, keyed by chapter
+ * slug. The total size is capped by "chapter_cache_mb" in the config file;
+ * least recently read chapters are deleted first. Safe to call from the
+ * fetch worker.
+ */
+char* chapter_cache_get(const char* slug);
+
+// Whether slug is cached, without counting a hit or refreshing it
+int chapter_cache_has(const char* slug);
+
+void chapter_cache_put(const char* slug, const char* text, size_t len);
+
+void chapter_cache_get_stats(ChapterCacheStats* out);
+
+#endif
@@ -3,14 +3,23 @@
 #include "network.h"
 #include "chapter_controller.h"
 #include "history.h"
+#include "prefetch.h"
+#include "chapter_index.h"
+#include "chapter_cache.h"
+#include "chapter_list.h"
+#include "stats.h"
+#include "wrap.h"
+#include "text_search.h"
+#include "title_index.h"
+#include "event_loop.h"
 
+#include <ctype.h>
 #include <stdlib.h>
 #include <string.h>
 #include <strings.h>
 #include <curl/curl.h>
 #include <cjson/cJSON.h>
 #include <ncurses.h>
-#include <ctype.h>
 
 /**
  * Creates a centered window for displaying chapter content.
@@ -27,13 +36,14 @@ WINDOW* create_chapter_window() {
 /**
  * Displays a paginated list of chapters in the terminal UI.
  * 
- * @param chapters Array of chapter slugs/URLs
- * @param total Total number of chapters
+ * @param chapters Chapter index; the titles are listed
  * @param offset Current scroll offset (first visible chapter)
  * @param highlight Currently highlighted chapter index
  * @param novel_title Title of the novel to display in header
  */
-void display_chapter_list(char chapters[3500][128], int total, int offset, int highlight, const char* novel_title) {
+void display_chapter_list(const ChapterIndex* chapters, int offset, int highlight, const char* novel_title) {
+  int total = chapter_index_count(chapters);
+  char title[CHAPTER_TEXT_MAX];
 
   clear();
   int rows, cols;
@@ -59,10 +69,10 @@ void display_chapter_list(char chapters[3500][128], int total, int offset, int h
     row = 3 + (i - start);
     if (i == highlight) {
       attron(COLOR_PAIR(5) | A_DIM);
-      mvprintw(row, 0, "➤ %4d: %s", i+1, chapters[i]);
+      mvprintw(row, 0, "➤ %4d: %s", i+1, chapter_index_title(chapters, i, title, sizeof(title)));
       attroff(COLOR_PAIR(5) | A_DIM);
     } else {
-      mvprintw(row, 0, "  %4d: %s", i+1, chapters[i]);
+      mvprintw(row, 0, "  %4d: %s", i+1, chapter_index_title(chapters, i, title, sizeof(title)));
     }
   }
 
@@ -78,27 +88,270 @@ void display_chapter_list(char chapters[3500][128], int total, int offset, int h
   refresh();
 }
 
+// Results the title search lists at most
+#define FIND_RESULTS 64
+
+/**
+ * Title search for the chapter browser. The list is narrowed and ranked
+ * again on every key; a chapter number is also that chapter, listed first.
+ *
+ * @return The chosen chapter, or -1 if the search was left
+ */
+static int find_chapter(const ChapterIndex* chapters, TitleIndex* titles, const char* novel_title) {
+  char query[64] = "";
+  int len = 0;
+  int found[FIND_RESULTS];
+  int count = 0;
+  int highlight = 0;
+  int changed = 1;
+  char title[CHAPTER_TEXT_MAX];
+  int total = chapter_index_count(chapters);
+
+  while (1) {
+    int rows, cols;
+    getmaxyx(stdscr, rows, cols);
+    (void) cols;
+    int visible = rows - 5;
+    if (visible > FIND_RESULTS) visible = FIND_RESULTS;
+    if (visible < 1) visible = 1;
+
+    if (changed) {
+      count = 0;
+      int number = isdigit((unsigned char)query[0]) && strspn(query, "0123456789") == (size_t)len ? atoi(query) : 0;
+      if (number >= 1 && number <= total) found[count++] = number - 1;
+
+      int n = count + title_index_search(titles, query, found + count, visible - count);
+      // The numbered chapter isn't listed twice
+      for (int i = count; i < n; i++) {
+        if (count == 0 || found[i] != found[0]) found[count++] = found[i];
+      }
+      highlight = 0;
+      changed = 0;
+    }
+    if (count > visible) count = visible;
+    if (highlight >= count) highlight = count > 0 ? count - 1 : 0;
+
+    erase();
+    attron(COLOR_PAIR(4));
+    mvprintw(0, 0, "📖 %s   Find: %s", novel_title, query);
+    attroff(COLOR_PAIR(4));
+    attron(COLOR_PAIR(5) | A_DIM);
+    mvprintw(1, 0, "═══════════════════════════════════════════════════════════════");
+    attroff(COLOR_PAIR(5) | A_DIM);
+
+    for (int i = 0; i < count; i++) {
+      chapter_index_title(chapters, found[i], title, sizeof(title));
+      if (i == highlight) {
+        attron(COLOR_PAIR(5) | A_DIM);
+        mvprintw(3 + i, 0, "➤ %4d: %s", found[i] + 1, title);
+        attroff(COLOR_PAIR(5) | A_DIM);
+      } else {
+        mvprintw(3 + i, 0, "  %4d: %s", found[i] + 1, title);
+      }
+    }
+    if (count == 0 && len > 0) mvprintw(3, 2, "No chapter titles match.");
+
+    attron(COLOR_PAIR(4));
+    mvprintw(rows - 1, 2, "Type a title or number   ↑↓ Move   Enter Open   Esc Back");
+    attroff(COLOR_PAIR(4));
+    refresh();
+
+    int ch = getch();
+    switch (ch) {
+      case 27:
+        return -1;
+
+      case 10: case KEY_ENTER:
+        return count > 0 ? found[highlight] : -1;
+
+      case KEY_UP:
+        if (highlight > 0) highlight--;
+        break;
+
+      case KEY_DOWN:
+        if (highlight < count - 1) highlight++;
+        break;
+
+      case KEY_BACKSPACE: case 127: case '\b':
+        // Whole UTF-8 characters, continuation bytes and all
+        while (len > 0 && ((unsigned char)query[--len] & 0xC0) == 0x80) {}
+        query[len] = '\0';
+        changed = 1;
+        break;
+
+      default:
+        if (ch >= ' ' && ch <= 0xFF && ch != 127 && len + 1 < (int)sizeof(query)) {
+          query[len++] = (char)ch;
+          query[len] = '\0';
+          changed = 1;
+        }
+    }
+  }
+}
+
+/**
+ * Starts loading chapter idx. A cached chapter, or a finished prefetch of
+ * it, is put in *text at once; otherwise the returned fetch is still
+ * running. Both NULL means it could not be started.
+ */
+static ChapterFetch* load_chapter(const ChapterIndex* chapters, int idx, char** text) {
+  char slug[CHAPTER_TEXT_MAX];
+  chapter_index_slug(chapters, idx, slug, sizeof(slug));
+  *text = chapter_cache_get(slug);
+  if (*text) return NULL;
+
+  ChapterFetch* fetch = prefetch_claim(slug);
+  if (fetch && chapter_fetch_finished(fetch)) {
+    *text = chapter_fetch_take(fetch);
+    if (*text) return NULL;
+    fetch = NULL; // The prefetch failed; try once more in the foreground
+  }
+  return fetch ? fetch : chapter_fetch_start(slug, FETCH_PRIORITY_FOREGROUND);
+}
+
+// The start of a chapter, shown while the rest of it downloads
+typedef struct {
+  char* text;
+  size_t seen; // Bytes chapter_fetch_partial() has handed out
+  int full;    // Whether the text already fills the screen
+} Preview;
+
+static void preview_clear(Preview* p) {
+  free(p->text);
+  memset(p, 0, sizeof(*p));
+}
+
+static int draw_chapter_preview(const char* novel_title, int chapter_num, const char* text);
+
+static void show_fetch_failed(void) {
+  mvprintw(20, 0, "❌ Failed to fetch chapter!");
+  refresh(); getch();
+}
+
 /**
  * Main chapter browser interface - handles navigation and chapter selection.
+ * A chapter is loaded in the background: the list keeps taking keys,
+ * Enter on another chapter switches to that one and Esc gives up.
  * 
- * @param chapters Array of chapter slugs/URLs for fetching content
- * @param chapter_titles Array of chapter titles for display
- * @param total Total number of chapters
+ * @param chapters Chapter slugs for fetching content and titles for display;
+ *                 grows when a background refresh of the list finds more
  * @param novel_title Novel title for display
- * @param novel_slug Novel slug (unused)
+ * @param novel_slug Novel slug, for the reading history
  * @return -1 when user exits back to previous screen
  */
-int show_chapter_browser(char chapters[3500][128], char chapter_titles[3500][128], int total, const char* novel_title, const char* novel_slug __attribute__((unused)), int start_idx) {
+int show_chapter_browser(ChapterIndex* chapters, const char* novel_title, const char* novel_slug, int start_idx) {
+  int total = chapter_index_count(chapters);
+  char slug[CHAPTER_TEXT_MAX];
+  char title[CHAPTER_TEXT_MAX];
   int highlight = start_idx; // Initialize to the saved chapter
   int offset = start_idx - 5; // Center the view slightly
   if (offset < 0) offset = 0;
   if (highlight >= total) highlight = total - 1;
 
+  // Built once per list, so each key typed in a search is one lookup
+  TitleIndex titles;
+  title_index_build(&titles, chapters);
+
+  // The chapter being loaded, and its text once it is there
+  ChapterFetch* loading = NULL;
+  int loading_idx = -1;
+  char* chapter_text = NULL;
+  Preview preview = {0};
+  int redraw = 1;
+
   // Main navigation loop
   while (1) {
-    display_chapter_list(chapter_titles, total, offset, highlight, novel_title);
+    if (loading && chapter_fetch_finished(loading)) {
+      chapter_text = chapter_fetch_take(loading);
+      loading = NULL;
+      preview_clear(&preview);
+      redraw = 1;
+      if (!chapter_text || !*chapter_text) {
+        free(chapter_text);
+        chapter_text = NULL;
+        display_chapter_list(chapters, offset, highlight, novel_title);
+        show_fetch_failed();
+      }
+    }
+
+    // Keep reading while the user pages through the novel
+    while (chapter_text) {
+      highlight = loading_idx;
+      if (highlight < offset) offset = highlight;
+      if (highlight >= offset + CHAPTERS_VISIBLE) offset = highlight - CHAPTERS_VISIBLE + 1;
+      prefetch_chapters(chapters, highlight);
+
+      // Get navigation intent from the reader window
+      int nav_status = display_chapter_content(novel_title, highlight + 1, chapter_text);
+      chapter_index_slug(chapters, highlight, slug, sizeof(slug));
+      chapter_index_title(chapters, highlight, title, sizeof(title));
+      save_to_history(novel_title, title, slug, novel_slug, highlight + 1);
+      free(chapter_text);
+      chapter_text = NULL;
+
+      if ((nav_status == 1 && highlight < total - 1) || (nav_status == -1 && highlight > 0)) {
+        loading_idx = highlight + nav_status; // Next or previous chapter
+        highlight = loading_idx;
+        if (highlight < offset) offset = highlight;
+        if (highlight >= offset + CHAPTERS_VISIBLE) offset++;
+        loading = load_chapter(chapters, loading_idx, &chapter_text);
+        if (!loading && !chapter_text) {
+          display_chapter_list(chapters, offset, highlight, novel_title);
+          show_fetch_failed();
+        }
+      }
+    }
+
+    if (chapter_list_poll(chapters)) {
+      title_index_free(&titles);
+      title_index_build(&titles, chapters);
+      total = chapter_index_count(chapters);
+      if (highlight >= total) highlight = total - 1;
+      if (offset > highlight) offset = highlight < 0 ? 0 : highlight;
+      redraw = 1;
+    }
+    // Paragraphs are shown as they arrive until they fill the screen
+    if (loading && !preview.full) {
+      char* more = chapter_fetch_partial(loading, &preview.seen);
+      if (more) {
+        free(preview.text);
+        preview.text = more;
+        redraw = 1;
+      }
+    }
+
+    // Ticks only move the progress line; a full redraw would flicker
+    if (redraw) {
+      if (preview.text) preview.full = draw_chapter_preview(novel_title, loading_idx + 1, preview.text);
+      else display_chapter_list(chapters, offset, highlight, novel_title);
+    }
+
+    if (loading) {
+      char progress[64];
+      event_progress(chapter_fetch_job(loading), progress, sizeof(progress));
+      int rows = getmaxy(stdscr);
+      move(rows - 1, 0);
+      clrtoeol();
+      attron(COLOR_PAIR(2));
+      mvprintw(rows - 1, 2, "Loading chapter %d...  %s   Esc Cancel", loading_idx + 1, progress);
+      attroff(COLOR_PAIR(2));
+      refresh();
+    }
+
+    // Wake up now and then while a chapter or the list is on its way
+    int ch = event_getch(loading || chapter_list_refreshing());
+    redraw = ch != ERR;
+
+    // The list is hidden behind a preview, so keys there only back out
+    if (preview.text && ch != ERR && ch != KEY_RESIZE) {
+      if (ch == 27 || ch == 'q' || ch == 'Q' || ch == KEY_LEFT) {
+        chapter_fetch_drop(loading);
+        loading = NULL;
+        preview_clear(&preview);
+      }
+      continue;
+    }
 
-    int ch = getch();
     switch (ch) {
       // Navigate up one chapter
       case KEY_UP:
@@ -123,248 +376,248 @@ int show_chapter_browser(char chapters[3500][128], char chapter_titles[3500][128
         highlight = offset; 
         break;
 
-      // Search/Jump to chapter by number
+      // Search titles, or jump to a chapter by number
       case '/': {
-        echo(); 
-        attron(COLOR_PAIR(4));
-        mvprintw(21, 0, "Enter chapter: "); 
-        attroff(COLOR_PAIR(4));
-        refresh();
-        char search_buf[16]; getnstr(search_buf, 15); noecho();
-        int target = atoi(search_buf);
-        if (target > 0 && target <= total) {
-          offset = target - 5; if (offset < 0) offset = 0;
-          highlight = target - 1;
+        int target = find_chapter(chapters, &titles, novel_title);
+        if (target >= 0) {
+          offset = target - 4; if (offset < 0) offset = 0;
+          highlight = target;
+          // Warm the new neighbourhood, dropping the stale window
+          prefetch_chapters(chapters, highlight - 1);
         }
         break;
       }
 
-      // Enter key - fetch and display chapter content
+      // Enter key - load the chapter; it opens once it is here
       case 10: { // Enter key
-        int nav_status = 0;
-        do {
-          char* chapter_html = fetch_chapter_content(chapters[highlight]);
-
-          if (chapter_html && strlen(chapter_html) > 1000) {
-            // Get navigation intent from the reader window
-            nav_status = display_chapter_content(novel_title, highlight + 1, chapter_html);
-            save_to_history(novel_title, chapter_titles[highlight], chapters[highlight], novel_slug, highlight + 1);
-            free(chapter_html);
-
-            if (nav_status == 1 && highlight < total - 1) { 
-              highlight++; // Move to next chapter
-              if (highlight >= offset + CHAPTERS_VISIBLE) offset++;
-            } 
-            else if (nav_status == -1 && highlight > 0) {
-              highlight--; // Move to previous chapter
-              if (highlight < offset) offset = highlight;
-            }
-            else {
-              nav_status = 0; // Exit to chapter list
-            }
-          } else {
-            mvprintw(20, 0, "❌ Failed to fetch chapter!");
-            refresh(); getch();
-            nav_status = 0;
-          }
-        } while (nav_status != 0); // Keep looping if user navigated
+        if (loading && loading_idx == highlight) break;
+        chapter_fetch_drop(loading);
+        loading_idx = highlight;
+        loading = load_chapter(chapters, loading_idx, &chapter_text);
+        if (!loading && !chapter_text) show_fetch_failed();
         break;
       }
 
+      // Stop loading a chapter
+      case 27:
+        chapter_fetch_drop(loading);
+        loading = NULL;
+        break;
+
       // Quit back to novel list
       case 'q': case 'Q': case KEY_LEFT:
+        chapter_fetch_drop(loading);
+        prefetch_reset();
+        title_index_free(&titles);
         return -1;
     }
   }
 }
 
-/**
- * Extracts text from all id="chapterText" divs in HTML.
- * 
- * @param html HTML string to parse
- * @param output Buffer to store extracted text
- * @param max_size Maximum size of output buffer
- */
-
-// Helper to decode basic HTML entities inline
-char decode_entity(const char **src) {
-    // 1. Handle Hexadecimal: &#x27;
-    if (strncmp(*src, "&#x", 3) == 0) {
-        char *endptr;
-        long val = strtol(*src + 3, &endptr, 16);
-        if (*endptr == ';') {
-            *src = endptr; // Move src pointer to the semicolon
-            return (char)val;
-        }
-    }
-    
-    // 2. Handle Decimal: &#39;
-    if (strncmp(*src, "&#", 2) == 0 && isdigit((*src)[2])) {
-        char *endptr;
-        long val = strtol(*src + 2, &endptr, 10);
-        if (*endptr == ';') {
-            *src = endptr;
-            return (char)val;
-        }
-    }
-
-    // 3. Handle Named Entities (Existing logic)
-    if (strncmp(*src, "&lt;", 4) == 0)    { *src += 3; return '<'; }
-    if (strncmp(*src, "&gt;", 4) == 0)    { *src += 3; return '>'; }
-    if (strncmp(*src, "&amp;", 5) == 0)   { *src += 4; return '&'; }
-    if (strncmp(*src, "&quot;", 6) == 0)  { *src += 5; return '"'; }
-    if (strncmp(*src, "&apos;", 6) == 0)  { *src += 5; return '\''; }
-    if (strncmp(*src, "&nbsp;", 6) == 0)  { *src += 5; return ' '; }
-
-    return **src;
+static ReaderStats reader_stats;
+
+// Redraws body rows [from, to) of the view whose first row is top
+static void draw_body_rows(WINDOW* body, WrapIndex* wrap, const TextSearch* search, WrapPos top, int from, int to) {
+  WrapPos at = top;
+  int more = wrap_step(wrap, &at, from) == from;
+  for (int row = from; row < to; row++) {
+    wmove(body, row, 0);
+    wclrtoeol(body);
+    size_t len;
+    const char* text = more ? wrap_row(wrap, at, &len) : NULL;
+    if (text) text_search_draw(body, row, 2, search, text, len);
+    more = more && wrap_step(wrap, &at, 1) == 1;
+  }
 }
 
-int display_chapter_content(const char* novel_title, int chapter_num, const char* html) {
-  if (!html) return 1;
+/**
+ * Draws the start of a chapter that is still arriving, laid out as the
+ * reader will show it; returns whether it already fills the screen.
+ */
+static int draw_chapter_preview(const char* novel_title, int chapter_num, const char* text) {
+  LineMap map;
+  line_map_open_buffer(&map, text, strlen(text));
+  WrapIndex wrap;
+  wrap_init(&wrap, &map, 1);
+  TextSearch search;
+  text_search_init(&search, &map);
 
   int max_y, max_x;
   getmaxyx(stdscr, max_y, max_x);
-  int width = max_x - 4; // Margin
-
-  // --- STEP 1: Extract & Clean Text ---
-  // Allocate a buffer (same size as HTML is safe)
-  char *clean_text = calloc(strlen(html) + 1, 1);
-  char *dst = clean_text;
-  const char *cursor = html;
-
-  while ((cursor = strstr(cursor, "id=\"chapterText\""))) {
-    // Find text content between '>' and '<'
-    const char *start = strchr(cursor, '>');
-    if (!start) break;
-    start++; // Move past '>'
-
-    const char *end = strchr(start, '<');
-    if (!end) break; // formatting error
-
-    // Process this block: Collapse spaces + Decode entities
-    int space_pending = 0;
-    for (const char *p = start; p < end; p++) {
-      if (isspace(*p)) {
-        if (dst > clean_text) space_pending = 1; // Mark potential space
-      } else {
-        // If we skipped spaces previously, insert ONE space now
-        if (space_pending && *(dst-1) != '\n') *dst++ = ' ';
-        space_pending = 0;
+  int content_h = max_y - 4;
+  if (content_h < 1) content_h = 1;
+  wrap_set_width(&wrap, max_x - 4);
 
-        if (*p == '&') *dst++ = decode_entity(&p);
-        else *dst++ = *p;
-      }
-    }
-
-    // Add paragraph break (double newline)
-    if (dst > clean_text && *(dst-1) != '\n') {
-      *dst++ = '\n'; 
-      *dst++ = '\n';
-    }
-    cursor = end;
+  erase();
+  attron(COLOR_PAIR(4));
+  mvprintw(0, 0, "📖 %s - Chapter %d", novel_title, chapter_num);
+  attroff(COLOR_PAIR(4));
+  attron(COLOR_PAIR(5) | A_DIM);
+  mvprintw(1, 0, "════════════════════════════════════════════════════════════════════");
+  mvprintw(max_y - 2, 0, "════════════════════════════════════════════════════════════════════");
+  attroff(COLOR_PAIR(5) | A_DIM);
+  wnoutrefresh(stdscr);
+
+  int full = 0;
+  WINDOW* body = newwin(content_h, max_x, 2, 0);
+  if (body) {
+    WrapPos top = {0, 0};
+    draw_body_rows(body, &wrap, &search, top, 0, content_h);
+    full = wrap_step(&wrap, &top, content_h - 1) == content_h - 1;
+    wnoutrefresh(body);
+    delwin(body);
   }
-  *dst = '\0';
+  doupdate();
 
-  // --- STEP 2: Word Wrap into Line List ---
-  int line_cap = 1000;
-  int n_lines = 0;
-  char **lines = malloc(line_cap * sizeof(char*));
-  char *ptr = clean_text;
-
-  while (*ptr) {
-    if (n_lines >= line_cap) lines = realloc(lines, (line_cap *= 2) * sizeof(char*));
-
-    // Handle paragraph breaks (empty lines)
-    if (*ptr == '\n') {
-      lines[n_lines++] = strdup(""); 
-      ptr++;
-      continue;
-    }
-
-    // Find where to cut the line
-    int len = 0;
-    char *line_start = ptr;
-
-    // Greedily grab characters until width or newline
-    while (*ptr && *ptr != '\n' && len < width) {
-      ptr++;
-      len++;
-    }
+  wrap_free(&wrap);
+  line_map_close(&map);
+  return full;
+}
 
-    // Backtrack to the last space if we split a word in the middle
-    if (*ptr && *ptr != '\n' && !isspace(*ptr)) {
-      int back_steps = 0;
-      char *temp = ptr;
-      while (back_steps < len && !isspace(*temp)) {
-        temp--; back_steps++;
-      }
-      // If we found a space, cut there. If not (giant word), keep the split.
-      if (back_steps < len) {
-        ptr = temp;
-        len -= back_steps;
-      }
-    }
+static void reader_record_frame(long long before, long long after, int full_frame) {
+  if (before < 0 || after < before) return;
+  long long bytes = after - before;
+  reader_stats.frames++;
+  reader_stats.bytes += bytes;
+  reader_stats.last_frame = bytes;
+  if (!full_frame && bytes > 0) reader_stats.last_scroll = bytes;
+}
 
-    // Copy this line
-    lines[n_lines] = malloc(len + 1);
-    strncpy(lines[n_lines], line_start, len);
-    lines[n_lines][len] = '\0';
-    n_lines++;
+void reader_get_stats(ReaderStats* out) {
+  *out = reader_stats;
+}
 
-    // Skip the space/newline we just broke on
-    if (isspace(*ptr)) ptr++;
-  }
+/**
+ * Chapter reader. Text is wrapped as it is shown, so the first screen
+ * appears at once and a resize only rewraps the paragraph at the top;
+ * the row count in the header follows once the rest is measured.
+ */
+int display_chapter_content(const char* novel_title, int chapter_num, const char* text) {
+  return display_chapter_search(novel_title, chapter_num, text, NULL);
+}
 
-  // --- STEP 3: Display Loop ---
-  int scroll = 0;
+int display_chapter_search(const char* novel_title, int chapter_num, const char* text, const char* find) {
+  if (!text) return 1;
+
+  LineMap map;
+  line_map_open_buffer(&map, text, strlen(text));
+  WrapIndex wrap;
+  wrap_init(&wrap, &map, 1);
+  TextSearch search;
+  text_search_init(&search, &map);
+  int reveal = find && *find;
+  if (reveal) text_search_start(&search, find, 0);
+
+  // The body lives in its own scrolling window so a one-line scroll is a
+  // terminal scroll plus the one new row, not a repaint of the page
+  WINDOW* body = NULL;
+  WrapPos top = {0, 0};
+  int max_y = 0, max_x = 0;
+  int content_h = 1;
+  int full_frame = 1;
+  int relayout = 1;
   int ch = 0;
-  int content_h = max_y - 4; // Reserve space for header/footer
-
-  while (ch != 'q' && ch != KEY_LEFT) {
-    clear();
-
-    // Display header
-    attron(COLOR_PAIR(4));
-    mvprintw(0, 0, "📖 %s - Chapter %d               Line %d/%d", novel_title, chapter_num, scroll + 1, n_lines - 31);
-    attroff(COLOR_PAIR(4));
+  int nav = 0;
 
-    attron(COLOR_PAIR(5) | A_DIM);
-    mvprintw(1, 0, "════════════════════════════════════════════════════════════════════");
-    attroff(COLOR_PAIR(5) | A_DIM);
+  while (1) {
+    if (relayout) {
+      getmaxyx(stdscr, max_y, max_x);
+      content_h = max_y - 4; // Reserve space for header/footer
+      if (content_h < 1) content_h = 1;
+
+      if (body) delwin(body);
+      body = newwin(content_h, max_x, 2, 0);
+      if (!body) break;
+      scrollok(body, TRUE);
+      idlok(body, TRUE);
+
+      if (wrap_set_width(&wrap, max_x - 4)) top = wrap_snap(&wrap, top); // Margin
+      wrap_clamp_bottom(&wrap, &top, content_h);
+      // The match it was opened on can only be placed once the width is known
+      if (reveal && search.hit) wrap_reveal(&wrap, &top, content_h, text_search_pos(&search));
+      reveal = 0;
+
+      erase();
+      attron(COLOR_PAIR(5) | A_DIM);
+      mvprintw(1, 0, "════════════════════════════════════════════════════════════════════");
+      mvprintw(max_y - 2, 0, "════════════════════════════════════════════════════════════════════");
+      attroff(COLOR_PAIR(5) | A_DIM);
 
-    // Body
-    for (int i = 0; i < content_h; i++) {
-      int line_idx = scroll + i;
-      if (line_idx < n_lines) {
-        mvprintw(i + 2, 2, "%s", lines[line_idx]);
-      }
+      draw_body_rows(body, &wrap, &search, top, 0, content_h);
+      full_frame = 1;
+      relayout = 0;
     }
 
-    // Display footer
-    attron(COLOR_PAIR(5) | A_DIM);
-    mvprintw(max_y - 2, 0, "════════════════════════════════════════════════════════════════════");
-    attroff(COLOR_PAIR(5) | A_DIM);
+    // Only the line counter changes between frames; the diff sends just that
+    attron(COLOR_PAIR(4));
+    mvprintw(0, 0, "📖 %s - Chapter %d", novel_title, chapter_num);
+    int row = wrap_row_number(&wrap, top);
+    if (row >= 0) printw("               Line %d/%d", row + 1, wrap_total(&wrap));
+    attroff(COLOR_PAIR(4));
+    clrtoeol();
 
+    // The search prompt takes the footer's place while there is one
+    char status[TEXT_SEARCH_MAX + 64];
+    text_search_status(&search, status, sizeof(status));
     attron(COLOR_PAIR(4));
-    mvprintw(max_y - 1, 2, "← Prev Chap   → Next Chap   ↑↓ Scroll   PgUp/PgDn Page ↑↓   q Back");
+    if (status[0]) mvprintw(max_y - 1, 2, "%s", status);
+    else mvprintw(max_y - 1, 2, "← Prev Chap   → Next Chap   ↑↓ Scroll   PgUp/PgDn Page ↑↓   / Search   q Back");
     attroff(COLOR_PAIR(4));
+    clrtoeol();
+
+    long long before = thread_bytes_written();
+    wnoutrefresh(stdscr);
+    wnoutrefresh(body);
+    doupdate();
+    reader_record_frame(before, thread_bytes_written(), full_frame);
+
+    // Rows are counted between keys until the total is known
+    if (wrap_total(&wrap) < 0) {
+      timeout(0);
+      while ((ch = getch()) == ERR && wrap_measure(&wrap, WRAP_MEASURE_SLICE)) {}
+      timeout(-1);
+      if (ch == ERR) continue;
+    } else {
+      ch = getch();
+    }
 
-    refresh();
-    ch = getch();
-
-    if (ch == 'q' || ch == 'Q') return 0;
-    else if (ch == KEY_LEFT) return -1;
-    else if (ch == KEY_RIGHT) return 1;
-    else if (ch == KEY_UP && scroll > 0) scroll--;
-    else if (ch == KEY_DOWN && scroll < n_lines - content_h) scroll++;
-    else if (ch == KEY_PPAGE) scroll = (scroll - content_h > 0) ? scroll - content_h + 2: 0;
-    else if (ch == KEY_NPAGE) scroll = (scroll + content_h < n_lines - content_h) ? scroll + content_h - 2: n_lines - content_h;
+    SearchAction found = text_search_key(&search, ch, top);
+    if (found != SEARCH_IGNORED) {
+      if (found == SEARCH_CANCELLED) top = wrap_snap(&wrap, search.origin_top);
+      else if (search.hit) wrap_reveal(&wrap, &top, content_h, text_search_pos(&search));
+      draw_body_rows(body, &wrap, &search, top, 0, content_h);
+      full_frame = 1;
+      continue;
+    }
+
+    int delta = 0;
+    if (ch == 'q' || ch == 'Q') { nav = 0; break; }
+    else if (ch == KEY_LEFT) { nav = -1; break; }
+    else if (ch == KEY_RIGHT) { nav = 1; break; }
+    else if (ch == KEY_RESIZE) { relayout = 1; continue; }
+    else if (ch == KEY_UP) delta = -1;
+    else if (ch == KEY_DOWN) delta = 1;
+    else if (ch == KEY_PPAGE) delta = -(content_h - 2);
+    else if (ch == KEY_NPAGE) delta = content_h - 2;
+
+    delta = wrap_step(&wrap, &top, delta);
+    delta += wrap_clamp_bottom(&wrap, &top, content_h);
+    full_frame = delta <= -content_h || delta >= content_h;
+    if (full_frame) {
+      draw_body_rows(body, &wrap, &search, top, 0, content_h);
+    } else if (delta > 0) {
+      wscrl(body, delta);
+      draw_body_rows(body, &wrap, &search, top, content_h - delta, content_h);
+    } else if (delta < 0) {
+      wscrl(body, delta);
+      draw_body_rows(body, &wrap, &search, top, 0, -delta);
+    }
   }
 
-  // Cleanup
-  free(clean_text);
-  for (int i = 0; i < n_lines; i++) free(lines[i]);
-  free(lines);
+  if (body) delwin(body);
+  touchwin(stdscr);
 
-  return 0;
+  wrap_free(&wrap);
+  line_map_close(&map);
+  return nav;
 }
@@ -4,6 +4,8 @@
 #include <stdio.h>
 #include <ncurses.h>
 
+#include "chapter_index.h"
+
 #define CHAPTERS_VISIBLE 15
 #define CHAPTER_WINDOW_HEIGHT 15
 #define CHAPTER_WINDOW_WIDTH 60
@@ -11,23 +13,34 @@
 #define CONTENT_WIDTH 100
 
 void display_chapter_list(
-    char chapters[3500][128], 
-    int total, int offset, 
+    const ChapterIndex* chapters, 
+    int offset, 
     int highlight, 
     const char* novel_title
     );
 
-int chapter_search_menu(WINDOW* win, char chapters[3500][128], int total, int* new_offset);
+int chapter_search_menu(WINDOW* win, const ChapterIndex* chapters, int* new_offset);
 
 int show_chapter_browser(
-    char chapters[3500][128], 
-    char chapter_titles[3500][128], 
-    int total, 
+    ChapterIndex* chapters, 
     const char* novel_title, 
     const char* novel_slug,
     int start_idx
     );
 
-int display_chapter_content(const char* novel_title, int chapter_num, const char* html);
+typedef struct {
+  long frames;          // Screen updates made by the chapter reader
+  long long bytes;      // Bytes they wrote to the terminal
+  long long last_frame;
+  long long last_scroll; // Most recent update that scrolled the body in place
+} ReaderStats;
+
+// Shows one chapter; returns 1 for the next chapter, -1 for the previous, 0 to leave
+int display_chapter_content(const char* novel_title, int chapter_num, const char* text);
+
+// display_chapter_content() opened on the first match of find, if any
+int display_chapter_search(const char* novel_title, int chapter_num, const char* text, const char* find);
+
+void reader_get_stats(ReaderStats* out);
 
 #endif
@@ -0,0 +1,140 @@
+#include "chapter_index.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+static void list_init(FrontCodedList* list) {
+  memset(list, 0, sizeof(*list));
+}
+
+static void list_free(FrontCodedList* list) {
+  free(list->data);
+  free(list->blocks);
+  list_init(list);
+}
+
+// Makes room for one more entry of up to len bytes, so the add can't fail
+static int reserve(FrontCodedList* list, size_t len) {
+  if (list->count % CHAPTER_INDEX_BLOCK == 0 && list->count / CHAPTER_INDEX_BLOCK >= list->block_cap) {
+    int cap = list->block_cap ? list->block_cap * 2 : 64;
+    uint32_t* ptr = realloc(list->blocks, cap * sizeof(uint32_t));
+    if (!ptr) return 0;
+    list->blocks = ptr;
+    list->block_cap = cap;
+  }
+
+  size_t extra = len + 4;
+  if (list->len + extra <= list->cap) return 1;
+  size_t cap = list->cap ? list->cap : 4096;
+  while (list->len + extra > cap) cap *= 2;
+  char* ptr = realloc(list->data, cap);
+  if (!ptr) return 0;
+  list->data = ptr;
+  list->cap = cap;
+  return 1;
+}
+
+// Lengths are below CHAPTER_TEXT_MAX, so one or two bytes
+static void put_length(FrontCodedList* list, size_t n) {
+  if (n >= 0x80) list->data[list->len++] = (char)(0x80 | (n >> 7));
+  list->data[list->len++] = (char)(n & 0x7F);
+}
+
+static size_t get_length(const char** p) {
+  const unsigned char* u = (const unsigned char*)*p;
+  size_t n = 0;
+  if (*u & 0x80) n = (size_t)(*u++ & 0x7F) << 7;
+  n |= *u++;
+  *p = (const char*)u;
+  return n;
+}
+
+// Cuts at CHAPTER_TEXT_MAX - 1 without splitting a UTF-8 sequence
+static size_t clamp_length(const char* s) {
+  size_t len = strlen(s);
+  if (len < CHAPTER_TEXT_MAX) return len;
+  len = CHAPTER_TEXT_MAX - 1;
+  while (len > 0 && ((unsigned char)s[len] & 0xC0) == 0x80) len--;
+  return len;
+}
+
+static void list_add(FrontCodedList* list, const char* s, size_t len) {
+  size_t shared = 0;
+
+  if (list->count % CHAPTER_INDEX_BLOCK == 0) {
+    list->blocks[list->count / CHAPTER_INDEX_BLOCK] = (uint32_t)list->len;
+  } else {
+    while (shared < len && shared < list->last_len && s[shared] == list->last[shared]) shared++;
+  }
+
+  put_length(list, shared);
+  put_length(list, len - shared);
+  memcpy(list->data + list->len, s + shared, len - shared);
+  list->len += len - shared;
+
+  memcpy(list->last + shared, s + shared, len - shared);
+  list->last_len = len;
+  list->count++;
+}
+
+static const char* list_get(const FrontCodedList* list, int i, char* buf, size_t size) {
+  char entry[CHAPTER_TEXT_MAX];
+  size_t entry_len = 0;
+
+  if (i >= 0 && i < list->count) {
+    // Replay the block from its restart point up to entry i
+    const char* p = list->data + list->blocks[i / CHAPTER_INDEX_BLOCK];
+    for (int k = i - i % CHAPTER_INDEX_BLOCK; k <= i; k++) {
+      size_t shared = get_length(&p);
+      size_t suffix = get_length(&p);
+      memcpy(entry + shared, p, suffix);
+      entry_len = shared + suffix;
+      p += suffix;
+    }
+  }
+
+  if (size == 0) return buf;
+  if (entry_len >= size) entry_len = size - 1;
+  memcpy(buf, entry, entry_len);
+  buf[entry_len] = '\0';
+  return buf;
+}
+
+void chapter_index_init(ChapterIndex* index) {
+  list_init(&index->slugs);
+  list_init(&index->titles);
+}
+
+int chapter_index_add(ChapterIndex* index, const char* slug, const char* title) {
+  if (!title) title = "";
+  size_t slug_len = clamp_length(slug);
+  size_t title_len = clamp_length(title);
+
+  // Both lists must stay the same length, so reserve before writing either
+  if (!reserve(&index->slugs, slug_len) || !reserve(&index->titles, title_len)) return 0;
+  list_add(&index->slugs, slug, slug_len);
+  list_add(&index->titles, title, title_len);
+  return 1;
+}
+
+int chapter_index_count(const ChapterIndex* index) {
+  return index->slugs.count;
+}
+
+const char* chapter_index_slug(const ChapterIndex* index, int i, char* buf, size_t size) {
+  return list_get(&index->slugs, i, buf, size);
+}
+
+const char* chapter_index_title(const ChapterIndex* index, int i, char* buf, size_t size) {
+  return list_get(&index->titles, i, buf, size);
+}
+
+size_t chapter_index_bytes(const ChapterIndex* index) {
+  return index->slugs.cap + index->titles.cap +
+         (index->slugs.block_cap + index->titles.block_cap) * sizeof(uint32_t);
+}
+
+void chapter_index_free(ChapterIndex* index) {
+  list_free(&index->slugs);
+  list_free(&index->titles);
+}
@@ -0,0 +1,59 @@
+#ifndef CHAPTER_INDEX_H
+#define CHAPTER_INDEX_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Longest slug or title kept per chapter; also the size callers decode into
+#define CHAPTER_TEXT_MAX 256
+
+// Entries between restart points; a lookup decodes at most this many
+#define CHAPTER_INDEX_BLOCK 16
+
+/**
+ * Front-coded string list: each entry stores how many leading bytes it
+ * shares with the previous one plus the differing suffix, and every
+ * CHAPTER_INDEX_BLOCK-th entry is stored whole so lookups never decode
+ * more than one block. Chapter titles ("Chapter 1234 - ...") and slugs
+ * ("novel-slug-chapter-1234") share long prefixes, so most entries cost
+ * a few bytes.
+ */
+typedef struct {
+  char* data;
+  size_t len;
+  size_t cap;
+
+  uint32_t* blocks;      // Offset in data of each restart entry
+  int block_cap;
+  int count;
+
+  char last[CHAPTER_TEXT_MAX]; // Previous entry, to code the next one against
+  size_t last_len;
+} FrontCodedList;
+
+/**
+ * The chapters of one novel in reading order. Grows without limit; memory
+ * per chapter is roughly the bytes that differ from its predecessor.
+ */
+typedef struct {
+  FrontCodedList slugs;
+  FrontCodedList titles;
+} ChapterIndex;
+
+void chapter_index_init(ChapterIndex* index);
+
+// Returns 0 if out of memory; fields longer than CHAPTER_TEXT_MAX are cut
+int chapter_index_add(ChapterIndex* index, const char* slug, const char* title);
+
+int chapter_index_count(const ChapterIndex* index);
+
+// Copy entry i into buf (at most CHAPTER_TEXT_MAX bytes needed) and return buf
+const char* chapter_index_slug(const ChapterIndex* index, int i, char* buf, size_t size);
+const char* chapter_index_title(const ChapterIndex* index, int i, char* buf, size_t size);
+
+// Bytes held by the index, for the statistics screen
+size_t chapter_index_bytes(const ChapterIndex* index);
+
+void chapter_index_free(ChapterIndex* index);
+
+#endif
@@ -0,0 +1,465 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "chapter_list.h"
+#include "controller.h"
+#include "fetcher.h"
+#include "event_loop.h"
+#include "jsonscan.h"
+#include "lru_index.h"
+#include "crc32.h"
+#include "revalidate.h"
+#include "config.h"
+
+#include <fcntl.h>
+#include <limits.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+/*
+ * Saved list layout, integers in host byte order:
+ *
+ *   "NCC1"  i64 fetched_at  u32 crc  u32 count
+ *   u16 etag_len  etag  u16 last_modified_len  last_modified
+ *   count x { u16 slug_len  slug  u16 title_len  title }
+ *
+ * The CRC covers everything after itself, so a 304 only rewrites
+ * fetched_at in place.
+ */
+#define LIST_MAGIC "NCC1"
+#define LIST_HEADER 20
+
+enum { REFRESH_FAILED, REFRESH_UNCHANGED, REFRESH_UPDATED };
+enum { CHAPTER_TITLE, CHAPTER_SLUG, CHAPTER_END };
+
+typedef struct {
+  char path[PATH_MAX + LRU_KEY_MAX + 2];
+  HttpValidators validators; // Those sent, then those received
+  int64_t fetched_at;
+  int have_file;
+  FetchJob* job;
+
+  // Owned by the worker until finished is set
+  JsonScan js;
+  ChapterIndex fresh;
+  char entry_slug[CHAPTER_TEXT_MAX]; // Fields of the entry being read, in either order
+  char entry_title[CHAPTER_TEXT_MAX];
+  int result;
+  int finished;
+  int orphaned; // Dropped by the UI; the done callback frees it
+} Refresh;
+
+static Refresh* current = NULL;
+static Refresh* warming = NULL; // A first fetch started by chapter_list_warm()
+static ChapterListStats stats;
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+
+// Saved lists by recency; written from the fetch worker, so it has its own lock
+static LruIndex lists;
+static int lists_opened = 0;
+static pthread_mutex_t lists_lock = PTHREAD_MUTEX_INITIALIZER;
+
+// Call with lists_lock held
+static int open_lists(void) {
+  if (lists_opened) return lists_opened > 0;
+
+  char dir[PATH_MAX];
+  get_user_path(dir, CHAPTER_LIST_DIR, sizeof(dir));
+
+  int mb = config_get_int("chapter_list_mb", CHAPTER_LIST_DEFAULT_MB);
+  if (mb < 0) mb = 0;
+  lists_opened = lru_open(&lists, dir, CHAPTER_LIST_INDEX, (uint64_t)mb << 20) ? 1 : -1;
+  return lists_opened > 0;
+}
+
+// Marks the list at path as just used; size > 0 records a new copy of it
+static void note_list(const char* path, size_t size) {
+  const char* key = strrchr(path, '/');
+  key = key ? key + 1 : path;
+
+  pthread_mutex_lock(&lists_lock);
+  if (open_lists()) {
+    if (size) lru_insert(&lists, key, size);
+    else lru_touch(&lists, key);
+  }
+  pthread_mutex_unlock(&lists_lock);
+}
+
+static void list_path(char* path, size_t size, const char* novel_slug) {
+  char dir[PATH_MAX];
+  char key[LRU_KEY_MAX + 1];
+  get_user_path(dir, CHAPTER_LIST_DIR, sizeof(dir));
+  lru_file_key(key, novel_slug, ".lst");
+  snprintf(path, size, "%s/%s", dir, key);
+}
+
+static int get_field(const unsigned char** p, const unsigned char* end, char* out, size_t size) {
+  uint16_t len;
+  if (end - *p < 2) return 0;
+  memcpy(&len, *p, 2);
+  if (len >= size || end - *p - 2 < len) return 0;
+  memcpy(out, *p + 2, len);
+  out[len] = '\0';
+  *p += 2 + len;
+  return 1;
+}
+
+// Fills index and r's validators from a saved list; 0 if there is none
+static int load_list(Refresh* r, ChapterIndex* index) {
+  int fd = open(r->path, O_RDONLY);
+  if (fd < 0) return 0;
+
+  struct stat st;
+  void* data = MAP_FAILED;
+  if (fstat(fd, &st) == 0 && st.st_size >= LIST_HEADER)
+    data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED) return 0;
+
+  const unsigned char* p = data;
+  const unsigned char* end = p + st.st_size;
+  uint32_t crc, count;
+  memcpy(&r->fetched_at, p + 4, 8);
+  memcpy(&crc, p + 12, 4);
+  memcpy(&count, p + 16, 4);
+  int ok = memcmp(p, LIST_MAGIC, 4) == 0 && crc32(p + 16, st.st_size - 16) == crc;
+
+  p += LIST_HEADER;
+  ok = ok && get_field(&p, end, r->validators.etag, sizeof(r->validators.etag)) &&
+       get_field(&p, end, r->validators.last_modified, sizeof(r->validators.last_modified));
+
+  char slug[CHAPTER_TEXT_MAX], title[CHAPTER_TEXT_MAX];
+  for (uint32_t i = 0; ok && i < count; i++) {
+    ok = get_field(&p, end, slug, sizeof(slug)) && get_field(&p, end, title, sizeof(title)) &&
+         chapter_index_add(index, slug, title);
+  }
+  munmap(data, st.st_size);
+
+  if (!ok || p != end) {
+    chapter_index_free(index);
+    chapter_index_init(index);
+    memset(&r->validators, 0, sizeof(r->validators));
+    return 0;
+  }
+  note_list(r->path, 0);
+  return 1;
+}
+
+static int put_field(unsigned char** buf, size_t* len, size_t* cap, const char* s) {
+  size_t n = strlen(s);
+  if (*len + 2 + n > *cap) {
+    size_t grown = *cap * 2 + 2 + n;
+    unsigned char* ptr = realloc(*buf, grown);
+    if (!ptr) return 0;
+    *buf = ptr;
+    *cap = grown;
+  }
+  uint16_t n16 = n;
+  memcpy(*buf + *len, &n16, 2);
+  memcpy(*buf + *len + 2, s, n);
+  *len += 2 + n;
+  return 1;
+}
+
+// Runs on the fetch worker; written aside and renamed in
+static void save_list(const Refresh* r) {
+  size_t len = LIST_HEADER, cap = 4096;
+  unsigned char* buf = malloc(cap);
+  if (!buf) return;
+
+  int count = chapter_index_count(&r->fresh);
+  char slug[CHAPTER_TEXT_MAX], title[CHAPTER_TEXT_MAX];
+  int ok = put_field(&buf, &len, &cap, r->validators.etag) &&
+           put_field(&buf, &len, &cap, r->validators.last_modified);
+  for (int i = 0; ok && i < count; i++) {
+    ok = put_field(&buf, &len, &cap, chapter_index_slug(&r->fresh, i, slug, sizeof(slug))) &&
+         put_field(&buf, &len, &cap, chapter_index_title(&r->fresh, i, title, sizeof(title)));
+  }
+
+  if (ok) {
+    int64_t now = time(NULL);
+    uint32_t n = count;
+    memcpy(buf, LIST_MAGIC, 4);
+    memcpy(buf + 4, &now, 8);
+    memcpy(buf + 16, &n, 4);
+    uint32_t crc = crc32(buf + 16, len - 16);
+    memcpy(buf + 12, &crc, 4);
+
+    char tmp[sizeof(r->path) + 16];
+    snprintf(tmp, sizeof(tmp), "%s.tmp.XXXXXX", r->path);
+    int fd = mkstemp(tmp);
+    if (fd >= 0) {
+      ok = write(fd, buf, len) == (ssize_t)len;
+      if (close(fd) != 0) ok = 0;
+      if (!ok || rename(tmp, r->path) != 0) unlink(tmp);
+      else note_list(r->path, len);
+    }
+  }
+  free(buf);
+}
+
+// Runs on the fetch worker after a 304; only the fetch time changes
+static int touch_list(const Refresh* r) {
+  int fd = open(r->path, O_WRONLY);
+  if (fd < 0) return 0;
+  int64_t now = time(NULL);
+  int ok = pwrite(fd, &now, 8, 4) == 8;
+  if (close(fd) != 0) ok = 0;
+  if (ok) note_list(r->path, 0);
+  return ok;
+}
+
+// Copies a field, cutting an overlong one without splitting a UTF-8 sequence
+static void copy_field(char* dest, size_t size, const char* value, size_t len) {
+  if (len >= size) {
+    len = size - 1;
+    while (len > 0 && ((unsigned char)value[len] & 0xC0) == 0x80) len--;
+  }
+  memcpy(dest, value, len);
+  dest[len] = '\0';
+}
+
+static void chapter_field(int selector, const char* value, size_t len, void* userdata) {
+  Refresh* r = userdata;
+
+  switch (selector) {
+    case CHAPTER_TITLE:
+      copy_field(r->entry_title, sizeof(r->entry_title), value, len);
+      break;
+    case CHAPTER_SLUG:
+      copy_field(r->entry_slug, sizeof(r->entry_slug), value, len);
+      break;
+    case CHAPTER_END:
+      // Entries without a slug can't be opened, so they aren't listed
+      if (r->entry_slug[0]) chapter_index_add(&r->fresh, r->entry_slug, r->entry_title);
+      r->entry_slug[0] = '\0';
+      r->entry_title[0] = '\0';
+      break;
+  }
+}
+
+static void refresh_header(const char* line, size_t len, void* userdata) {
+  Refresh* r = userdata;
+  http_validators_header(&r->validators, line, len);
+}
+
+static size_t refresh_write(const char* data, size_t len, void* userdata) {
+  Refresh* r = userdata;
+  if (r->validators.status != 200) return len;
+  return jsonscan_feed(&r->js, data, len) ? len : 0;
+}
+
+static void refresh_free(Refresh* r) {
+  chapter_index_free(&r->fresh);
+  free(r);
+}
+
+static void refresh_done(int ok, void* userdata) {
+  Refresh* r = userdata;
+
+  if (ok && r->validators.status == 304 && r->have_file) {
+    touch_list(r);
+    r->result = REFRESH_UNCHANGED;
+  } else if (ok && r->validators.status == 200 && jsonscan_finish(&r->js)) {
+    save_list(r);
+    r->result = REFRESH_UPDATED;
+  } else {
+    r->result = REFRESH_FAILED;
+  }
+  jsonscan_free(&r->js);
+
+  pthread_mutex_lock(&lock);
+  r->finished = 1;
+  int orphaned = r->orphaned;
+  pthread_mutex_unlock(&lock);
+
+  if (orphaned) refresh_free(r);
+}
+
+static int start_refresh(Refresh* r, const char* novel_slug, FetchPriority priority) {
+  static const char* const selectors[] = {
+    [CHAPTER_TITLE] = "[].title",
+    [CHAPTER_SLUG] = "[].novSlugChapSlug",
+    [CHAPTER_END] = "[]",
+  };
+  char url[512];
+  char lines[2][HTTP_VALIDATOR_MAX + 32];
+  const char* headers[3];
+
+  snprintf(url, sizeof(url), "https://wuxiaworld.eu/api/chapters/%s/", novel_slug);
+  http_validators_request(&r->validators, lines, headers);
+
+  chapter_index_init(&r->fresh);
+  jsonscan_init(&r->js, selectors, 3, chapter_field, r);
+
+  FetchSink sink = {
+    .header = refresh_header, .write = refresh_write, .done = refresh_done,
+    .userdata = r, .request_headers = headers,
+  };
+  r->job = fetcher_submit(url, priority, &sink);
+  if (!r->job) {
+    jsonscan_free(&r->js);
+    return 0;
+  }
+  return 1;
+}
+
+// Gives up on r, which the done callback frees if it is still running
+static void refresh_drop(Refresh* r) {
+  if (fetcher_abandon(r->job, &lock, &r->finished, &r->orphaned)) refresh_free(r);
+}
+
+void chapter_list_warm(const char* novel_slug) {
+  char path[sizeof(warming->path)];
+  list_path(path, sizeof(path), novel_slug);
+  if (warming && strcmp(warming->path, path) == 0) return;
+
+  // Only the latest highlighted novel is worth the bandwidth
+  if (warming) refresh_drop(warming);
+  warming = NULL;
+
+  // A saved list opens at once anyway and is refreshed from there
+  struct stat st;
+  if (stat(path, &st) == 0) return;
+
+  Refresh* r = calloc(1, sizeof(Refresh));
+  if (!r) return;
+  memcpy(r->path, path, sizeof(path));
+  if (!start_refresh(r, novel_slug, FETCH_PRIORITY_PREFETCH)) {
+    free(r);
+    return;
+  }
+  warming = r;
+  stats.warmed++;
+}
+
+int chapter_list_open(const char* novel_slug, ChapterIndex* index) {
+  chapter_list_close();
+
+  Refresh* r = calloc(1, sizeof(Refresh));
+  if (!r) return 0;
+  list_path(r->path, sizeof(r->path), novel_slug);
+
+  // A warm-up still on the wire is joined rather than started over; one
+  // that has finished left its list on disk, loaded below
+  if (warming && strcmp(warming->path, r->path) == 0) {
+    pthread_mutex_lock(&lock);
+    int finished = warming->finished;
+    pthread_mutex_unlock(&lock);
+    if (!finished) {
+      free(r);
+      r = warming;
+      warming = NULL;
+      current = r;
+      fetcher_promote(r->job);
+      event_await(r->job, "Loading chapter list...");
+      chapter_list_poll(index);
+      return chapter_index_count(index);
+    }
+  }
+  if (warming) refresh_drop(warming);
+  warming = NULL;
+
+  r->have_file = load_list(r, index);
+  int have_file = r->have_file;
+  if (have_file) stats.loaded++;
+
+  // Checked recently enough: the saved list is served as is
+  if (have_file && !revalidate_due(r->fetched_at, "chapter_list_ttl", CHAPTER_LIST_DEFAULT_TTL)) {
+    free(r);
+    return chapter_index_count(index);
+  }
+
+  if (!start_refresh(r, novel_slug, have_file ? FETCH_PRIORITY_PREFETCH : FETCH_PRIORITY_FOREGROUND)) {
+    free(r);
+    return chapter_index_count(index);
+  }
+  current = r;
+
+  if (!have_file) {
+    // Nothing to show yet, so this one is worth waiting for
+    event_await(r->job, "Loading chapter list...");
+    chapter_list_poll(index);
+  }
+  return chapter_index_count(index);
+}
+
+/**
+ * Whether b starts with the first count chapters of a. Every entry is
+ * compared: a chapter renamed, removed or moved upstream anywhere in the
+ * list means the new one is taken whole.
+ */
+static int extends(const ChapterIndex* a, const ChapterIndex* b, int count) {
+  char x[CHAPTER_TEXT_MAX], y[CHAPTER_TEXT_MAX];
+  if (chapter_index_count(b) < count) return 0;
+
+  for (int i = 0; i < count; i++) {
+    if (strcmp(chapter_index_slug(a, i, x, sizeof(x)), chapter_index_slug(b, i, y, sizeof(y))) != 0 ||
+        strcmp(chapter_index_title(a, i, x, sizeof(x)), chapter_index_title(b, i, y, sizeof(y))) != 0)
+      return 0;
+  }
+  return 1;
+}
+
+int chapter_list_poll(ChapterIndex* index) {
+  Refresh* r = current;
+  if (!r) return 0;
+
+  pthread_mutex_lock(&lock);
+  int finished = r->finished;
+  pthread_mutex_unlock(&lock);
+  if (!finished) return 0;
+
+  int changed = 0;
+  if (r->result == REFRESH_UNCHANGED) {
+    stats.unchanged++;
+  } else if (r->result == REFRESH_UPDATED) {
+    int count = chapter_index_count(index);
+    int total = chapter_index_count(&r->fresh);
+    if (!r->have_file) stats.fetched++;
+
+    if (extends(index, &r->fresh, count)) {
+      // Only the new tail is copied in; what the reader holds stays put
+      char slug[CHAPTER_TEXT_MAX], title[CHAPTER_TEXT_MAX];
+      for (int i = count; i < total; i++) {
+        chapter_index_slug(&r->fresh, i, slug, sizeof(slug));
+        chapter_index_title(&r->fresh, i, title, sizeof(title));
+        if (!chapter_index_add(index, slug, title)) break;
+      }
+      if (r->have_file) stats.new_chapters += total - count;
+      changed = total > count;
+    } else {
+      // Reordered or renamed upstream: take the new list whole
+      ChapterIndex old = *index;
+      *index = r->fresh;
+      r->fresh = old;
+      changed = 1;
+    }
+  }
+
+  fetcher_release(r->job);
+  refresh_free(r);
+  current = NULL;
+  return changed;
+}
+
+int chapter_list_refreshing(void) {
+  return current != NULL;
+}
+
+void chapter_list_close(void) {
+  Refresh* r = current;
+  if (!r) return;
+  current = NULL;
+  refresh_drop(r);
+}
+
+void chapter_list_get_stats(ChapterListStats* out) {
+  *out = stats;
+}
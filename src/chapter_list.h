@@ -0,0 +1,48 @@
+#ifndef CHAPTER_LIST_H
+#define CHAPTER_LIST_H
+
+#include "chapter_index.h"
+
+#define CHAPTER_LIST_DIR "cache/lists"
+#define CHAPTER_LIST_INDEX "lists.idx"
+#define CHAPTER_LIST_DEFAULT_MB 16
+#define CHAPTER_LIST_DEFAULT_TTL 600
+
+typedef struct {
+  long loaded;       // Novels opened from a saved list
+  long fetched;      // Lists downloaded in full
+  long unchanged;    // Refreshes answered 304 Not Modified
+  long new_chapters; // Chapters appended by background refreshes
+  long warmed;       // Lists fetched ahead while their novel was highlighted
+} ChapterListStats;
+
+/**
+ * Fills index with the chapters of novel_slug. A list saved by an earlier
+ * visit is loaded from disk and returned at once and, once it is older
+ * than "chapter_list_ttl" seconds, a conditional request checks for new
+ * chapters in the background; a novel seen for the first time is fetched
+ * now. Saved lists are capped by "chapter_list_mb", least recently opened
+ * dropped first.
+ * Returns the number of chapters loaded.
+ */
+int chapter_list_open(const char* novel_slug, ChapterIndex* index);
+
+/**
+ * Starts fetching the list of a novel that has none saved yet, at
+ * speculative priority, so opening it needs no wait. Only the most recent
+ * novel is warmed: the previous warm-up is cancelled if still running.
+ */
+void chapter_list_warm(const char* novel_slug);
+
+// Applies a finished background refresh to index; returns 1 if it changed
+int chapter_list_poll(ChapterIndex* index);
+
+// Whether the refresh started by chapter_list_open() is still running
+int chapter_list_refreshing(void);
+
+// Abandons the refresh, e.g. when leaving the novel
+void chapter_list_close(void);
+
+void chapter_list_get_stats(ChapterListStats* out);
+
+#endif
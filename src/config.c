@@ -0,0 +1,74 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "config.h"
+#include "controller.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <limits.h>
+#include <pthread.h>
+
+#define MAX_SETTINGS 64
+
+typedef struct {
+  char key[64];
+  char value[128];
+} Setting;
+
+static Setting settings[MAX_SETTINGS];
+static int setting_count = 0;
+static pthread_once_t load_once = PTHREAD_ONCE_INIT;
+
+static char* trim(char* s) {
+  while (isspace((unsigned char)*s)) s++;
+  char* end = s + strlen(s);
+  while (end > s && isspace((unsigned char)end[-1])) end--;
+  *end = '\0';
+  return s;
+}
+
+/**
+ * Loads "key = value" lines once per process. Lines starting with '#' are
+ * comments; unknown keys are kept and simply never asked for. Runs under
+ * pthread_once since the fetch worker reads settings too.
+ */
+static void load_config(void) {
+  char dir[PATH_MAX];
+  get_user_path(dir, "config", sizeof(dir));
+
+  char path[PATH_MAX];
+  if (snprintf(path, sizeof(path), "%s/%s", dir, CONFIG_FILE) >= (int)sizeof(path)) return;
+
+  FILE* f = fopen(path, "r");
+  if (!f) return;
+
+  char line[256];
+  while (fgets(line, sizeof(line), f) && setting_count < MAX_SETTINGS) {
+    char* s = trim(line);
+    if (*s == '#' || *s == '\0') continue;
+
+    char* eq = strchr(s, '=');
+    if (!eq) continue;
+    *eq = '\0';
+
+    snprintf(settings[setting_count].key, sizeof(settings[0].key), "%s", trim(s));
+    snprintf(settings[setting_count].value, sizeof(settings[0].value), "%s", trim(eq + 1));
+    setting_count++;
+  }
+  fclose(f);
+}
+
+int config_get_int(const char* key, int fallback) {
+  pthread_once(&load_once, load_config);
+
+  for (int i = 0; i < setting_count; i++) {
+    if (strcmp(settings[i].key, key) == 0) {
+      char* end;
+      long val = strtol(settings[i].value, &end, 10);
+      if (end != settings[i].value) return (int)val;
+    }
+  }
+  return fallback;
+}
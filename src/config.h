@@ -0,0 +1,9 @@
+#ifndef CONFIG_H
+#define CONFIG_H
+
+#define CONFIG_FILE "novel-cli.conf"
+
+// Reads an integer setting from ~/.local/share/novel-cli/config/novel-cli.conf
+int config_get_int(const char* key, int fallback);
+
+#endif
@@ -5,11 +5,10 @@
 #include "library.h"
 #include "webnovel.h"
 #include "history.h"
+#include "stats.h"
 
 #include <stdlib.h>
 #include <string.h>
-#include <curl/curl.h>
-#include <cjson/cJSON.h>
 #include <ncurses.h>
 #include <sys/stat.h>
 #include <unistd.h>
@@ -47,13 +46,9 @@ FILE* select_main_menu(int choice, char* main_options[], int size_main_options)
   (void) size_main_options;
   (void) main_options;
   if(choice == 0){
-    CURL* handle;
-    CURLcode result;
-    cJSON* json;
+    BookResults books;
     char book_name[100];
 
-    handle = curl_easy_init();
-
     echo();
     clear();
     attron(COLOR_PAIR(4));
@@ -64,45 +59,17 @@ FILE* select_main_menu(int choice, char* main_options[], int size_main_options)
     noecho();
     book_name[strcspn(book_name, "\n")] = 0;
 
-    json = load_from_cache(book_name);
-    if (!json) {
-      char* encoded = curl_easy_escape(handle, book_name, 0);
-      char url[512];
-      snprintf(url, sizeof(url),"https://gutendex.com/books/?search=%s",encoded);
-
-      struct Memory chunk;
-      chunk.data = malloc(1);
-      chunk.size = 0;
-
-      curl_easy_setopt(handle, CURLOPT_URL, url);
-      curl_easy_setopt(handle, CURLOPT_WRITEFUNCTION, write_callback);
-      curl_easy_setopt(handle, CURLOPT_WRITEDATA, (void *)&chunk);
-
-      curl_easy_setopt(handle, CURLOPT_FOLLOWLOCATION, 1L);
-
-      result = curl_easy_perform(handle);
-
-      if (result != CURLE_OK) {
-        printf("Curl error: %s\n", curl_easy_strerror(result));
-      }
-
-      json = cJSON_Parse(chunk.data);
-      free(chunk.data);
-
-      if (json) {
-        char *name_ptr[1] = { book_name };
-        save_to_cache(json, name_ptr, 0); 
-      }
-      delete_old_cache();
-      curl_free(encoded);
+    // A cached search is shown at once; a stale one is checked meanwhile
+    Revalidation* revalidation = NULL;
+    if (!load_from_cache(book_name, &books)) {
+      int found = search_gutendex(book_name, &books);
+      if (found < 0) return NULL; // Cancelled; nothing to report
+      if (found) save_to_cache(&books, book_name);
+    } else if (revalidate_due(books.fetched_at, "book_search_ttl", BOOK_SEARCH_DEFAULT_TTL)) {
+      revalidation = revalidate_gutendex(book_name, &books);
     }
 
-    cJSON* count = cJSON_GetObjectItemCaseSensitive(json, "count");
-    int count_val = count->valueint;
-    int display_count = count_val > 20 ? 20 : count_val;
-    cJSON* results = cJSON_GetObjectItemCaseSensitive(json, "results");
-
-    if (count_val == 0) {
+    if (books.count == 0 || books.n == 0) {
       clear();
       attron(COLOR_PAIR(4));
       mvprintw(0, 0, "Search result not found.");
@@ -110,40 +77,41 @@ FILE* select_main_menu(int choice, char* main_options[], int size_main_options)
       attroff(COLOR_PAIR(4));
       refresh();
       getch();
-      cJSON_Delete(json);
-      curl_easy_cleanup(handle);
+      revalidate_release(revalidation);
+      book_results_free(&books);
       return NULL;
     }
-    cJSON* result_item = results->child;
-    char *book_options[display_count];
-    for (int i = 0; i < display_count; i++) {
-      cJSON* title = cJSON_GetObjectItemCaseSensitive(result_item, "title");
-      book_options[i] = title->valuestring;
-      result_item = result_item->next;
-    }
 
+    MenuView view = {0};
     while (1) {
+      if (revalidation && gutendex_revalidated(&revalidation, &books)) {
+        save_to_cache(&books, book_name);
+      }
+      if (books.n == 0) break;
 
-      int book_choice = display_menu(book_options, display_count);
+      int book_choice = display_live_menu(books.titles, books.n, &view, revalidation);
 
+      if (book_choice == MENU_UPDATED) {
+        continue;
+      }
       if (book_choice == -1) {
         break;
       }
 
-      FILE* cached_book = in_Library(book_options[book_choice]);
+      FILE* cached_book = in_Library(books.titles[book_choice]);
 
       if (cached_book == NULL) {
-        cached_book = download_book(results, book_choice, book_options);
+        cached_book = download_book(books.urls[book_choice], books.titles[book_choice]);
       }
 
       if (cached_book) {
-        display_book(cached_book, book_options[book_choice]);
+        display_book(cached_book, books.titles[book_choice]);
         fclose(cached_book);
       }
     }
 
-    cJSON_Delete(json);
-    curl_easy_cleanup(handle);
+    revalidate_release(revalidation);
+    book_results_free(&books);
     return NULL;
   }
   if(choice == 1){ 
@@ -151,14 +119,22 @@ FILE* select_main_menu(int choice, char* main_options[], int size_main_options)
     return NULL;
   }
   if(choice == 2){
+    search_library();
+    return NULL;
+  }
+  if(choice == 3){
     search_webnovel(); 
     return NULL;
   }
-  if(choice == 3){ 
+  if(choice == 4){ 
     show_history_menu();
     return NULL;
   }
-  if(choice == 4){ 
+  if(choice == 5){ 
+    show_stats_screen();
+    return NULL;
+  }
+  if(choice == 6){ 
     endwin(); 
     exit(0); 
   }
@@ -0,0 +1,10 @@
+#ifndef CRC32_H
+#define CRC32_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// CRC-32 (IEEE, as in zlib) used to validate on-disk journal records
+uint32_t crc32(const void* data, size_t len);
+
+#endif
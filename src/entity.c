@@ -0,0 +1,112 @@
+#define ENTITY_TABLE_IMPL
+#include "entity.h"
+
+#include <string.h>
+
+// What browsers show for &#128; .. &#159;, 0 where the byte is unassigned
+static const uint16_t windows_1252[32] = {
+  0x20AC, 0, 0x201A, 0x0192, 0x201E, 0x2026, 0x2020, 0x2021,
+  0x02C6, 0x2030, 0x0160, 0x2039, 0x0152, 0, 0x017D, 0,
+  0, 0x2018, 0x2019, 0x201C, 0x201D, 0x2022, 0x2013, 0x2014,
+  0x02DC, 0x2122, 0x0161, 0x203A, 0x0153, 0, 0x017E, 0x0178
+};
+
+static uint32_t fnv1a(const char* s, size_t len, uint32_t seed) {
+  uint32_t h = 2166136261u ^ seed;
+  for (size_t i = 0; i < len; i++) {
+    h ^= (unsigned char)s[i];
+    h *= 16777619u;
+  }
+  return h;
+}
+
+size_t utf8_encode(uint32_t cp, char out[4]) {
+  if (cp < 0x80) {
+    out[0] = (char)cp;
+    return 1;
+  }
+  if (cp < 0x800) {
+    out[0] = (char)(0xC0 | (cp >> 6));
+    out[1] = (char)(0x80 | (cp & 0x3F));
+    return 2;
+  }
+  if (cp < 0x10000) {
+    out[0] = (char)(0xE0 | (cp >> 12));
+    out[1] = (char)(0x80 | ((cp >> 6) & 0x3F));
+    out[2] = (char)(0x80 | (cp & 0x3F));
+    return 3;
+  }
+  out[0] = (char)(0xF0 | (cp >> 18));
+  out[1] = (char)(0x80 | ((cp >> 12) & 0x3F));
+  out[2] = (char)(0x80 | ((cp >> 6) & 0x3F));
+  out[3] = (char)(0x80 | (cp & 0x3F));
+  return 4;
+}
+
+static size_t decode_numeric(const char* src, size_t len, char out[ENTITY_OUT_MAX], size_t* out_len) {
+  size_t i = 2; // Past "&#"
+  int hex = (i < len && (src[i] == 'x' || src[i] == 'X'));
+  if (hex) i++;
+
+  size_t digits_start = i;
+  uint32_t cp = 0;
+  for (; i < len; i++) {
+    char c = src[i];
+    int digit;
+    if (c >= '0' && c <= '9') digit = c - '0';
+    else if (hex && c >= 'a' && c <= 'f') digit = c - 'a' + 10;
+    else if (hex && c >= 'A' && c <= 'F') digit = c - 'A' + 10;
+    else break;
+    if (cp <= 0x10FFFF) cp = cp * (hex ? 16 : 10) + digit;
+  }
+  if (i == digits_start || i >= len || src[i] != ';') return 0;
+
+  if (cp >= 0x80 && cp <= 0x9F && windows_1252[cp - 0x80]) cp = windows_1252[cp - 0x80];
+  else if (cp == 0 || cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF)) cp = 0xFFFD;
+
+  *out_len = utf8_encode(cp, out);
+  return i + 1;
+}
+
+size_t entity_decode(const char* src, size_t len, char out[ENTITY_OUT_MAX], size_t* out_len) {
+  if (len < 3 || src[0] != '&') return 0;
+  if (src[1] == '#') return decode_numeric(src, len, out, out_len);
+
+  const char* semi = memchr(src + 1, ';', len - 1 < ENTITY_NAME_MAX + 1 ? len - 1 : ENTITY_NAME_MAX + 1);
+  if (!semi) return 0;
+
+  // One probe: the bucket's displacement picks a collision-free slot
+  const char* name = src + 1;
+  size_t name_len = semi - name;
+  uint32_t bucket = fnv1a(name, name_len, 0) % ENTITY_BUCKETS;
+  uint32_t slot = fnv1a(name, name_len, entity_displacement[bucket]) % ENTITY_SLOTS;
+
+  const EntitySlot* entry = &entity_slots[slot];
+  if (!entry->name || strncmp(entry->name, name, name_len) != 0 || entry->name[name_len] != '\0') return 0;
+
+  *out_len = strlen(entry->utf8);
+  memcpy(out, entry->utf8, *out_len);
+  return name_len + 2;
+}
+
+size_t entity_decode_text(char* dest, size_t dest_size, const char* src, size_t len) {
+  if (dest_size == 0) return 0;
+
+  size_t written = 0;
+  size_t i = 0;
+  while (i < len) {
+    char decoded[ENTITY_OUT_MAX];
+    size_t decoded_len = 0;
+    size_t used = (src[i] == '&') ? entity_decode(src + i, len - i, decoded, &decoded_len) : 0;
+
+    const char* piece = used ? decoded : src + i;
+    size_t piece_len = used ? decoded_len : 1;
+    if (written + piece_len >= dest_size) break;
+
+    memcpy(dest + written, piece, piece_len);
+    written += piece_len;
+    i += used ? used : 1;
+  }
+  dest[written] = '\0';
+  return written;
+}
@@ -0,0 +1,29 @@
+#ifndef ENTITY_H
+#define ENTITY_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "entity_table.h"
+
+// Room for one decoded reference: a numeric one is at most 4 UTF-8 bytes
+#define ENTITY_OUT_MAX (ENTITY_UTF8_MAX > 4 ? ENTITY_UTF8_MAX : 4)
+
+// Longest reference worth buffering: '&' + name + ';'
+#define ENTITY_REF_MAX (ENTITY_NAME_MAX + 2)
+
+/**
+ * Decodes the character reference at src[0] == '&' (named, &#NNN; or
+ * &#xHHH;) into UTF-8. Returns the number of source bytes consumed, or 0
+ * if src doesn't start with a complete, known reference. Numeric references
+ * follow the HTML5 rules: C1 controls are read as Windows-1252, invalid
+ * code points become U+FFFD.
+ */
+size_t entity_decode(const char* src, size_t len, char out[ENTITY_OUT_MAX], size_t* out_len);
+
+// Copies src[0..len) into dest decoding every reference; returns the length written
+size_t entity_decode_text(char* dest, size_t dest_size, const char* src, size_t len);
+
+size_t utf8_encode(uint32_t cp, char out[4]);
+
+#endif
@@ -0,0 +1,2730 @@
+// Generated by scripts/gen_entities.py from the HTML5 entity list. Do not edit.
+#ifndef ENTITY_TABLE_H
+#define ENTITY_TABLE_H
+
+#include <stdint.h>
+
+#define ENTITY_COUNT 2125
+#define ENTITY_NAME_MAX 31 // Longest name, without & and ;
+#define ENTITY_UTF8_MAX 6 // Longest UTF-8 expansion
+#define ENTITY_BUCKETS 532
+#define ENTITY_SLOTS 2656
+
+// Only entity.c needs the tables; everyone else just wants the limits
+#ifdef ENTITY_TABLE_IMPL
+
+typedef struct {
+  const char* name;
+  const char* utf8;
+} EntitySlot;
+
+static const uint16_t entity_displacement[ENTITY_BUCKETS] = {
+  68, 12, 27, 4, 39, 7, 5, 29, 3, 7, 12, 2,
+  17, 21, 3, 14, 5, 62, 2, 13, 3, 15, 14, 2,
+  1, 65, 7, 8, 1, 8, 19, 1, 69, 9, 8, 17,
+  57, 11, 9, 5, 2, 29, 6, 23, 19, 74, 0, 13,
+  2, 22, 17, 2, 1, 11, 11, 1, 5, 1, 16, 11,
+  3, 66, 52, 5, 23, 10, 18, 17, 5, 3, 7, 10,
+  0, 27, 3, 16, 41, 2, 45, 26, 1, 7, 1, 1,
+  1, 24, 3, 38, 13, 1, 7, 22, 19, 1, 3, 3,
+  2, 0, 2, 9, 10, 6, 36, 8, 3, 18, 12, 1,
+  2, 59, 57, 3, 3, 14, 19, 39, 22, 3, 6, 4,
+  117, 9, 6, 39, 16, 72, 14, 0, 11, 1, 68, 5,
+  2, 7, 24, 13, 8, 10, 62, 2, 16, 2, 8, 11,
+  72, 7, 15, 12, 20, 26, 8, 3, 46, 15, 10, 2,
+  3, 90, 4, 24, 17, 45, 1, 4, 128, 14, 6, 1,
+  17, 25, 7, 1, 1, 8, 12, 5, 4, 2, 1, 11,
+  4, 20, 11, 6, 11, 58, 11, 14, 36, 22, 1, 22,
+  19, 3, 32, 2, 1, 8, 11, 22, 32, 1, 29, 3,
+  3, 5, 8, 1, 9, 20, 7, 41, 62, 3, 1, 3,
+  35, 2, 2, 47, 3, 4, 5, 7, 25, 1, 38, 10,
+  22, 2, 9, 1, 8, 9, 40, 1, 4, 5, 1, 7,
+  14, 1, 4, 10, 1, 1, 69, 2, 6, 3, 8, 105,
+  1, 43, 118, 16, 20, 49, 18, 1, 18, 9, 6, 26,
+  4, 16, 21, 39, 1, 1, 67, 33, 66, 1, 2, 15,
+  88, 4, 1, 17, 8, 2, 3, 86, 4, 27, 1, 15,
+  13, 11, 94, 8, 11, 1, 36, 25, 5, 1, 1, 57,
+  1, 36, 121, 1, 25, 0, 1, 28, 2, 6, 61, 89,
+  65, 57, 41, 5, 78, 3, 12, 163, 5, 1, 81, 24,
+  54, 97, 12, 4, 131, 59, 15, 54, 36, 33, 1, 15,
+  99, 4, 7, 4, 11, 76, 18, 12, 7, 7, 6, 10,
+  146, 8, 9, 69, 39, 74, 80, 51, 10, 13, 26, 37,
+  31, 6, 24, 3, 1, 4, 1, 48, 49, 9, 50, 37,
+  2, 0, 26, 74, 59, 46, 12, 32, 137, 70, 5, 7,
+  33, 4, 22, 1, 65, 81, 2, 14, 1, 4, 63, 13,
+  11, 8, 2, 58, 3, 115, 3, 2, 67, 6, 30, 20,
+  6, 21, 1, 53, 8, 17, 1, 1, 73, 9, 10, 3,
+  31, 1, 5, 19, 19, 5, 1, 8, 1, 1, 16, 18,
+  28, 14, 118, 2, 18, 3, 15, 15, 40, 16, 1, 12,
+  28, 91, 130, 128, 2, 1, 2, 63, 24, 68, 1, 1,
+  103, 18, 5, 2, 163, 24, 1, 45, 10, 5, 8, 5,
+  27, 4, 61, 101, 7, 49, 7, 74, 7, 9, 101, 10,
+  5, 39, 16, 1, 70, 3, 2, 26, 54, 11, 7, 18,
+  4, 0, 20, 50, 22, 84, 14, 50, 92, 3, 46, 76,
+  165, 6, 3, 2, 25, 1, 22, 28, 6, 15, 8, 3,
+  16, 25, 43, 77, 1, 5, 0, 34, 153, 13, 63, 4,
+  7, 75, 2, 26,
+};
+
+static const EntitySlot entity_slots[ENTITY_SLOTS] = {
+  { "reals", "\342\204\235" },
+  { "intercal", "\342\212\272" },
+  { "twixt", "\342\211\254" },
+  { "bprime", "\342\200\265" },
+  { "gesl", "\342\213\233\357\270\200" },
+  { "yicy", "\321\227" },
+  { "ncap", "\342\251\203" },
+  { "oint", "\342\210\256" },
+  { "simdot", "\342\251\252" },
+  { "simlE", "\342\252\237" },
+  { "frac14", "\302\274" },
+  { 0, 0 },
+  { "NotRightTriangleBar", "\342\247\220\314\270" },
+  { 0, 0 },
+  { "Proportion", "\342\210\267" },
+  { 0, 0 },
+  { "GreaterGreater", "\342\252\242" },
+  { "thkap", "\342\211\210" },
+  { "bigwedge", "\342\213\200" },
+  { "LessEqualGreater", "\342\213\232" },
+  { "larrfs", "\342\244\235" },
+  { "capand", "\342\251\204" },
+  { 0, 0 },
+  { "boxVR", "\342\225\240" },
+  { "precsim", "\342\211\276" },
+  { "RightUpVectorBar", "\342\245\224" },
+  { "topbot", "\342\214\266" },
+  { "vBarv", "\342\253\251" },
+  { "boxHd", "\342\225\244" },
+  { "langd", "\342\246\221" },
+  { "downharpoonright", "\342\207\202" },
+  { "boxH", "\342\225\220" },
+  { "comp", "\342\210\201" },
+  { "vscr", "\360\235\223\213" },
+  { "notniva", "\342\210\214" },
+  { "Ncedil", "\305\205" },
+  { "lates", "\342\252\255\357\270\200" },
+  { "bernou", "\342\204\254" },
+  { 0, 0 },
+  { 0, 0 },
+  { "jsercy", "\321\230" },
+  { 0, 0 },
+  { 0, 0 },
+  { 0, 0 },
+  { "elinters", "\342\217\247" },
+  { "mid", "\342\210\243" },
+  { "NotTildeEqual", "\342\211\204" },
+  { "DownRightVector", "\342\207\201" },
+  { "nhpar", "\342\253\262" },
+  { "ohm", "\316\251" },
+  { "CircleDot", "\342\212\231" },
+  { "frac23", "\342\205\224" },
+  { "jopf", "\360\235\225\233" },
+  { "propto", "\342\210\235" },
+  { "trianglelefteq", "\342\212\264" },
+  { 0, 0 },
+  { "spadesuit", "\342\231\240" },
+  { "yucy", "\321\216" },
+  { 0, 0 },
+  { "tshcy", "\321\233" },
+  { "uhblk", "\342\226\200" },
+  { "qint", "\342\250\214" },
+  { "Bopf", "\360\235\224\271" },
+  { "bigcup", "\342\213\203" },
+  { "nges", "\342\251\276\314\270" },
+  { "epar", "\342\213\225" },
+  { "iopf", "\360\235\225\232" },
+  { "qscr", "\360\235\223\206" },
+  { 0, 0 },
+  { "NegativeThickSpace", "\342\200\213" },
+  { 0, 0 },
+  { "gtcir", "\342\251\272" },
+  { "Iogon", "\304\256" },
+  { "wscr", "\360\235\223\214" },
+  { "angst", "\303\205" },
+  { "nvrArr", "\342\244\203" },
+  { "SHCHcy", "\320\251" },
+  { "multimap", "\342\212\270" },
+  { "rightharpoondown", "\342\207\201" },
+  { "Edot", "\304\226" },
+  { "kappa", "\316\272" },
+  { "zopf", "\360\235\225\253" },
+  { "DoubleLeftArrow", "\342\207\220" },
+  { "mumap", "\342\212\270" },
+  { "lbrke", "\342\246\213" },
+  { "llarr", "\342\207\207" },
+  { "rcy", "\321\200" },
+  { "approxeq", "\342\211\212" },
+  { "Xi", "\316\236" },
+  { "NotSupersetEqual", "\342\212\211" },
+  { "gnE", "\342\211\251" },
+  { "dbkarow", "\342\244\217" },
+  { "ufr", "\360\235\224\262" },
+  { "lowbar", "_" },
+  { "xsqcup", "\342\250\206" },
+  { "RightCeiling", "\342\214\211" },
+  { "gt", ">" },
+  { "mscr", "\360\235\223\202" },
+  { "gcirc", "\304\235" },
+  { "prnap", "\342\252\271" },
+  { "nGg", "\342\213\231\314\270" },
+  { 0, 0 },
+  { "GT", ">" },
+  { "Hat", "^" },
+  { "planckh", "\342\204\216" },
+  { 0, 0 },
+  { "supseteq", "\342\212\207" },
+  { 0, 0 },
+  { "pluse", "\342\251\262" },
+  { "RuleDelayed", "\342\247\264" },
+  { "verbar", "|" },
+  { "iukcy", "\321\226" },
+  { "searrow", "\342\206\230" },
+  { "Alpha", "\316\221" },
+  { "nis", "\342\213\274" },
+  { "ngE", "\342\211\247\314\270" },
+  { "NotTilde", "\342\211\201" },
+  { "rharul", "\342\245\254" },
+  { "RightArrow", "\342\206\222" },
+  { 0, 0 },
+  { "angmsdad", "\342\246\253" },
+  { "angzarr", "\342\215\274" },
+  { "napprox", "\342\211\211" },
+  { "Precedes", "\342\211\272" },
+  { "triminus", "\342\250\272" },
+  { "IJlig", "\304\262" },
+  { "nbump", "\342\211\216\314\270" },
+  { "ldrdhar", "\342\245\247" },
+  { 0, 0 },
+  { "hercon", "\342\212\271" },
+  { "Jfr", "\360\235\224\215" },
+  { 0, 0 },
+  { "tdot", "\342\203\233" },
+  { "setmn", "\342\210\226" },
+  { "top", "\342\212\244" },
+  { 0, 0 },
+  { "awint", "\342\250\221" },
+  { "NotReverseElement", "\342\210\214" },
+  { "PrecedesSlantEqual", "\342\211\274" },
+  { 0, 0 },
+  { "larr", "\342\206\220" },
+  { "xopf", "\360\235\225\251" },
+  { "nLl", "\342\213\230\314\270" },
+  { "swnwar", "\342\244\252" },
+  { 0, 0 },
+  { "Eacute", "\303\211" },
+  { "drbkarow", "\342\244\220" },
+  { "yfr", "\360\235\224\266" },
+  { "lvertneqq", "\342\211\250\357\270\200" },
+  { 0, 0 },
+  { "andv", "\342\251\232" },
+  { 0, 0 },
+  { "ccaps", "\342\251\215" },
+  { "And", "\342\251\223" },
+  { "Gcirc", "\304\234" },
+  { 0, 0 },
+  { "MinusPlus", "\342\210\223" },
+  { "ecolon", "\342\211\225" },
+  { 0, 0 },
+  { "subE", "\342\253\205" },
+  { 0, 0 },
+  { 0, 0 },
+  { "rsquo", "\342\200\231" },
+  { "oror", "\342\251\226" },
+  { "downarrow", "\342\206\223" },
+  { "frac13", "\342\205\223" },
+  { "Psi", "\316\250" },
+  { 0, 0 },
+  { 0, 0 },
+  { "rhov", "\317\261" },
+  { "mp", "\342\210\223" },
+  { 0, 0 },
+  { "Scirc", "\305\234" },
+  { "mldr", "\342\200\246" },
+  { "looparrowleft", "\342\206\253" },
+  { "wcirc", "\305\265" },
+  { "lfisht", "\342\245\274" },
+  { "nleftarrow", "\342\206\232" },
+  { 0, 0 },
+  { "andd", "\342\251\234" },
+  { 0, 0 },
+  { 0, 0 },
+  { "hkswarow", "\342\244\246" },
+  { "frac34", "\302\276" },
+  { "ccupssm", "\342\251\220" },
+  { "lfr", "\360\235\224\251" },
+  { "lobrk", "\342\237\246" },
+  { "bcong", "\342\211\214" },
+  { "upharpoonleft", "\342\206\277" },
+  { "rarrap", "\342\245\265" },
+  { "auml", "\303\244" },
+  { "hslash", "\342\204\217" },
+  { "Dfr", "\360\235\224\207" },
+  { "Vfr", "\360\235\224\231" },
+  { 0, 0 },
+  { "swarr", "\342\206\231" },
+  { "NotHumpEqual", "\342\211\217\314\270" },
+  { "sscr", "\360\235\223\210" },
+  { 0, 0 },
+  { 0, 0 },
+  { "plusdu", "\342\250\245" },
+  { "sccue", "\342\211\275" },
+  { "napid", "\342\211\213\314\270" },
+  { "apid", "\342\211\213" },
+  { "Cayleys", "\342\204\255" },
+  { "vltri", "\342\212\262" },
+  { "NotSubsetEqual", "\342\212\210" },
+  { 0, 0 },
+  { "NonBreakingSpace", "\302\240" },
+  { "ycirc", "\305\267" },
+  { "vee", "\342\210\250" },
+  { "gneq", "\342\252\210" },
+  { "khcy", "\321\205" },
+  { "tstrok", "\305\247" },
+  { 0, 0 },
+  { "supsup", "\342\253\226" },
+  { "questeq", "\342\211\237" },
+  { "succapprox", "\342\252\270" },
+  { "sigma", "\317\203" },
+  { 0, 0 },
+  { "ltrie", "\342\212\264" },
+  { "frac58", "\342\205\235" },
+  { "aleph", "\342\204\265" },
+  { "alefsym", "\342\204\265" },
+  { "rightharpoonup", "\342\207\200" },
+  { "equivDD", "\342\251\270" },
+  { "Oscr", "\360\235\222\252" },
+  { "RightTee", "\342\212\242" },
+  { "dtrif", "\342\226\276" },
+  { 0, 0 },
+  { "cdot", "\304\213" },
+  { "lsaquo", "\342\200\271" },
+  { 0, 0 },
+  { 0, 0 },
+  { "odblac", "\305\221" },
+  { "rarrlp", "\342\206\254" },
+  { "isinv", "\342\210\210" },
+  { "OElig", "\305\222" },
+  { "rang", "\342\237\251" },
+  { "ngeqslant", "\342\251\276\314\270" },
+  { 0, 0 },
+  { "hksearow", "\342\244\245" },
+  { "xfr", "\360\235\224\265" },
+  { "bemptyv", "\342\246\260" },
+  { 0, 0 },
+  { "becaus", "\342\210\265" },
+  { "oline", "\342\200\276" },
+  { "succnsim", "\342\213\251" },
+  { "lowast", "\342\210\227" },
+  { "VerticalBar", "\342\210\243" },
+  { "ecaron", "\304\233" },
+  { "sqsupset", "\342\212\220" },
+  { "jcy", "\320\271" },
+  { "thetav", "\317\221" },
+  { "DownArrowUpArrow", "\342\207\265" },
+  { "Mfr", "\360\235\224\220" },
+  { 0, 0 },
+  { "diamond", "\342\213\204" },
+  { "topf", "\360\235\225\245" },
+  { "frac38", "\342\205\234" },
+  { "DownLeftVector", "\342\206\275" },
+  { "loz", "\342\227\212" },
+  { "Ofr", "\360\235\224\222" },
+  { "prap", "\342\252\267" },
+  { "nwnear", "\342\244\247" },
+  { 0, 0 },
+  { "nearrow", "\342\206\227" },
+  { "circledast", "\342\212\233" },
+  { "sqcap", "\342\212\223" },
+  { "nsc", "\342\212\201" },
+  { "nfr", "\360\235\224\253" },
+  { "pi", "\317\200" },
+  { "angmsdac", "\342\246\252" },
+  { "Im", "\342\204\221" },
+  { "dash", "\342\200\220" },
+  { 0, 0 },
+  { "Darr", "\342\206\241" },
+  { 0, 0 },
+  { 0, 0 },
+  { "OverBar", "\342\200\276" },
+  { 0, 0 },
+  { "sdotb", "\342\212\241" },
+  { 0, 0 },
+  { "ldrushar", "\342\245\213" },
+  { "RightUpTeeVector", "\342\245\234" },
+  { "les", "\342\251\275" },
+  { "zcy", "\320\267" },
+  { "Vdashl", "\342\253\246" },
+  { "qopf", "\360\235\225\242" },
+  { 0, 0 },
+  { "Otilde", "\303\225" },
+  { "nrightarrow", "\342\206\233" },
+  { "rarrb", "\342\207\245" },
+  { 0, 0 },
+  { "profline", "\342\214\222" },
+  { "xodot", "\342\250\200" },
+  { "napE", "\342\251\260\314\270" },
+  { "eqslantgtr", "\342\252\226" },
+  { "pre", "\342\252\257" },
+  { "tcaron", "\305\245" },
+  { 0, 0 },
+  { 0, 0 },
+  { "die", "\302\250" },
+  { "prsim", "\342\211\276" },
+  { 0, 0 },
+  { "Lt", "\342\211\252" },
+  { "bigtriangledown", "\342\226\275" },
+  { "edot", "\304\227" },
+  { "wr", "\342\211\200" },
+  { "plankv", "\342\204\217" },
+  { "coloneq", "\342\211\224" },
+  { "bscr", "\360\235\222\267" },
+  { "TildeTilde", "\342\211\210" },
+  { "ldca", "\342\244\266" },
+  { 0, 0 },
+  { "dharr", "\342\207\202" },
+  { 0, 0 },
+  { 0, 0 },
+  { "rpar", ")" },
+  { "fllig", "\357\254\202" },
+  { "rAarr", "\342\207\233" },
+  { "thorn", "\303\276" },
+  { "wedbar", "\342\251\237" },
+  { "lparlt", "\342\246\223" },
+  { 0, 0 },
+  { "fopf", "\360\235\225\227" },
+  { 0, 0 },
+  { "Vopf", "\360\235\225\215" },
+  { "thksim", "\342\210\274" },
+  { "andand", "\342\251\225" },
+  { "cupcup", "\342\251\212" },
+  { "precapprox", "\342\252\267" },
+  { "gtcc", "\342\252\247" },
+  { "eqsim", "\342\211\202" },
+  { "UpEquilibrium", "\342\245\256" },
+  { "puncsp", "\342\200\210" },
+  { "Epsilon", "\316\225" },
+  { 0, 0 },
+  { "gne", "\342\252\210" },
+  { 0, 0 },
+  { "Egrave", "\303\210" },
+  { "ldquor", "\342\200\236" },
+  { "kjcy", "\321\234" },
+  { "Verbar", "\342\200\226" },
+  { 0, 0 },
+  { "oacute", "\303\263" },
+  { "Ropf", "\342\204\235" },
+  { "toea", "\342\244\250" },
+  { "rAtail", "\342\244\234" },
+  { "zacute", "\305\272" },
+  { "lbrace", "{" },
+  { "middot", "\302\267" },
+  { "nwArr", "\342\207\226" },
+  { "csube", "\342\253\221" },
+  { "female", "\342\231\200" },
+  { "epsiv", "\317\265" },
+  { "GreaterEqualLess", "\342\213\233" },
+  { "rbrksld", "\342\246\216" },
+  { "blk14", "\342\226\221" },
+  { "cularrp", "\342\244\275" },
+  { "rangd", "\342\246\222" },
+  { "diam", "\342\213\204" },
+  { "prod", "\342\210\217" },
+  { "Union", "\342\213\203" },
+  { "laquo", "\302\253" },
+  { "nsccue", "\342\213\241" },
+  { "csup", "\342\253\220" },
+  { "notnivb", "\342\213\276" },
+  { "nsqsube", "\342\213\242" },
+  { "eqvparsl", "\342\247\245" },
+  { "varsupsetneqq", "\342\253\214\357\270\200" },
+  { "scnE", "\342\252\266" },
+  { "Eogon", "\304\230" },
+  { "DoubleUpDownArrow", "\342\207\225" },
+  { "Lcedil", "\304\273" },
+  { "squf", "\342\226\252" },
+  { 0, 0 },
+  { "Oacute", "\303\223" },
+  { "longmapsto", "\342\237\274" },
+  { 0, 0 },
+  { "rpargt", "\342\246\224" },
+  { "rationals", "\342\204\232" },
+  { "Longrightarrow", "\342\237\271" },
+  { "target", "\342\214\226" },
+  { "boxbox", "\342\247\211" },
+  { 0, 0 },
+  { 0, 0 },
+  { 0, 0 },
+  { 0, 0 },
+  { "QUOT", "\042" },
+  { "Mu", "\316\234" },
+  { "nrArr", "\342\207\217" },
+  { "sdote", "\342\251\246" },
+  { "COPY", "\302\251" },
+  { "hscr", "\360\235\222\275" },
+  { "subdot", "\342\252\275" },
+  { "Prime", "\342\200\263" },
+  { "Ouml", "\303\226" },
+  { "boxvr", "\342\224\234" },
+  { "NotSuperset", "\342\212\203\342\203\222" },
+  { "gnapprox", "\342\252\212" },
+  { "nsupset", "\342\212\203\342\203\222" },
+  { "SquareSuperset", "\342\212\220" },
+  { "fcy", "\321\204" },
+  { "nopf", "\360\235\225\237" },
+  { 0, 0 },
+  { 0, 0 },
+  { "qfr", "\360\235\224\256" },
+  { "xoplus", "\342\250\201" },
+  { "xuplus", "\342\250\204" },
+  { "sqsube", "\342\212\221" },
+  { "Re", "\342\204\234" },
+  { "ntlg", "\342\211\270" },
+  { "equals", "=" },
+  { "lang", "\342\237\250" },
+  { 0, 0 },
+  { "Xscr", "\360\235\222\263" },
+  { "emsp", "\342\200\203" },
+  { 0, 0 },
+  { 0, 0 },
+  { "NestedLessLess", "\342\211\252" },
+  { "szlig", "\303\237" },
+  { 0, 0 },
+  { "InvisibleTimes", "\342\201\242" },
+  { "numsp", "\342\200\207" },
+  { "Bernoullis", "\342\204\254" },
+  { "mapstodown", "\342\206\247" },
+  { "lotimes", "\342\250\264" },
+  { "Sigma", "\316\243" },
+  { 0, 0 },
+  { "kgreen", "\304\270" },
+  { "lmoust", "\342\216\260" },
+  { "eDDot", "\342\251\267" },
+  { "rlarr", "\342\207\204" },
+  { "divide", "\303\267" },
+  { "sstarf", "\342\213\206" },
+  { 0, 0 },
+  { "iacute", "\303\255" },
+  { "imacr", "\304\253" },
+  { "mho", "\342\204\247" },
+  { "capcup", "\342\251\207" },
+  { "macr", "\302\257" },
+  { "midcir", "\342\253\260" },
+  { "blk34", "\342\226\223" },
+  { "Topf", "\360\235\225\213" },
+  { "lmoustache", "\342\216\260" },
+  { "supplus", "\342\253\200" },
+  { "simplus", "\342\250\244" },
+  { "acute", "\302\264" },
+  { "dollar", "$" },
+  { "succneqq", "\342\252\266" },
+  { 0, 0 },
+  { "imagline", "\342\204\220" },
+  { 0, 0 },
+  { "GreaterEqual", "\342\211\245" },
+  { "uharl", "\342\206\277" },
+  { "boxVL", "\342\225\243" },
+  { "triangle", "\342\226\265" },
+  { "Iopf", "\360\235\225\200" },
+  { "dfisht", "\342\245\277" },
+  { "gap", "\342\252\206" },
+  { "ensp", "\342\200\202" },
+  { "notinvc", "\342\213\266" },
+  { "natur", "\342\231\256" },
+  { "HARDcy", "\320\252" },
+  { "eqslantless", "\342\252\225" },
+  { 0, 0 },
+  { "backsim", "\342\210\275" },
+  { 0, 0 },
+  { 0, 0 },
+  { 0, 0 },
+  { "cent", "\302\242" },
+  { 0, 0 },
+  { "UpTeeArrow", "\342\206\245" },
+  { "dlcrop", "\342\214\215" },
+  { "vartriangleright", "\342\212\263" },
+  { "cacute", "\304\207" },
+  { "supsim", "\342\253\210" },
+  { 0, 0 },
+  { "nwarhk", "\342\244\243" },
+  { 0, 0 },
+  { "there4", "\342\210\264" },
+  { 0, 0 },
+  { "barwedge", "\342\214\205" },
+  { "vnsup", "\342\212\203\342\203\222" },
+  { "cirE", "\342\247\203" },
+  { "circleddash", "\342\212\235" },
+  { "prop", "\342\210\235" },
+  { "utilde", "\305\251" },
+  { "blacktriangledown", "\342\226\276" },
+  { "laemptyv", "\342\246\264" },
+  { "Ubrcy", "\320\216" },
+  { "lrtri", "\342\212\277" },
+  { "ngt", "\342\211\257" },
+  { "intprod", "\342\250\274" },
+  { "xmap", "\342\237\274" },
+  { "plusmn", "\302\261" },
+  { "ltri", "\342\227\203" },
+  { "nLeftarrow", "\342\207\215" },
+  { "LeftUpTeeVector", "\342\245\240" },
+  { "tfr", "\360\235\224\261" },
+  { 0, 0 },
+  { "ddarr", "\342\207\212" },
+  { 0, 0 },
+  { "Del", "\342\210\207" },
+  { "yopf", "\360\235\225\252" },
+  { "Barv", "\342\253\247" },
+  { "UnderBrace", "\342\217\237" },
+  { "lesg", "\342\213\232\357\270\200" },
+  { "minusdu", "\342\250\252" },
+  { "Vee", "\342\213\201" },
+  { "LeftDownTeeVector", "\342\245\241" },
+  { "ltlarr", "\342\245\266" },
+  { 0, 0 },
+  { "nearr", "\342\206\227" },
+  { 0, 0 },
+  { "harrw", "\342\206\255" },
+  { "Downarrow", "\342\207\223" },
+  { "Cconint", "\342\210\260" },
+  { 0, 0 },
+  { 0, 0 },
+  { "boxUl", "\342\225\234" },
+  { 0, 0 },
+  { "intlarhk", "\342\250\227" },
+  { 0, 0 },
+  { "comma", "," },
+  { "uopf", "\360\235\225\246" },
+  { "ReverseElement", "\342\210\213" },
+  { "equest", "\342\211\237" },
+  { "efr", "\360\235\224\242" },
+  { "straightphi", "\317\225" },
+  { 0, 0 },
+  { "cuepr", "\342\213\236" },
+  { "icirc", "\303\256" },
+  { "zeta", "\316\266" },
+  { "raemptyv", "\342\246\263" },
+  { "DScy", "\320\205" },
+  { 0, 0 },
+  { "Product", "\342\210\217" },
+  { 0, 0 },
+  { "iogon", "\304\257" },
+  { "ijlig", "\304\263" },
+  { 0, 0 },
+  { "succ", "\342\211\273" },
+  { "Tcy", "\320\242" },
+  { "ccaron", "\304\215" },
+  { "notinva", "\342\210\211" },
+  { "hamilt", "\342\204\213" },
+  { "varphi", "\317\225" },
+  { "LeftVector", "\342\206\274" },
+  { "malt", "\342\234\240" },
+  { 0, 0 },
+  { 0, 0 },
+  { "Aogon", "\304\204" },
+  { "gla", "\342\252\245" },
+  { "Cscr", "\360\235\222\236" },
+  { "Tcedil", "\305\242" },
+  { "hstrok", "\304\247" },
+  { "scirc", "\305\235" },
+  { 0, 0 },
+  { "Beta", "\316\222" },
+  { "nexist", "\342\210\204" },
+  { "LeftTriangleEqual", "\342\212\264" },
+  { "precneqq", "\342\252\265" },
+  { 0, 0 },
+  { 0, 0 },
+  { "NotNestedGreaterGreater", "\342\252\242\314\270" },
+  { "eacute", "\303\251" },
+  { "hearts", "\342\231\245" },
+  { "LeftArrowBar", "\342\207\244" },
+  { "larrb", "\342\207\244" },
+  { "scaron", "\305\241" },
+  { 0, 0 },
+  { "boxdL", "\342\225\225" },
+  { "notinvb", "\342\213\267" },
+  { "larrhk", "\342\206\251" },
+  { "ape", "\342\211\212" },
+  { "rightleftharpoons", "\342\207\214" },
+  { "Poincareplane", "\342\204\214" },
+  { "Proportional", "\342\210\235" },
+  { "thinsp", "\342\200\211" },
+  { 0, 0 },
+  { "LeftRightArrow", "\342\206\224" },
+  { "ruluhar", "\342\245\250" },
+  { "andslope", "\342\251\230" },
+  { 0, 0 },
+  { 0, 0 },
+  { "DownArrow", "\342\206\223" },
+  { 0, 0 },
+  { "coprod", "\342\210\220" },
+  { "smtes", "\342\252\254\357\270\200" },
+  { "period", "." },
+  { "lnap", "\342\252\211" },
+  { "tcy", "\321\202" },
+  { "Yfr", "\360\235\224\234" },
+  { "parallel", "\342\210\245" },
+  { 0, 0 },
+  { "Zeta", "\316\226" },
+  { "lsimg", "\342\252\217" },
+  { "Ncaron", "\305\207" },
+  { "lAarr", "\342\207\232" },
+  { 0, 0 },
+  { "ncongdot", "\342\251\255\314\270" },
+  { "leftarrowtail", "\342\206\242" },
+  { "Theta", "\316\230" },
+  { 0, 0 },
+  { "scnsim", "\342\213\251" },
+  { "acd", "\342\210\277" },
+  { 0, 0 },
+  { "Uscr", "\360\235\222\260" },
+  { "YUcy", "\320\256" },
+  { "NotRightTriangle", "\342\213\253" },
+  { "olarr", "\342\206\272" },
+  { "colon", ":" },
+  { "erDot", "\342\211\223" },
+  { "ic", "\342\201\243" },
+  { "vcy", "\320\262" },
+  { "nvDash", "\342\212\255" },
+  { 0, 0 },
+  { "Cfr", "\342\204\255" },
+  { "twoheadleftarrow", "\342\206\236" },
+  { "lopar", "\342\246\205" },
+  { "scpolint", "\342\250\223" },
+  { "leftrightharpoons", "\342\207\213" },
+  { "diamondsuit", "\342\231\246" },
+  { "urcorner", "\342\214\235" },
+  { "infin", "\342\210\236" },
+  { "ddotseq", "\342\251\267" },
+  { 0, 0 },
+  { "DoubleLongLeftRightArrow", "\342\237\272" },
+  { "straightepsilon", "\317\265" },
+  { 0, 0 },
+  { "Imacr", "\304\252" },
+  { "SquareSubset", "\342\212\217" },
+  { 0, 0 },
+  { 0, 0 },
+  { "Larr", "\342\206\236" },
+  { "parsl", "\342\253\275" },
+  { "Icirc", "\303\216" },
+  { "Breve", "\313\230" },
+  { "Therefore", "\342\210\264" },
+  { "Succeeds", "\342\211\273" },
+  { "supset", "\342\212\203" },
+  { "gammad", "\317\235" },
+  { "duarr", "\342\207\265" },
+  { "vzigzag", "\342\246\232" },
+  { "roang", "\342\237\255" },
+  { "bigoplus", "\342\250\201" },
+  { "Or", "\342\251\224" },
+  { "tprime", "\342\200\264" },
+  { "supdot", "\342\252\276" },
+  { "solb", "\342\247\204" },
+  { "Eta", "\316\227" },
+  { "swArr", "\342\207\231" },
+  { "lfloor", "\342\214\212" },
+  { "uplus", "\342\212\216" },
+  { "expectation", "\342\204\260" },
+  { "crarr", "\342\206\265" },
+  { "CirclePlus", "\342\212\225" },
+  { "ascr", "\360\235\222\266" },
+  { "simne", "\342\211\206" },
+  { 0, 0 },
+  { "NotLess", "\342\211\256" },
+  { "srarr", "\342\206\222" },
+  { "Lfr", "\360\235\224\217" },
+  { "NotSquareSubset", "\342\212\217\314\270" },
+  { "ltdot", "\342\213\226" },
+  { "boxDR", "\342\225\224" },
+  { "nsce", "\342\252\260\314\270" },
+  { "Ufr", "\360\235\224\230" },
+  { "nscr", "\360\235\223\203" },
+  { "veebar", "\342\212\273" },
+  { "Omega", "\316\251" },
+  { 0, 0 },
+  { "xrarr", "\342\237\266" },
+  { 0, 0 },
+  { "nesim", "\342\211\202\314\270" },
+  { "nleqslant", "\342\251\275\314\270" },
+  { "boxVh", "\342\225\253" },
+  { "integers", "\342\204\244" },
+  { 0, 0 },
+  { "Udblac", "\305\260" },
+  { "lescc", "\342\252\250" },
+  { 0, 0 },
+  { "chi", "\317\207" },
+  { "lurdshar", "\342\245\212" },
+  { 0, 0 },
+  { "ffllig", "\357\254\204" },
+  { "Element", "\342\210\210" },
+  { "Ograve", "\303\222" },
+  { "Esim", "\342\251\263" },
+  { "Qopf", "\342\204\232" },
+  { "asymp", "\342\211\210" },
+  { "nsmid", "\342\210\244" },
+  { "lHar", "\342\245\242" },
+  { "Yacute", "\303\235" },
+  { "NotGreaterSlantEqual", "\342\251\276\314\270" },
+  { "omid", "\342\246\266" },
+  { "rtrif", "\342\226\270" },
+  { 0, 0 },
+  { "uwangle", "\342\246\247" },
+  { "osol", "\342\212\230" },
+  { "siml", "\342\252\235" },
+  { "ngeq", "\342\211\261" },
+  { "nlE", "\342\211\246\314\270" },
+  { "oslash", "\303\270" },
+  { "MediumSpace", "\342\201\237" },
+  { "LeftDownVectorBar", "\342\245\231" },
+  { 0, 0 },
+  { "rlm", "\342\200\217" },
+  { "vsupnE", "\342\253\214\357\270\200" },
+  { 0, 0 },
+  { 0, 0 },
+  { 0, 0 },
+  { 0, 0 },
+  { "LeftCeiling", "\342\214\210" },
+  { "quest", "?" },
+  { "Lscr", "\342\204\222" },
+  { "DoubleLeftTee", "\342\253\244" },
+  { "zdot", "\305\274" },
+  { "xdtri", "\342\226\275" },
+  { 0, 0 },
+  { "Kfr", "\360\235\224\216" },
+  { "HilbertSpace", "\342\204\213" },
+  { "boxdl", "\342\224\220" },
+  { "realpart", "\342\204\234" },
+  { "range", "\342\246\245" },
+  { "rarrfs", "\342\244\236" },
+  { "rarrhk", "\342\206\252" },
+  { "slarr", "\342\206\220" },
+  { 0, 0 },
+  { "angsph", "\342\210\242" },
+  { "rfisht", "\342\245\275" },
+  { "ultri", "\342\227\270" },
+  { "omicron", "\316\277" },
+  { 0, 0 },
+  { "umacr", "\305\253" },
+  { "Oopf", "\360\235\225\206" },
+  { "percnt", "%" },
+  { "cap", "\342\210\251" },
+  { "xnis", "\342\213\273" },
+  { "iquest", "\302\277" },
+  { "leftarrow", "\342\206\220" },
+  { "dHar", "\342\245\245" },
+  { "DDotrahd", "\342\244\221" },
+  { 0, 0 },
+  { "bigvee", "\342\213\201" },
+  { "nsubseteq", "\342\212\210" },
+  { "olt", "\342\247\200" },
+  { 0, 0 },
+  { "congdot", "\342\251\255" },
+  { "bNot", "\342\253\255" },
+  { "ContourIntegral", "\342\210\256" },
+  { 0, 0 },
+  { "yscr", "\360\235\223\216" },
+  { 0, 0 },
+  { 0, 0 },
+  { "utdot", "\342\213\260" },
+  { 0, 0 },
+  { "fnof", "\306\222" },
+  { 0, 0 },
+  { "rArr", "\342\207\222" },
+  { 0, 0 },
+  { "capcap", "\342\251\213" },
+  { 0, 0 },
+  { "Ycirc", "\305\266" },
+  { "Rfr", "\342\204\234" },
+  { "curlyeqsucc", "\342\213\237" },
+  { "OverParenthesis", "\342\217\234" },
+  { "ReverseEquilibrium", "\342\207\213" },
+  { "cemptyv", "\342\246\262" },
+  { 0, 0 },
+  { "bnot", "\342\214\220" },
+  { "boxDL", "\342\225\227" },
+  { "AElig", "\303\206" },
+  { "int", "\342\210\253" },
+  { "Aacute", "\303\201" },
+  { "origof", "\342\212\266" },
+  { "sacute", "\305\233" },
+  { "NotSucceedsEqual", "\342\252\260\314\270" },
+  { "tbrk", "\342\216\264" },
+  { "DownArrowBar", "\342\244\223" },
+  { 0, 0 },
+  { 0, 0 },
+  { "Hscr", "\342\204\213" },
+  { "Hcirc", "\304\244" },
+  { "UpTee", "\342\212\245" },
+  { 0, 0 },
+  { "ggg", "\342\213\231" },
+  { "bne", "=\342\203\245" },
+  { "lbrkslu", "\342\246\215" },
+  { "Tcaron", "\305\244" },
+  { "nleqq", "\342\211\246\314\270" },
+  { "Uarr", "\342\206\237" },
+  { "LeftAngleBracket", "\342\237\250" },
+  { "ccups", "\342\251\214" },
+  { "trade", "\342\204\242" },
+  { "Barwed", "\342\214\206" },
+  { "NotSucceedsTilde", "\342\211\277\314\270" },
+  { 0, 0 },
+  { "CircleMinus", "\342\212\226" },
+  { "pfr", "\360\235\224\255" },
+  { "NegativeMediumSpace", "\342\200\213" },
+  { "GJcy", "\320\203" },
+  { "clubsuit", "\342\231\243" },
+  { 0, 0 },
+  { 0, 0 },
+  { "SubsetEqual", "\342\212\206" },
+  { "leftharpoonup", "\342\206\274" },
+  { "sqsubset", "\342\212\217" },
+  { "nbumpe", "\342\211\217\314\270" },
+  { 0, 0 },
+  { "rfloor", "\342\214\213" },
+  { "nrarr", "\342\206\233" },
+  { 0, 0 },
+  { "Lleftarrow", "\342\207\232" },
+  { "LessLess", "\342\252\241" },
+  { "Mellintrf", "\342\204\263" },
+  { "isin", "\342\210\210" },
+  { "supdsub", "\342\253\230" },
+  { 0, 0 },
+  { "disin", "\342\213\262" },
+  { "hfr", "\360\235\224\245" },
+  { "cudarrr", "\342\244\265" },
+  { "Hacek", "\313\207" },
+  { "bcy", "\320\261" },
+  { 0, 0 },
+  { 0, 0 },
+  { 0, 0 },
+  { "ange", "\342\246\244" },
+  { "ncedil", "\305\206" },
+  { "imagpart", "\342\204\221" },
+  { "ngeqq", "\342\211\247\314\270" },
+  { 0, 0 },
+  { "Gcedil", "\304\242" },
+  { "ubreve", "\305\255" },
+  { "gg", "\342\211\253" },
+  { "nang", "\342\210\240\342\203\222" },
+  { "cudarrl", "\342\244\270" },
+  { "simg", "\342\252\236" },
+  { 0, 0 },
+  { "ShortRightArrow", "\342\206\222" },
+  { "fflig", "\357\254\200" },
+  { "DownLeftRightVector", "\342\245\220" },
+  { "ofcir", "\342\246\277" },
+  { 0, 0 },
+  { "DoubleContourIntegral", "\342\210\257" },
+  { "bfr", "\360\235\224\237" },
+  { "subseteq", "\342\212\206" },
+  { "mstpos", "\342\210\276" },
+  { "Uparrow", "\342\207\221" },
+  { "notnivc", "\342\213\275" },
+  { "longleftrightarrow", "\342\237\267" },
+  { "because", "\342\210\265" },
+  { "copy", "\302\251" },
+  { "gtrless", "\342\211\267" },
+  { "NotExists", "\342\210\204" },
+  { "subset", "\342\212\202" },
+  { "CloseCurlyQuote", "\342\200\231" },
+  { "nlArr", "\342\207\215" },
+  { "raquo", "\302\273" },
+  { "ntriangleright", "\342\213\253" },
+  { "Rightarrow", "\342\207\222" },
+  { "nparallel", "\342\210\246" },
+  { "lsqb", "[" },
+  { "scy", "\321\201" },
+  { "uacute", "\303\272" },
+  { "uuml", "\303\274" },
+  { "copf", "\360\235\225\224" },
+  { "quatint", "\342\250\226" },
+  { "check", "\342\234\223" },
+  { "le", "\342\211\244" },
+  { 0, 0 },
+  { 0, 0 },
+  { "amp", "&" },
+  { "RightArrowLeftArrow", "\342\207\204" },
+  { "RightArrowBar", "\342\207\245" },
+  { "mnplus", "\342\210\223" },
+  { "Delta", "\316\224" },
+  { "ap", "\342\211\210" },
+  { "seArr", "\342\207\230" },
+  { 0, 0 },
+  { "late", "\342\252\255" },
+  { "prime", "\342\200\262" },
+  { 0, 0 },
+  { "ltcir", "\342\251\271" },
+  { "frac15", "\342\205\225" },
+  { "zwj", "\342\200\215" },
+  { 0, 0 },
+  { "ocy", "\320\276" },
+  { "odash", "\342\212\235" },
+  { "Iukcy", "\320\206" },
+  { "DownTee", "\342\212\244" },
+  { "divonx", "\342\213\207" },
+  { 0, 0 },
+  { "glj", "\342\252\244" },
+  { "Uarrocir", "\342\245\211" },
+  { "nLeftrightarrow", "\342\207\216" },
+  { 0, 0 },
+  { 0, 0 },
+  { "xotime", "\342\250\202" },
+  { "vdash", "\342\212\242" },
+  { "Nscr", "\360\235\222\251" },
+  { "nless", "\342\211\256" },
+  { "apos", "'" },
+  { "wp", "\342\204\230" },
+  { "nshortparallel", "\342\210\246" },
+  { "ocir", "\342\212\232" },
+  { "luruhar", "\342\245\246" },
+  { "Gfr", "\360\235\224\212" },
+  { "bigcirc", "\342\227\257" },
+  { "olcross", "\342\246\273" },
+  { 0, 0 },
+  { "NotSquareSupersetEqual", "\342\213\243" },
+  { 0, 0 },
+  { "bsim", "\342\210\275" },
+  { "demptyv", "\342\246\261" },
+  { "rbbrk", "\342\235\263" },
+  { 0, 0 },
+  { "boxVl", "\342\225\242" },
+  { 0, 0 },
+  { "DownRightTeeVector", "\342\245\237" },
+  { 0, 0 },
+  { "nsubE", "\342\253\205\314\270" },
+  { "nRightarrow", "\342\207\217" },
+  { "lBarr", "\342\244\216" },
+  { "ShortUpArrow", "\342\206\221" },
+  { "iff", "\342\207\224" },
+  { "iiiint", "\342\250\214" },
+  { 0, 0 },
+  { 0, 0 },
+  { "Ifr", "\342\204\221" },
+  { "atilde", "\303\243" },
+  { "flat", "\342\231\255" },
+  { "searhk", "\342\244\245" },
+  { 0, 0 },
+  { "bumpeq", "\342\211\217" },
+  { "dd", "\342\205\206" },
+  { "ffr", "\360\235\224\243" },
+  { 0, 0 },
+  { "Fcy", "\320\244" },
+  { 0, 0 },
+  { "shcy", "\321\210" },
+  { 0, 0 },
+  { "NewLine", "\012" },
+  { "gtrdot", "\342\213\227" },
+  { "dscr", "\360\235\222\271" },
+  { "suplarr", "\342\245\273" },
+  { "VerticalLine", "|" },
+  { "TScy", "\320\246" },
+  { "doteq", "\342\211\220" },
+  { "upsih", "\317\222" },
+  { "Rscr", "\342\204\233" },
+  { "xvee", "\342\213\201" },
+  { "Because", "\342\210\265" },
+  { "rarrsim", "\342\245\264" },
+  { "DoubleLeftRightArrow", "\342\207\224" },
+  { "Rrightarrow", "\342\207\233" },
+  { "varepsilon", "\317\265" },
+  { "icy", "\320\270" },
+  { "LeftUpVector", "\342\206\277" },
+  { "Zdot", "\305\273" },
+  { "times", "\303\227" },
+  { "Pscr", "\360\235\222\253" },
+  { "sce", "\342\252\260" },
+  { "par", "\342\210\245" },
+  { 0, 0 },
+  { "Vscr", "\360\235\222\261" },
+  { "asympeq", "\342\211\215" },
+  { "rho", "\317\201" },
+  { "pluscir", "\342\250\242" },
+  { "DD", "\342\205\205" },
+  { "roplus", "\342\250\256" },
+  { "Nu", "\316\235" },
+  { 0, 0 },
+  { "loarr", "\342\207\275" },
+  { "sdot", "\342\213\205" },
+  { "larrsim", "\342\245\263" },
+  { 0, 0 },
+  { "NotGreaterGreater", "\342\211\253\314\270" },
+  { 0, 0 },
+  { "awconint", "\342\210\263" },
+  { 0, 0 },
+  { 0, 0 },
+  { "risingdotseq", "\342\211\223" },
+  { "EmptySmallSquare", "\342\227\273" },
+  { "ShortLeftArrow", "\342\206\220" },
+  { "gesles", "\342\252\224" },
+  { "suphsub", "\342\253\227" },
+  { "Jsercy", "\320\210" },
+  { "ratio", "\342\210\266" },
+  { 0, 0 },
+  { "gesdot", "\342\252\200" },
+  { "lesssim", "\342\211\262" },
+  { 0, 0 },
+  { "blk12", "\342\226\222" },
+  { "rightarrow", "\342\206\222" },
+  { "checkmark", "\342\234\223" },
+  { "LeftArrow", "\342\206\220" },
+  { "cylcty", "\342\214\255" },
+  { "nsupseteq", "\342\212\211" },
+  { 0, 0 },
+  { "sup", "\342\212\203" },
+  { "HumpDownHump", "\342\211\216" },
+  { "njcy", "\321\232" },
+  { "vDash", "\342\212\250" },
+  { 0, 0 },
+  { "gscr", "\342\204\212" },
+  { "NestedGreaterGreater", "\342\211\253" },
+  { 0, 0 },
+  { "Diamond", "\342\213\204" },
+  { "xhArr", "\342\237\272" },
+  { "emsp13", "\342\200\204" },
+  { "bottom", "\342\212\245" },
+  { 0, 0 },
+  { "nGt", "\342\211\253\342\203\222" },
+  { 0, 0 },
+  { "oscr", "\342\204\264" },
+  { "SquareIntersection", "\342\212\223" },
+  { "nspar", "\342\210\246" },
+  { "dagger", "\342\200\240" },
+  { 0, 0 },
+  { 0, 0 },
+  { 0, 0 },
+  { 0, 0 },
+  { "RBarr", "\342\244\220" },
+  { "uArr", "\342\207\221" },
+  { "kscr", "\360\235\223\200" },
+  { "phone", "\342\230\216" },
+  { 0, 0 },
+  { "Ccirc", "\304\210" },
+  { 0, 0 },
+  { "NotSquareSubsetEqual", "\342\213\242" },
+  { "subrarr", "\342\245\271" },
+  { "minusb", "\342\212\237" },
+  { "longleftarrow", "\342\237\265" },
+  { "backsimeq", "\342\213\215" },
+  { 0, 0 },
+  { "RightDoubleBracket", "\342\237\247" },
+  { "Cap", "\342\213\222" },
+  { "ApplyFunction", "\342\201\241" },
+  { "para", "\302\266" },
+  { "aopf", "\360\235\225\222" },
+  { "sup1", "\302\271" },
+  { "Scy", "\320\241" },
+  { "vfr", "\360\235\224\263" },
+  { "rdsh", "\342\206\263" },
+  { "sum", "\342\210\221" },
+  { "csub", "\342\253\217" },
+  { "IEcy", "\320\225" },
+  { "downdownarrows", "\342\207\212" },
+  { "caron", "\313\207" },
+  { "updownarrow", "\342\206\225" },
+  { 0, 0 },
+  { "popf", "\360\235\225\241" },
+  { "smile", "\342\214\243" },
+  { "tscr", "\360\235\223\211" },
+  { 0, 0 },
+  { "sup3", "\302\263" },
+  { 0, 0 },
+  { "xharr", "\342\237\267" },
+  { "Congruent", "\342\211\241" },
+  { "InvisibleComma", "\342\201\243" },
+  { 0, 0 },
+  { "eng", "\305\213" },
+  { "angmsdah", "\342\246\257" },
+  { 0, 0 },
+  { "dot", "\313\231" },
+  { "vBar", "\342\253\250" },
+  { "Sc", "\342\252\274" },
+  { "Acy", "\320\220" },
+  { "Wcirc", "\305\264" },
+  { "precnapprox", "\342\252\271" },
+  { "iota", "\316\271" },
+  { "qprime", "\342\201\227" },
+  { 0, 0 },
+  { "EmptyVerySmallSquare", "\342\226\253" },
+  { "zhcy", "\320\266" },
+  { 0, 0 },
+  { "nlarr", "\342\206\232" },
+  { "Ecirc", "\303\212" },
+  { "escr", "\342\204\257" },
+  { "ExponentialE", "\342\205\207" },
+  { "robrk", "\342\237\247" },
+  { "complexes", "\342\204\202" },
+  { "NotGreaterEqual", "\342\211\261" },
+  { "starf", "\342\230\205" },
+  { "grave", "`" },
+  { "urtri", "\342\227\271" },
+  { "YIcy", "\320\207" },
+  { 0, 0 },
+  { "gescc", "\342\252\251" },
+  { "sub", "\342\212\202" },
+  { "rcedil", "\305\227" },
+  { "emptyset", "\342\210\205" },
+  { "sect", "\302\247" },
+  { "downharpoonleft", "\342\207\203" },
+  { "shortparallel", "\342\210\245" },
+  { "Phi", "\316\246" },
+  { 0, 0 },
+  { "sqcups", "\342\212\224\357\270\200" },
+  { "fallingdotseq", "\342\211\222" },
+  { "Exists", "\342\210\203" },
+  { "nbsp", "\302\240" },
+  { "Colone", "\342\251\264" },
+  { 0, 0 },
+  { "Assign", "\342\211\224" },
+  { "bigodot", "\342\250\200" },
+  { "Upsi", "\317\222" },
+  { 0, 0 },
+  { "mopf", "\360\235\225\236" },
+  { 0, 0 },
+  { "geqslant", "\342\251\276" },
+  { 0, 0 },
+  { "rsqb", "]" },
+  { "nsime", "\342\211\204" },
+  { "vsubnE", "\342\253\213\357\270\200" },
+  { "hbar", "\342\204\217" },
+  { "mcomma", "\342\250\251" },
+  { "lneqq", "\342\211\250" },
+  { "order", "\342\204\264" },
+  { "supsub", "\342\253\224" },
+  { "efDot", "\342\211\222" },
+  { "sqsupseteq", "\342\212\222" },
+  { "ntgl", "\342\211\271" },
+  { 0, 0 },
+  { "Ugrave", "\303\231" },
+  { 0, 0 },
+  { "Upsilon", "\316\245" },
+  { "hyphen", "\342\200\220" },
+  { "rthree", "\342\213\214" },
+  { "smid", "\342\210\243" },
+  { 0, 0 },
+  { "NotTildeTilde", "\342\211\211" },
+  { "subplus", "\342\252\277" },
+  { "gsime", "\342\252\216" },
+  { "Rcy", "\320\240" },
+  { "LeftFloor", "\342\214\212" },
+  { "triplus", "\342\250\271" },
+  { "gesdoto", "\342\252\202" },
+  { "parsim", "\342\253\263" },
+  { "DZcy", "\320\217" },
+  { "NotEqual", "\342\211\240" },
+  { 0, 0 },
+  { "ccedil", "\303\247" },
+  { 0, 0 },
+  { "Lcy", "\320\233" },
+  { 0, 0 },
+  { "Vvdash", "\342\212\252" },
+  { "supsetneq", "\342\212\213" },
+  { "pitchfork", "\342\213\224" },
+  { "lE", "\342\211\246" },
+  { "Cedilla", "\302\270" },
+  { "ne", "\342\211\240" },
+  { "equiv", "\342\211\241" },
+  { "rarrw", "\342\206\235" },
+  { "Otimes", "\342\250\267" },
+  { "angmsdaa", "\342\246\250" },
+  { "rtrie", "\342\212\265" },
+  { "iuml", "\303\257" },
+  { "inodot", "\304\261" },
+  { "oopf", "\360\235\225\240" },
+  { "vArr", "\342\207\225" },
+  { "nsupE", "\342\253\206\314\270" },
+  { 0, 0 },
+  { "timesd", "\342\250\260" },
+  { "excl", "!" },
+  { "lnapprox", "\342\252\211" },
+  { 0, 0 },
+  { "Umacr", "\305\252" },
+  { 0, 0 },
+  { 0, 0 },
+  { "LeftVectorBar", "\342\245\222" },
+  { "Star", "\342\213\206" },
+  { "lsh", "\342\206\260" },
+  { "cupor", "\342\251\205" },
+  { 0, 0 },
+  { "filig", "\357\254\201" },
+  { "LessTilde", "\342\211\262" },
+  { "NotCupCap", "\342\211\255" },
+  { "varsubsetneq", "\342\212\212\357\270\200" },
+  { "trie", "\342\211\234" },
+  { "digamma", "\317\235" },
+  { "shortmid", "\342\210\243" },
+  { "boxhD", "\342\225\245" },
+  { "boxhd", "\342\224\254" },
+  { "Kcedil", "\304\266" },
+  { "zwnj", "\342\200\214" },
+  { "tscy", "\321\206" },
+  { 0, 0 },
+  { "aelig", "\303\246" },
+  { "erarr", "\342\245\261" },
+  { 0, 0 },
+  { 0, 0 },
+  { 0, 0 },
+  { "Mcy", "\320\234" },
+  { 0, 0 },
+  { "curlywedge", "\342\213\217" },
+  { 0, 0 },
+  { "cups", "\342\210\252\357\270\200" },
+  { "Sfr", "\360\235\224\226" },
+  { "sqsup", "\342\212\220" },
+  { "Icy", "\320\230" },
+  { 0, 0 },
+  { "ldsh", "\342\206\262" },
+  { "rdca", "\342\244\267" },
+  { 0, 0 },
+  { "loplus", "\342\250\255" },
+  { "SHcy", "\320\250" },
+  { "ell", "\342\204\223" },
+  { "simrarr", "\342\245\262" },
+  { "Lsh", "\342\206\260" },
+  { "ll", "\342\211\252" },
+  { "hopf", "\360\235\225\231" },
+  { "sqsub", "\342\212\217" },
+  { "langle", "\342\237\250" },
+  { "Backslash", "\342\210\226" },
+  { "jmath", "\310\267" },
+  { "Omacr", "\305\214" },
+  { "gesdotol", "\342\252\204" },
+  { "xi", "\316\276" },
+  { "Eopf", "\360\235\224\274" },
+  { "urcorn", "\342\214\235" },
+  { "lesseqqgtr", "\342\252\213" },
+  { "RightFloor", "\342\214\213" },
+  { "vrtri", "\342\212\263" },
+  { "sigmav", "\317\202" },
+  { "boxvh", "\342\224\274" },
+  { "Igrave", "\303\214" },
+  { "ljcy", "\321\231" },
+  { "imped", "\306\265" },
+  { "div", "\303\267" },
+  { 0, 0 },
+  { "lrhar", "\342\207\213" },
+  { "agrave", "\303\240" },
+  { "hardcy", "\321\212" },
+  { "GreaterTilde", "\342\211\263" },
+  { "Bcy", "\320\221" },
+  { "dotplus", "\342\210\224" },
+  { "permil", "\342\200\260" },
+  { "rsh", "\342\206\261" },
+  { 0, 0 },
+  { "lArr", "\342\207\220" },
+  { 0, 0 },
+  { "ssetmn", "\342\210\226" },
+  { "cir", "\342\227\213" },
+  { "NotPrecedesSlantEqual", "\342\213\240" },
+  { "seswar", "\342\244\251" },
+  { "lambda", "\316\273" },
+  { 0, 0 },
+  { "DiacriticalDoubleAcute", "\313\235" },
+  { "sup2", "\302\262" },
+  { "Ntilde", "\303\221" },
+  { "rarrc", "\342\244\263" },
+  { "NotLeftTriangle", "\342\213\252" },
+  { "RoundImplies", "\342\245\260" },
+  { "RightTeeVector", "\342\245\233" },
+  { "eqcolon", "\342\211\225" },
+  { "succnapprox", "\342\252\272" },
+  { "odiv", "\342\250\270" },
+  { "sigmaf", "\317\202" },
+  { "quaternions", "\342\204\215" },
+  { "csupe", "\342\253\222" },
+  { "kappav", "\317\260" },
+  { "gtreqqless", "\342\252\214" },
+  { 0, 0 },
+  { "lEg", "\342\252\213" },
+  { "varpi", "\317\226" },
+  { 0, 0 },
+  { "planck", "\342\204\217" },
+  { "Gcy", "\320\223" },
+  { 0, 0 },
+  { "rcub", "}" },
+  { "ni", "\342\210\213" },
+  { "NegativeVeryThinSpace", "\342\200\213" },
+  { "omega", "\317\211" },
+  { 0, 0 },
+  { 0, 0 },
+  { "otimes", "\342\212\227" },
+  { "Gamma", "\316\223" },
+  { 0, 0 },
+  { "lrhard", "\342\245\255" },
+  { "bsol", "\134" },
+  { "boxplus", "\342\212\236" },
+  { "vsupne", "\342\212\213\357\270\200" },
+  { 0, 0 },
+  { "Auml", "\303\204" },
+  { "Ccaron", "\304\214" },
+  { "theta", "\316\270" },
+  { "darr", "\342\206\223" },
+  { 0, 0 },
+  { 0, 0 },
+  { "RightTeeArrow", "\342\206\246" },
+  { "kcy", "\320\272" },
+  { "lgE", "\342\252\221" },
+  { "incare", "\342\204\205" },
+  { "dopf", "\360\235\225\225" },
+  { "DotDot", "\342\203\234" },
+  { "isinsv", "\342\213\263" },
+  { "Lcaron", "\304\275" },
+  { "Colon", "\342\210\267" },
+  { "NotLessLess", "\342\211\252\314\270" },
+  { 0, 0 },
+  { "Sscr", "\360\235\222\256" },
+  { "sqsupe", "\342\212\222" },
+  { "xutri", "\342\226\263" },
+  { "varsubsetneqq", "\342\253\213\357\270\200" },
+  { "DoubleLongLeftArrow", "\342\237\270" },
+  { "image", "\342\204\221" },
+  { 0, 0 },
+  { "NotGreater", "\342\211\257" },
+  { "Copf", "\342\204\202" },
+  { 0, 0 },
+  { "frac12", "\302\275" },
+  { "gbreve", "\304\237" },
+  { 0, 0 },
+  { "LeftUpDownVector", "\342\245\221" },
+  { "rarrpl", "\342\245\205" },
+  { "ddagger", "\342\200\241" },
+  { "ucy", "\321\203" },
+  { "llhard", "\342\245\253" },
+  { 0, 0 },
+  { "niv", "\342\210\213" },
+  { "swarrow", "\342\206\231" },
+  { "GreaterFullEqual", "\342\211\247" },
+  { "odsold", "\342\246\274" },
+  { "LeftTriangleBar", "\342\247\217" },
+  { "Rho", "\316\241" },
+  { "cfr", "\360\235\224\240" },
+  { "FilledVerySmallSquare", "\342\226\252" },
+  { "esim", "\342\211\202" },
+  { 0, 0 },
+  { "exponentiale", "\342\205\207" },
+  { 0, 0 },
+  { 0, 0 },
+  { "dtri", "\342\226\277" },
+  { "lessdot", "\342\213\226" },
+  { "ifr", "\360\235\224\246" },
+  { "smt", "\342\252\252" },
+  { 0, 0 },
+  { "reg", "\302\256" },
+  { "Implies", "\342\207\222" },
+  { "yen", "\302\245" },
+  { "Tilde", "\342\210\274" },
+  { "neArr", "\342\207\227" },
+  { "rlhar", "\342\207\214" },
+  { "DiacriticalDot", "\313\231" },
+  { "wreath", "\342\211\200" },
+  { "igrave", "\303\254" },
+  { "bigotimes", "\342\250\202" },
+  { 0, 0 },
+  { "afr", "\360\235\224\236" },
+  { 0, 0 },
+  { "boxhu", "\342\224\264" },
+  { "cross", "\342\234\227" },
+  { "Lmidot", "\304\277" },
+  { "SucceedsSlantEqual", "\342\211\275" },
+  { "nsucc", "\342\212\201" },
+  { 0, 0 },
+  { "succeq", "\342\252\260" },
+  { "exist", "\342\210\203" },
+  { "sube", "\342\212\206" },
+  { "varr", "\342\206\225" },
+  { "Cacute", "\304\206" },
+  { "num", "#" },
+  { "smashp", "\342\250\263" },
+  { "larrlp", "\342\206\253" },
+  { "bsemi", "\342\201\217" },
+  { "dArr", "\342\207\223" },
+  { "nshortmid", "\342\210\244" },
+  { 0, 0 },
+  { "sqcaps", "\342\212\223\357\270\200" },
+  { "Hfr", "\342\204\214" },
+  { "LeftTeeArrow", "\342\206\244" },
+  { 0, 0 },
+  { 0, 0 },
+  { 0, 0 },
+  { "nsqsupe", "\342\213\243" },
+  { "els", "\342\252\225" },
+  { 0, 0 },
+  { 0, 0 },
+  { "dscy", "\321\225" },
+  { "strns", "\302\257" },
+  { "wedgeq", "\342\211\231" },
+  { "NegativeThinSpace", "\342\200\213" },
+  { "mcy", "\320\274" },
+  { "FilledSmallSquare", "\342\227\274" },
+  { "Ecy", "\320\255" },
+  { "minus", "\342\210\222" },
+  { "Gg", "\342\213\231" },
+  { 0, 0 },
+  { 0, 0 },
+  { 0, 0 },
+  { "nvap", "\342\211\215\342\203\222" },
+  { "Dcaron", "\304\216" },
+  { "Equilibrium", "\342\207\214" },
+  { "rbrkslu", "\342\246\220" },
+  { "lhblk", "\342\226\204" },
+  { 0, 0 },
+  { "rdquor", "\342\200\235" },
+  { "primes", "\342\204\231" },
+  { "xrArr", "\342\237\271" },
+  { "RightDownTeeVector", "\342\245\235" },
+  { 0, 0 },
+  { "hoarr", "\342\207\277" },
+  { 0, 0 },
+  { "LessFullEqual", "\342\211\246" },
+  { "mfr", "\360\235\224\252" },
+  { "boxminus", "\342\212\237" },
+  { 0, 0 },
+  { "gacute", "\307\265" },
+  { "upsi", "\317\205" },
+  { "rharu", "\342\207\200" },
+  { 0, 0 },
+  { "lsquor", "\342\200\232" },
+  { 0, 0 },
+  { 0, 0 },
+  { "UpArrow", "\342\206\221" },
+  { "thickapprox", "\342\211\210" },
+  { 0, 0 },
+  { "geq", "\342\211\245" },
+  { "looparrowright", "\342\206\254" },
+  { "lceil", "\342\214\210" },
+  { 0, 0 },
+  { "cuvee", "\342\213\216" },
+  { "midast", "*" },
+  { 0, 0 },
+  { "euml", "\303\253" },
+  { "SOFTcy", "\320\254" },
+  { "PartialD", "\342\210\202" },
+  { "circlearrowright", "\342\206\273" },
+  { "emptyv", "\342\210\205" },
+  { 0, 0 },
+  { 0, 0 },
+  { "rightsquigarrow", "\342\206\235" },
+  { "Map", "\342\244\205" },
+  { "Scaron", "\305\240" },
+  { 0, 0 },
+  { "backcong", "\342\211\214" },
+  { 0, 0 },
+  { 0, 0 },
+  { "uparrow", "\342\206\221" },
+  { "clubs", "\342\231\243" },
+  { "TildeEqual", "\342\211\203" },
+  { 0, 0 },
+  { "boxhU", "\342\225\250" },
+  { 0, 0 },
+  { "UnionPlus", "\342\212\216" },
+  { "prec", "\342\211\272" },
+  { "Not", "\342\253\254" },
+  { "varsupsetneq", "\342\212\213\357\270\200" },
+  { "vprop", "\342\210\235" },
+  { "sopf", "\360\235\225\244" },
+  { 0, 0 },
+  { "VDash", "\342\212\253" },
+  { "minusd", "\342\210\270" },
+  { 0, 0 },
+  { 0, 0 },
+  { "bot", "\342\212\245" },
+  { "IOcy", "\320\201" },
+  { "therefore", "\342\210\264" },
+  { "nsubseteqq", "\342\253\205\314\270" },
+  { "npar", "\342\210\246" },
+  { "ForAll", "\342\210\200" },
+  { 0, 0 },
+  { "OverBracket", "\342\216\264" },
+  { "uogon", "\305\263" },
+  { "rightleftarrows", "\342\207\204" },
+  { "NJcy", "\320\212" },
+  { "iscr", "\360\235\222\276" },
+  { "triangledown", "\342\226\277" },
+  { "ufisht", "\342\245\276" },
+  { "Idot", "\304\260" },
+  { "esdot", "\342\211\220" },
+  { "jfr", "\360\235\224\247" },
+  { "Gopf", "\360\235\224\276" },
+  { "ecirc", "\303\252" },
+  { "rrarr", "\342\207\211" },
+  { "DoubleDownArrow", "\342\207\223" },
+  { "Ccedil", "\303\207" },
+  { "spar", "\342\210\245" },
+  { "Euml", "\303\213" },
+  { "geqq", "\342\211\247" },
+  { 0, 0 },
+  { "euro", "\342\202\254" },
+  { "VerticalTilde", "\342\211\200" },
+  { "lcub", "{" },
+  { "rarrbfs", "\342\244\240" },
+  { "nsubset", "\342\212\202\342\203\222" },
+  { "scedil", "\305\237" },
+  { "suphsol", "\342\237\211" },
+  { "rBarr", "\342\244\217" },
+  { 0, 0 },
+  { "ncong", "\342\211\207" },
+  { 0, 0 },
+  { "Dscr", "\360\235\222\237" },
+  { "rbrack", "]" },
+  { "rdldhar", "\342\245\251" },
+  { "plus", "+" },
+  { "boxdR", "\342\225\222" },
+  { "eg", "\342\252\232" },
+  { "lcedil", "\304\274" },
+  { 0, 0 },
+  { "succcurlyeq", "\342\211\275" },
+  { "nvlArr", "\342\244\202" },
+  { "boxuL", "\342\225\233" },
+  { "KJcy", "\320\214" },
+  { "vartheta", "\317\221" },
+  { 0, 0 },
+  { "quot", "\042" },
+  { "oS", "\342\223\210" },
+  { "rdquo", "\342\200\235" },
+  { "supedot", "\342\253\204" },
+  { "nvlt", "<\342\203\222" },
+  { 0, 0 },
+  { "Mopf", "\360\235\225\204" },
+  { 0, 0 },
+  { "ENG", "\305\212" },
+  { "lnE", "\342\211\250" },
+  { "dcaron", "\304\217" },
+  { "ntrianglelefteq", "\342\213\254" },
+  { "aacute", "\303\241" },
+  { "GreaterSlantEqual", "\342\251\276" },
+  { "varsigma", "\317\202" },
+  { "leftrightsquigarrow", "\342\206\255" },
+  { "dlcorn", "\342\214\236" },
+  { "topcir", "\342\253\261" },
+  { 0, 0 },
+  { "circledR", "\302\256" },
+  { "Odblac", "\305\220" },
+  { "bigstar", "\342\230\205" },
+  { "Lacute", "\304\271" },
+  { "larrbfs", "\342\244\237" },
+  { "xcirc", "\342\227\257" },
+  { "bsolb", "\342\247\205" },
+  { "nparsl", "\342\253\275\342\203\245" },
+  { "Acirc", "\303\202" },
+  { "nlt", "\342\211\256" },
+  { 0, 0 },
+  { 0, 0 },
+  { "orv", "\342\251\233" },
+  { "block", "\342\226\210" },
+  { 0, 0 },
+  { 0, 0 },
+  { "Wfr", "\360\235\224\232" },
+  { "upharpoonright", "\342\206\276" },
+  { "Uogon", "\305\262" },
+  { "Yscr", "\360\235\222\264" },
+  { "subseteqq", "\342\253\205" },
+  { "boxur", "\342\224\224" },
+  { "nisd", "\342\213\272" },
+  { "barvee", "\342\212\275" },
+  { "gtreqless", "\342\213\233" },
+  { "in", "\342\210\210" },
+  { "angrt", "\342\210\237" },
+  { "npre", "\342\252\257\314\270" },
+  { "sfrown", "\342\214\242" },
+  { "ord", "\342\251\235" },
+  { "orderof", "\342\204\264" },
+  { 0, 0 },
+  { 0, 0 },
+  { "gsiml", "\342\252\220" },
+  { "profalar", "\342\214\256" },
+  { "cirscir", "\342\247\202" },
+  { "Vdash", "\342\212\251" },
+  { "bull", "\342\200\242" },
+  { "rmoust", "\342\216\261" },
+  { "ulcrop", "\342\214\217" },
+  { 0, 0 },
+  { 0, 0 },
+  { "frac16", "\342\205\231" },
+  { "DownTeeArrow", "\342\206\247" },
+  { "NotPrecedesEqual", "\342\252\257\314\270" },
+  { "DoubleUpArrow", "\342\207\221" },
+  { "upsilon", "\317\205" },
+  { 0, 0 },
+  { "Ucirc", "\303\233" },
+  { "ReverseUpEquilibrium", "\342\245\257" },
+  { "dashv", "\342\212\243" },
+  { "ordm", "\302\272" },
+  { 0, 0 },
+  { "boxuR", "\342\225\230" },
+  { "lg", "\342\211\266" },
+  { "Intersection", "\342\213\202" },
+  { "gnsim", "\342\213\247" },
+  { 0, 0 },
+  { "CHcy", "\320\247" },
+  { 0, 0 },
+  { "yacy", "\321\217" },
+  { "ominus", "\342\212\226" },
+  { "NoBreak", "\342\201\240" },
+  { "cwint", "\342\210\261" },
+  { 0, 0 },
+  { "supseteqq", "\342\253\206" },
+  { 0, 0 },
+  { "ge", "\342\211\245" },
+  { "Longleftrightarrow", "\342\237\272" },
+  { "otilde", "\303\265" },
+  { "plustwo", "\342\250\247" },
+  { "NotLessSlantEqual", "\342\251\275\314\270" },
+  { "preceq", "\342\252\257" },
+  { "Tstrok", "\305\246" },
+  { 0, 0 },
+  { "pm", "\302\261" },
+  { 0, 0 },
+  { "zcaron", "\305\276" },
+  { "ldquo", "\342\200\234" },
+  { "eplus", "\342\251\261" },
+  { 0, 0 },
+  { 0, 0 },
+  { "CloseCurlyDoubleQuote", "\342\200\235" },
+  { "ang", "\342\210\240" },
+  { "forall", "\342\210\200" },
+  { 0, 0 },
+  { "Zacute", "\305\271" },
+  { 0, 0 },
+  { "curlyvee", "\342\213\216" },
+  { "Ascr", "\360\235\222\234" },
+  { 0, 0 },
+  { "pound", "\302\243" },
+  { "egs", "\342\252\226" },
+  { "vopf", "\360\235\225\247" },
+  { 0, 0 },
+  { "mdash", "\342\200\224" },
+  { 0, 0 },
+  { 0, 0 },
+  { 0, 0 },
+  { "thicksim", "\342\210\274" },
+  { "scsim", "\342\211\277" },
+  { "iecy", "\320\265" },
+  { "NotLessTilde", "\342\211\264" },
+  { "vnsub", "\342\212\202\342\203\222" },
+  { "UnderBracket", "\342\216\265" },
+  { 0, 0 },
+  { "beth", "\342\204\266" },
+  { "prcue", "\342\211\274" },
+  { "daleth", "\342\204\270" },
+  { "nleq", "\342\211\260" },
+  { "Dopf", "\360\235\224\273" },
+  { "setminus", "\342\210\226" },
+  { "ast", "*" },
+  { "Superset", "\342\212\203" },
+  { 0, 0 },
+  { "nprcue", "\342\213\240" },
+  { "lat", "\342\252\253" },
+  { "eogon", "\304\231" },
+  { "DJcy", "\320\202" },
+  { 0, 0 },
+  { "Iacute", "\303\215" },
+  { "tosa", "\342\244\251" },
+  { "race", "\342\210\275\314\261" },
+  { "Oslash", "\303\230" },
+  { 0, 0 },
+  { 0, 0 },
+  { 0, 0 },
+  { "NotNestedLessLess", "\342\252\241\314\270" },
+  { "Gt", "\342\211\253" },
+  { "xcup", "\342\213\203" },
+  { "isindot", "\342\213\265" },
+  { "blacklozenge", "\342\247\253" },
+  { "vsubne", "\342\212\212\357\270\200" },
+  { 0, 0 },
+  { "NotLeftTriangleBar", "\342\247\217\314\270" },
+  { "Square", "\342\226\241" },
+  { "rotimes", "\342\250\265" },
+  { "curlyeqprec", "\342\213\236" },
+  { "pcy", "\320\277" },
+  { "glE", "\342\252\222" },
+  { "homtht", "\342\210\273" },
+  { "natural", "\342\231\256" },
+  { 0, 0 },
+  { "bopf", "\360\235\225\223" },
+  { "el", "\342\252\231" },
+  { "Conint", "\342\210\257" },
+  { "Scedil", "\305\236" },
+  { "ntilde", "\303\261" },
+  { "cuwed", "\342\213\217" },
+  { "boxvR", "\342\225\236" },
+  { 0, 0 },
+  { "CapitalDifferentialD", "\342\205\205" },
+  { "fpartint", "\342\250\215" },
+  { "dstrok", "\304\221" },
+  { "angrtvbd", "\342\246\235" },
+  { "NotDoubleVerticalBar", "\342\210\246" },
+  { "plusdo", "\342\210\224" },
+  { 0, 0 },
+  { "kcedil", "\304\267" },
+  { "forkv", "\342\253\231" },
+  { "notni", "\342\210\214" },
+  { "dotminus", "\342\210\270" },
+  { "lopf", "\360\235\225\235" },
+  { "PrecedesTilde", "\342\211\276" },
+  { 0, 0 },
+  { "NotLessGreater", "\342\211\270" },
+  { "weierp", "\342\204\230" },
+  { "Tscr", "\360\235\222\257" },
+  { "boxVH", "\342\225\254" },
+  { "mapstoup", "\342\206\245" },
+  { "Fscr", "\342\204\261" },
+  { 0, 0 },
+  { 0, 0 },
+  { "rbrace", "}" },
+  { "lstrok", "\305\202" },
+  { 0, 0 },
+  { "RightVector", "\342\207\200" },
+  { "trisb", "\342\247\215" },
+  { "CupCap", "\342\211\215" },
+  { "kfr", "\360\235\224\250" },
+  { 0, 0 },
+  { "Jcirc", "\304\264" },
+  { "ropar", "\342\246\206" },
+  { 0, 0 },
+  { "or", "\342\210\250" },
+  { "Xfr", "\360\235\224\233" },
+  { "urcrop", "\342\214\216" },
+  { "circledcirc", "\342\212\232" },
+  { "hookrightarrow", "\342\206\252" },
+  { "ouml", "\303\266" },
+  { "beta", "\316\262" },
+  { 0, 0 },
+  { "leftrightarrow", "\342\206\224" },
+  { "subedot", "\342\253\203" },
+  { "subsetneq", "\342\212\212" },
+  { 0, 0 },
+  { "udarr", "\342\207\205" },
+  { 0, 0 },
+  { "nesear", "\342\244\250" },
+  { "SmallCircle", "\342\210\230" },
+  { "CounterClockwiseContourIntegral", "\342\210\263" },
+  { "DownRightVectorBar", "\342\245\227" },
+  { "bigcap", "\342\213\202" },
+  { 0, 0 },
+  { "rsaquo", "\342\200\272" },
+  { "ogon", "\313\233" },
+  { "subsetneqq", "\342\253\213" },
+  { "boxUR", "\342\225\232" },
+  { "NotGreaterFullEqual", "\342\211\247\314\270" },
+  { 0, 0 },
+  { 0, 0 },
+  { "sim", "\342\210\274" },
+  { "lesseqgtr", "\342\213\232" },
+  { 0, 0 },
+  { "cwconint", "\342\210\262" },
+  { "nLt", "\342\211\252\342\203\222" },
+  { "iiota", "\342\204\251" },
+  { "isins", "\342\213\264" },
+  { "zfr", "\360\235\224\267" },
+  { 0, 0 },
+  { "male", "\342\231\202" },
+  { "tritime", "\342\250\273" },
+  { "lharul", "\342\245\252" },
+  { "nmid", "\342\210\244" },
+  { "Atilde", "\303\203" },
+  { "commat", "@" },
+  { "NotCongruent", "\342\211\242" },
+  { "nvgt", ">\342\203\222" },
+  { "lessapprox", "\342\252\205" },
+  { "Ocy", "\320\236" },
+  { "Utilde", "\305\250" },
+  { "gdot", "\304\241" },
+  { "Wopf", "\360\235\225\216" },
+  { "VerticalSeparator", "\342\235\230" },
+  { "Uring", "\305\256" },
+  { "nearhk", "\342\244\244" },
+  { "leq", "\342\211\244" },
+  { "curvearrowleft", "\342\206\266" },
+  { "boxv", "\342\224\202" },
+  { "hellip", "\342\200\246" },
+  { 0, 0 },
+  { "Pi", "\316\240" },
+  { 0, 0 },
+  { "boxV", "\342\225\221" },
+  { "Escr", "\342\204\260" },
+  { 0, 0 },
+  { "HorizontalLine", "\342\224\200" },
+  { 0, 0 },
+  { "dblac", "\313\235" },
+  { "cup", "\342\210\252" },
+  { "NotPrecedes", "\342\212\200" },
+  { 0, 0 },
+  { "Pr", "\342\252\273" },
+  { "Pcy", "\320\237" },
+  { 0, 0 },
+  { "gamma", "\316\263" },
+  { "nlsim", "\342\211\264" },
+  { "NotLeftTriangleEqual", "\342\213\254" },
+  { 0, 0 },
+  { "chcy", "\321\207" },
+  { "Kscr", "\360\235\222\246" },
+  { "lesdot", "\342\251\277" },
+  { "pointint", "\342\250\225" },
+  { 0, 0 },
+  { "timesbar", "\342\250\261" },
+  { 0, 0 },
+  { "Leftrightarrow", "\342\207\224" },
+  { 0, 0 },
+  { "rhard", "\342\207\201" },
+  { 0, 0 },
+  { "uHar", "\342\245\243" },
+  { 0, 0 },
+  { "leqslant", "\342\251\275" },
+  { "frasl", "\342\201\204" },
+  { "kopf", "\360\235\225\234" },
+  { "ClockwiseContourIntegral", "\342\210\262" },
+  { "ThickSpace", "\342\201\237\342\200\212" },
+  { "Vert", "\342\200\226" },
+  { "DiacriticalGrave", "`" },
+  { "sqsubseteq", "\342\212\221" },
+  { 0, 0 },
+  { 0, 0 },
+  { "nrarrc", "\342\244\263\314\270" },
+  { "Vbar", "\342\253\253" },
+  { "star", "\342\230\206" },
+  { "ltrPar", "\342\246\226" },
+  { "horbar", "\342\200\225" },
+  { "SquareUnion", "\342\212\224" },
+  { "NotSquareSuperset", "\342\212\220\314\270" },
+  { "Laplacetrf", "\342\204\222" },
+  { "LeftRightVector", "\342\245\216" },
+  { "angmsdab", "\342\246\251" },
+  { "xcap", "\342\213\202" },
+  { "ZeroWidthSpace", "\342\200\213" },
+  { "SucceedsEqual", "\342\252\260" },
+  { "Zscr", "\360\235\222\265" },
+  { "boxdr", "\342\224\214" },
+  { "jukcy", "\321\224" },
+  { "lAtail", "\342\244\233" },
+  { "yacute", "\303\275" },
+  { "NotEqualTilde", "\342\211\202\314\270" },
+  { 0, 0 },
+  { "rfr", "\360\235\224\257" },
+  { "utri", "\342\226\265" },
+  { "lltri", "\342\227\272" },
+  { "nvdash", "\342\212\254" },
+  { "Ncy", "\320\235" },
+  { "softcy", "\321\214" },
+  { 0, 0 },
+  { "dtdot", "\342\213\261" },
+  { "bumpE", "\342\252\256" },
+  { 0, 0 },
+  { "nLtv", "\342\211\252\314\270" },
+  { 0, 0 },
+  { "ltquest", "\342\251\273" },
+  { "curarr", "\342\206\267" },
+  { "djcy", "\321\222" },
+  { "Rsh", "\342\206\261" },
+  { "rscr", "\360\235\223\207" },
+  { "Yuml", "\305\270" },
+  { "part", "\342\210\202" },
+  { "ac", "\342\210\276" },
+  { "Cdot", "\304\212" },
+  { "UpArrowDownArrow", "\342\207\205" },
+  { 0, 0 },
+  { "RightDownVector", "\342\207\202" },
+  { 0, 0 },
+  { "realine", "\342\204\233" },
+  { "egrave", "\303\250" },
+  { "apacir", "\342\251\257" },
+  { "udhar", "\342\245\256" },
+  { "Uuml", "\303\234" },
+  { "imath", "\304\261" },
+  { "Qscr", "\360\235\222\254" },
+  { "Zcy", "\320\227" },
+  { 0, 0 },
+  { "cupcap", "\342\251\206" },
+  { "Ocirc", "\303\224" },
+  { "Jscr", "\360\235\222\245" },
+  { "Lambda", "\316\233" },
+  { "supne", "\342\212\213" },
+  { "frac18", "\342\205\233" },
+  { "rtri", "\342\226\271" },
+  { "SquareSupersetEqual", "\342\212\222" },
+  { "emacr", "\304\223" },
+  { 0, 0 },
+  { 0, 0 },
+  { 0, 0 },
+  { "Fopf", "\360\235\224\275" },
+  { 0, 0 },
+  { "nsupseteqq", "\342\253\206\314\270" },
+  { "ring", "\313\232" },
+  { "bump", "\342\211\216" },
+  { 0, 0 },
+  { 0, 0 },
+  { "LongLeftRightArrow", "\342\237\267" },
+  { "sol", "/" },
+  { "intcal", "\342\212\272" },
+  { "KHcy", "\320\245" },
+  { "boxHD", "\342\225\246" },
+  { "doublebarwedge", "\342\214\206" },
+  { "ssmile", "\342\214\243" },
+  { 0, 0 },
+  { "mu", "\316\274" },
+  { "duhar", "\342\245\257" },
+  { "gjcy", "\321\223" },
+  { "nharr", "\342\206\256" },
+  { "uharr", "\342\206\276" },
+  { "Gscr", "\360\235\222\242" },
+  { "orslope", "\342\251\227" },
+  { "ocirc", "\303\264" },
+  { 0, 0 },
+  { "alpha", "\316\261" },
+  { "lscr", "\360\235\223\201" },
+  { 0, 0 },
+  { "cupbrcap", "\342\251\210" },
+  { 0, 0 },
+  { "Ll", "\342\213\230" },
+  { 0, 0 },
+  { "Kcy", "\320\232" },
+  { "LeftArrowRightArrow", "\342\207\206" },
+  { 0, 0 },
+  { "squarf", "\342\226\252" },
+  { "Iuml", "\303\217" },
+  { "map", "\342\206\246" },
+  { "RightDownVectorBar", "\342\245\225" },
+  { "lbrksld", "\342\246\217" },
+  { "triangleright", "\342\226\271" },
+  { "NotGreaterLess", "\342\211\271" },
+  { 0, 0 },
+  { 0, 0 },
+  { "lnsim", "\342\213\246" },
+  { "ubrcy", "\321\236" },
+  { "leftthreetimes", "\342\213\213" },
+  { "imof", "\342\212\267" },
+  { "conint", "\342\210\256" },
+  { "subsup", "\342\253\223" },
+  { "Rcaron", "\305\230" },
+  { "LowerLeftArrow", "\342\206\231" },
+  { "hookleftarrow", "\342\206\251" },
+  { "rbarr", "\342\244\215" },
+  { "gnap", "\342\252\212" },
+  { "Sqrt", "\342\210\232" },
+  { "Sacute", "\305\232" },
+  { "ETH", "\303\220" },
+  { "nedot", "\342\211\220\314\270" },
+  { "piv", "\317\226" },
+  { "lbbrk", "\342\235\262" },
+  { "OpenCurlyDoubleQuote", "\342\200\234" },
+  { "boxDr", "\342\225\223" },
+  { 0, 0 },
+  { 0, 0 },
+  { "Popf", "\342\204\231" },
+  { "amacr", "\304\201" },
+  { "larrpl", "\342\244\271" },
+  { "eth", "\303\260" },
+  { "lrarr", "\342\207\206" },
+  { 0, 0 },
+  { 0, 0 },
+  { 0, 0 },
+  { "Racute", "\305\224" },
+  { "Kopf", "\360\235\225\202" },
+  { "nsucceq", "\342\252\260\314\270" },
+  { "lsim", "\342\211\262" },
+  { "succsim", "\342\211\277" },
+  { "maltese", "\342\234\240" },
+  { "boxHu", "\342\225\247" },
+  { "boxUr", "\342\225\231" },
+  { 0, 0 },
+  { 0, 0 },
+  { "DownBreve", "\314\221" },
+  { "models", "\342\212\247" },
+  { "NotElement", "\342\210\211" },
+  { 0, 0 },
+  { 0, 0 },
+  { "Supset", "\342\213\221" },
+  { "zeetrf", "\342\204\250" },
+  { 0, 0 },
+  { "TSHcy", "\320\213" },
+  { "rHar", "\342\245\244" },
+  { 0, 0 },
+  { "curren", "\302\244" },
+  { 0, 0 },
+  { "gtrarr", "\342\245\270" },
+  { "Zcaron", "\305\275" },
+  { "Sopf", "\360\235\225\212" },
+  { "Hstrok", "\304\246" },
+  { "Amacr", "\304\200" },
+  { "nu", "\316\275" },
+  { "DotEqual", "\342\211\220" },
+  { "ImaginaryI", "\342\205\210" },
+  { 0, 0 },
+  { "TRADE", "\342\204\242" },
+  { "Dcy", "\320\224" },
+  { "HumpEqual", "\342\211\217" },
+  { 0, 0 },
+  { "NotRightTriangleEqual", "\342\213\255" },
+  { 0, 0 },
+  { "notindot", "\342\213\265\314\270" },
+  { "smeparsl", "\342\247\244" },
+  { "lap", "\342\252\205" },
+  { 0, 0 },
+  { "ges", "\342\251\276" },
+  { "RightTriangleBar", "\342\247\220" },
+  { "cire", "\342\211\227" },
+  { "boxul", "\342\224\230" },
+  { "vert", "|" },
+  { "bkarow", "\342\244\215" },
+  { "hcirc", "\304\245" },
+  { "submult", "\342\253\201" },
+  { "Uopf", "\360\235\225\214" },
+  { 0, 0 },
+  { "nvinfin", "\342\247\236" },
+  { "cirmid", "\342\253\257" },
+  { "delta", "\316\264" },
+  { "smte", "\342\252\254" },
+  { "Dashv", "\342\253\244" },
+  { "LeftUpVectorBar", "\342\245\230" },
+  { "roarr", "\342\207\276" },
+  { "LeftTee", "\342\212\243" },
+  { 0, 0 },
+  { "acirc", "\303\242" },
+  { "colone", "\342\211\224" },
+  { 0, 0 },
+  { "cupdot", "\342\212\215" },
+  { "drcorn", "\342\214\237" },
+  { 0, 0 },
+  { "UpArrowBar", "\342\244\222" },
+  { "gcy", "\320\263" },
+  { "vangrt", "\342\246\234" },
+  { "Ecaron", "\304\232" },
+  { 0, 0 },
+  { "ecir", "\342\211\226" },
+  { "blank", "\342\220\243" },
+  { "UnderBar", "_" },
+  { "fscr", "\360\235\222\273" },
+  { "deg", "\302\260" },
+  { "complement", "\342\210\201" },
+  { "xlarr", "\342\237\265" },
+  { "yuml", "\303\277" },
+  { 0, 0 },
+  { 0, 0 },
+  { "Coproduct", "\342\210\220" },
+  { "Sup", "\342\213\221" },
+  { 0, 0 },
+  { 0, 0 },
+  { "shchcy", "\321\211" },
+  { "ycy", "\321\213" },
+  { "nVdash", "\342\212\256" },
+  { "dzigrarr", "\342\237\277" },
+  { 0, 0 },
+  { 0, 0 },
+  { "nacute", "\305\204" },
+  { 0, 0 },
+  { "dsol", "\342\247\266" },
+  { 0, 0 },
+  { "ordf", "\302\252" },
+  { "frown", "\342\214\242" },
+  { "bbrk", "\342\216\265" },
+  { "UnderParenthesis", "\342\217\235" },
+  { "Jukcy", "\320\204" },
+  { 0, 0 },
+  { "gtdot", "\342\213\227" },
+  { "psi", "\317\210" },
+  { "nwarrow", "\342\206\226" },
+  { "NotLessEqual", "\342\211\260" },
+  { 0, 0 },
+  { "ffilig", "\357\254\203" },
+  { 0, 0 },
+  { "Iscr", "\342\204\220" },
+  { "YAcy", "\320\257" },
+  { "hairsp", "\342\200\212" },
+  { "rtimes", "\342\213\212" },
+  { "subsim", "\342\253\207" },
+  { "radic", "\342\210\232" },
+  { "bigtriangleup", "\342\226\263" },
+  { 0, 0 },
+  { "Iota", "\316\231" },
+  { 0, 0 },
+  { "real", "\342\204\234" },
+  { "sqcup", "\342\212\224" },
+  { 0, 0 },
+  { 0, 0 },
+  { "rcaron", "\305\231" },
+  { "Nacute", "\305\203" },
+  { "barwed", "\342\214\205" },
+  { "rightrightarrows", "\342\207\211" },
+  { 0, 0 },
+  { "ncup", "\342\251\202" },
+  { 0, 0 },
+  { "npreceq", "\342\252\257\314\270" },
+  { "uring", "\305\257" },
+  { "gfr", "\360\235\224\244" },
+  { "perp", "\342\212\245" },
+  { "ZHcy", "\320\226" },
+  { 0, 0 },
+  { "ee", "\342\205\207" },
+  { 0, 0 },
+  { "mapstoleft", "\342\206\244" },
+  { "SupersetEqual", "\342\212\207" },
+  { "DownLeftVectorBar", "\342\245\226" },
+  { "uml", "\302\250" },
+  { 0, 0 },
+  { "it", "\342\201\242" },
+  { "ncy", "\320\275" },
+  { 0, 0 },
+  { 0, 0 },
+  { "Yopf", "\360\235\225\220" },
+  { "Zopf", "\342\204\244" },
+  { "nabla", "\342\210\207" },
+  { "tilde", "\313\234" },
+  { "DoubleLongRightArrow", "\342\237\271" },
+  { 0, 0 },
+  { "RightAngleBracket", "\342\237\251" },
+  { "UpperRightArrow", "\342\206\227" },
+  { "nsup", "\342\212\205" },
+  { "nvge", "\342\211\245\342\203\222" },
+  { "uarr", "\342\206\221" },
+  { "SucceedsTilde", "\342\211\277" },
+  { "blacktriangleright", "\342\226\270" },
+  { "bdquo", "\342\200\236" },
+  { "lbrack", "[" },
+  { "angmsdaf", "\342\246\255" },
+  { "scap", "\342\252\270" },
+  { 0, 0 },
+  { "notinE", "\342\213\271\314\270" },
+  { "nwarr", "\342\206\226" },
+  { "wopf", "\360\235\225\250" },
+  { "DoubleDot", "\302\250" },
+  { "DoubleRightTee", "\342\212\250" },
+  { "lagran", "\342\204\222" },
+  { 0, 0 },
+  { "micro", "\302\265" },
+  { "bsime", "\342\213\215" },
+  { 0, 0 },
+  { 0, 0 },
+  { 0, 0 },
+  { "lesges", "\342\252\223" },
+  { "Gdot", "\304\240" },
+  { 0, 0 },
+  { "jscr", "\360\235\222\277" },
+  { 0, 0 },
+  { 0, 0 },
+  { "Omicron", "\316\237" },
+  { 0, 0 },
+  { 0, 0 },
+  { "epsi", "\316\265" },
+  { "nap", "\342\211\211" },
+  { 0, 0 },
+  { "zigrarr", "\342\207\235" },
+  { "sime", "\342\211\203" },
+  { "napos", "\305\211" },
+  { 0, 0 },
+  { "triangleq", "\342\211\234" },
+  { "divideontimes", "\342\213\207" },
+  { "rnmid", "\342\253\256" },
+  { 0, 0 },
+  { "hybull", "\342\201\203" },
+  { "nge", "\342\211\261" },
+  { "oast", "\342\212\233" },
+  { "iinfin", "\342\247\234" },
+  { "DoubleVerticalBar", "\342\210\245" },
+  { 0, 0 },
+  { "vartriangleleft", "\342\212\262" },
+  { "nltrie", "\342\213\254" },
+  { "otimesas", "\342\250\266" },
+  { "supmult", "\342\253\202" },
+  { "ovbar", "\342\214\275" },
+  { 0, 0 },
+  { "egsdot", "\342\252\230" },
+  { "precnsim", "\342\213\250" },
+  { "EqualTilde", "\342\211\202" },
+  { "oplus", "\342\212\225" },
+  { 0, 0 },
+  { "bnequiv", "\342\211\241\342\203\245" },
+  { "brvbar", "\302\246" },
+  { "lsime", "\342\252\215" },
+  { "leftrightarrows", "\342\207\206" },
+  { "Tau", "\316\244" },
+  { 0, 0 },
+  { "RightUpDownVector", "\342\245\217" },
+  { "Mscr", "\342\204\263" },
+  { "Longleftarrow", "\342\237\270" },
+  { "ucirc", "\303\273" },
+  { "prurel", "\342\212\260" },
+  { 0, 0 },
+  { "rect", "\342\226\255" },
+  { "ccirc", "\304\211" },
+  { "smallsetminus", "\342\210\226" },
+  { "Lopf", "\360\235\225\203" },
+  { "nsupe", "\342\212\211" },
+  { "angmsd", "\342\210\241" },
+  { 0, 0 },
+  { "sharp", "\342\231\257" },
+  { "varnothing", "\342\210\205" },
+  { 0, 0 },
+  { 0, 0 },
+  { "udblac", "\305\261" },
+  { "acy", "\320\260" },
+  { 0, 0 },
+  { "Afr", "\360\235\224\204" },
+  { 0, 0 },
+  { "semi", ";" },
+  { "gneqq", "\342\211\251" },
+  { 0, 0 },
+  { "lpar", "(" },
+  { "Aopf", "\360\235\224\270" },
+  { "ropf", "\360\235\225\243" },
+  { "sext", "\342\234\266" },
+  { 0, 0 },
+  { "boxtimes", "\342\212\240" },
+  { "ogt", "\342\247\201" },
+  { "approx", "\342\211\210" },
+  { "Ubreve", "\305\254" },
+  { 0, 0 },
+  { 0, 0 },
+  { "lrm", "\342\200\216" },
+  { "LongRightArrow", "\342\237\266" },
+  { "Subset", "\342\213\220" },
+  { 0, 0 },
+  { "lsquo", "\342\200\230" },
+  { "gtrsim", "\342\211\263" },
+  { 0, 0 },
+  { "Emacr", "\304\222" },
+  { "subsub", "\342\253\225" },
+  { "NotHumpDownHump", "\342\211\216\314\270" },
+  { "easter", "\342\251\256" },
+  { "VeryThinSpace", "\342\200\212" },
+  { 0, 0 },
+  { "gEl", "\342\252\214" },
+  { "Tab", "\011" },
+  { "tint", "\342\210\255" },
+  { "lrcorner", "\342\214\237" },
+  { "bullet", "\342\200\242" },
+  { 0, 0 },
+  { "Wscr", "\360\235\222\262" },
+  { "lt", "<" },
+  { 0, 0 },
+  { "blacktriangleleft", "\342\227\202" },
+  { "Itilde", "\304\250" },
+  { "npolint", "\342\250\224" },
+  { 0, 0 },
+  { "Fouriertrf", "\342\204\261" },
+  { 0, 0 },
+  { "gl", "\342\211\267" },
+  { "nhArr", "\342\207\216" },
+  { "shy", "\302\255" },
+  { "caret", "\342\201\201" },
+  { "DownLeftTeeVector", "\342\245\236" },
+  { "ntrianglerighteq", "\342\213\255" },
+  { "varrho", "\317\261" },
+  { 0, 0 },
+  { "circledS", "\342\223\210" },
+  { "Aring", "\303\205" },
+  { "sc", "\342\211\273" },
+  { "boxHU", "\342\225\251" },
+  { "SuchThat", "\342\210\213" },
+  { "scE", "\342\252\264" },
+  { "oelig", "\305\223" },
+  { "cularr", "\342\206\266" },
+  { "gel", "\342\213\233" },
+  { 0, 0 },
+  { "phi", "\317\206" },
+  { "Dot", "\302\250" },
+  { 0, 0 },
+  { "Leftarrow", "\342\207\220" },
+  { "LeftDownVector", "\342\207\203" },
+  { "and", "\342\210\247" },
+  { "simgE", "\342\252\240" },
+  { 0, 0 },
+  { "plusb", "\342\212\236" },
+  { "not", "\302\254" },
+  { "ndash", "\342\200\223" },
+  { "mapsto", "\342\206\246" },
+  { "plussim", "\342\250\246" },
+  { "gopf", "\360\235\225\230" },
+  { "plusacir", "\342\250\243" },
+  { "prE", "\342\252\263" },
+  { "GreaterLess", "\342\211\267" },
+  { "backprime", "\342\200\265" },
+  { "rceil", "\342\214\211" },
+  { 0, 0 },
+  { "RightTriangle", "\342\212\263" },
+  { "solbar", "\342\214\277" },
+  { "odot", "\342\212\231" },
+  { "boxVr", "\342\225\237" },
+  { 0, 0 },
+  { "hArr", "\342\207\224" },
+  { "nleftrightarrow", "\342\206\256" },
+  { "Ucy", "\320\243" },
+  { 0, 0 },
+  { "measuredangle", "\342\210\241" },
+  { "Rang", "\342\237\253" },
+  { "abreve", "\304\203" },
+  { "UpperLeftArrow", "\342\206\226" },
+  { "Updownarrow", "\342\207\225" },
+  { "LeftTeeVector", "\342\245\232" },
+  { "lmidot", "\305\200" },
+  { "nldr", "\342\200\245" },
+  { "Jopf", "\360\235\225\201" },
+  { "NotSucceeds", "\342\212\201" },
+  { "rarrtl", "\342\206\243" },
+  { "lacute", "\304\272" },
+  { "boxvL", "\342\225\241" },
+  { "CenterDot", "\302\267" },
+  { "blacktriangle", "\342\226\264" },
+  { "lhard", "\342\206\275" },
+  { "boxDl", "\342\225\226" },
+  { "dfr", "\360\235\224\241" },
+  { "gtlPar", "\342\246\225" },
+  { "iocy", "\321\221" },
+  { "iexcl", "\302\241" },
+  { "CircleTimes", "\342\212\227" },
+  { "olcir", "\342\246\276" },
+  { "Gammad", "\317\234" },
+  { "Jcy", "\320\231" },
+  { "leg", "\342\213\232" },
+  { "Pfr", "\360\235\224\223" },
+  { 0, 0 },
+  { "nvHarr", "\342\244\204" },
+  { "Rarr", "\342\206\240" },
+  { "empty", "\342\210\205" },
+  { "RightTriangleEqual", "\342\212\265" },
+  { "RightVectorBar", "\342\245\223" },
+  { 0, 0 },
+  { 0, 0 },
+  { "bsolhsub", "\342\237\210" },
+  { "DoubleRightArrow", "\342\207\222" },
+  { "frac78", "\342\205\236" },
+  { "LongLeftArrow", "\342\237\265" },
+  { "subnE", "\342\253\213" },
+  { "rx", "\342\204\236" },
+  { "cirfnint", "\342\250\220" },
+  { "Integral", "\342\210\253" },
+  { "nles", "\342\251\275\314\270" },
+  { "eparsl", "\342\247\243" },
+  { "epsilon", "\316\265" },
+  { "lozf", "\342\247\253" },
+  { "Nfr", "\360\235\224\221" },
+  { "boxUL", "\342\225\235" },
+  { "REG", "\302\256" },
+  { "ii", "\342\205\210" },
+  { 0, 0 },
+  { 0, 0 },
+  { "angmsdae", "\342\246\254" },
+  { "nsube", "\342\212\210" },
+  { "frac25", "\342\205\226" },
+  { "nle", "\342\211\260" },
+  { "rmoustache", "\342\216\261" },
+  { "topfork", "\342\253\232" },
+  { "nsub", "\342\212\204" },
+  { "lne", "\342\252\207" },
+  { "swarhk", "\342\244\246" },
+  { "mlcp", "\342\253\233" },
+  { "notin", "\342\210\211" },
+  { "subne", "\342\212\212" },
+  { "infintie", "\342\247\235" },
+  { "bumpe", "\342\211\217" },
+  { "nrarrw", "\342\206\235\314\270" },
+  { "tridot", "\342\227\254" },
+  { "dzcy", "\321\237" },
+  { "Bumpeq", "\342\211\216" },
+  { 0, 0 },
+  { "nprec", "\342\212\200" },
+  { "prnsim", "\342\213\250" },
+  { 0, 0 },
+  { "leftleftarrows", "\342\207\207" },
+  { 0, 0 },
+  { "Rcedil", "\305\226" },
+  { "acE", "\342\210\276\314\263" },
+  { "NotVerticalBar", "\342\210\244" },
+  { "searr", "\342\206\230" },
+  { "supE", "\342\253\206" },
+  { "LessSlantEqual", "\342\251\275" },
+  { 0, 0 },
+  { 0, 0 },
+  { "prnE", "\342\252\265" },
+  { "boxvH", "\342\225\252" },
+  { 0, 0 },
+  { "longrightarrow", "\342\237\266" },
+  { 0, 0 },
+  { "angmsdag", "\342\246\256" },
+  { 0, 0 },
+  { "xscr", "\360\235\223\215" },
+  { "boxh", "\342\224\200" },
+  { "wedge", "\342\210\247" },
+  { "Rarrtl", "\342\244\226" },
+  { "Tfr", "\360\235\224\227" },
+  { "Hopf", "\342\204\215" },
+  { "eqcirc", "\342\211\226" },
+  { "ratail", "\342\244\232" },
+  { "ulcorn", "\342\214\234" },
+  { "mDDot", "\342\210\272" },
+  { "npart", "\342\210\202\314\270" },
+  { "Ffr", "\360\235\224\211" },
+  { "rangle", "\342\237\251" },
+  { "harr", "\342\206\224" },
+  { 0, 0 },
+  { "NotSucceedsSlantEqual", "\342\213\241" },
+  { "iprod", "\342\250\274" },
+  { "operp", "\342\246\271" },
+  { "rarr", "\342\206\222" },
+  { "angrtvb", "\342\212\276" },
+  { "sung", "\342\231\252" },
+  { "cuesc", "\342\213\237" },
+  { 0, 0 },
+  { "upuparrows", "\342\207\210" },
+  { "backepsilon", "\317\266" },
+  { "rppolint", "\342\250\222" },
+  { "marker", "\342\226\256" },
+  { "trpezium", "\342\217\242" },
+  { 0, 0 },
+  { "ulcorner", "\342\214\234" },
+  { "preccurlyeq", "\342\211\274" },
+  { "compfn", "\342\210\230" },
+  { "triangleleft", "\342\227\203" },
+  { "Zfr", "\342\204\250" },
+  { 0, 0 },
+  { "dharl", "\342\207\203" },
+  { "scnap", "\342\252\272" },
+  { "varkappa", "\317\260" },
+  { "centerdot", "\302\267" },
+  { "capdot", "\342\251\200" },
+  { "lozenge", "\342\227\212" },
+  { "Int", "\342\210\254" },
+  { "cscr", "\360\235\222\270" },
+  { "rbrke", "\342\246\214" },
+  { "supe", "\342\212\207" },
+  { "fork", "\342\213\224" },
+  { "tau", "\317\204" },
+  { "blacksquare", "\342\226\252" },
+  { "tcedil", "\305\243" },
+  { "capbrcup", "\342\251\211" },
+  { "LowerRightArrow", "\342\206\230" },
+  { "larrtl", "\342\206\242" },
+  { "gtrapprox", "\342\252\206" },
+  { 0, 0 },
+  { "npr", "\342\212\200" },
+  { "Dagger", "\342\200\241" },
+  { "squ", "\342\226\241" },
+  { "nsim", "\342\211\201" },
+  { "eta", "\316\267" },
+  { "zscr", "\360\235\223\217" },
+  { 0, 0 },
+  { "timesb", "\342\212\240" },
+  { "bowtie", "\342\213\210" },
+  { "naturals", "\342\204\225" },
+  { 0, 0 },
+  { 0, 0 },
+  { "doteqdot", "\342\211\221" },
+  { "ncaron", "\305\210" },
+  { 0, 0 },
+  { "supnE", "\342\253\214" },
+  { "nVDash", "\342\212\257" },
+  { "Bfr", "\360\235\224\205" },
+  { "Xopf", "\360\235\225\217" },
+  { "eopf", "\360\235\225\226" },
+  { "harrcir", "\342\245\210" },
+  { "lesdotor", "\342\252\203" },
+  { "Vcy", "\320\222" },
+  { "rsquor", "\342\200\231" },
+  { 0, 0 },
+  { 0, 0 },
+  { "biguplus", "\342\250\204" },
+  { "nexists", "\342\210\204" },
+  { "Bscr", "\342\204\254" },
+  { "pertenk", "\342\200\261" },
+  { 0, 0 },
+  { "DiacriticalAcute", "\302\264" },
+  { "veeeq", "\342\211\232" },
+  { "dcy", "\320\264" },
+  { "phiv", "\317\225" },
+  { "ograve", "\303\262" },
+  { 0, 0 },
+  { "boxvl", "\342\224\244" },
+  { 0, 0 },
+  { "af", "\342\201\241" },
+  { "PrecedesEqual", "\342\252\257" },
+  { "Cup", "\342\213\223" },
+  { "nvrtrie", "\342\212\265\342\203\222" },
+  { 0, 0 },
+  { "NotGreaterTilde", "\342\211\265" },
+  { "ntriangleleft", "\342\213\252" },
+  { "lcaron", "\304\276" },
+  { "fjlig", "fj" },
+  { "elsdot", "\342\252\227" },
+  { "ngsim", "\342\211\265" },
+  { "square", "\342\226\241" },
+  { "leqq", "\342\211\246" },
+  { "breve", "\313\230" },
+  { "rtriltri", "\342\247\216" },
+  { "DifferentialD", "\342\205\206" },
+  { "RightUpVector", "\342\206\276" },
+  { "nGtv", "\342\211\253\314\270" },
+  { "profsurf", "\342\214\223" },
+  { "Lang", "\342\237\252" },
+  { "latail", "\342\244\231" },
+  { "supsetneqq", "\342\253\214" },
+  { "LessGreater", "\342\211\266" },
+  { 0, 0 },
+  { "telrec", "\342\214\225" },
+  { "jcirc", "\304\265" },
+  { 0, 0 },
+  { "LT", "<" },
+  { "numero", "\342\204\226" },
+  { "trianglerighteq", "\342\212\265" },
+  { "lharu", "\342\206\274" },
+  { 0, 0 },
+  { "Efr", "\360\235\224\210" },
+  { "llcorner", "\342\214\236" },
+  { 0, 0 },
+  { "loang", "\342\237\254" },
+  { 0, 0 },
+  { "lesdoto", "\342\252\201" },
+  { 0, 0 },
+  { "DiacriticalTilde", "\313\234" },
+  { 0, 0 },
+  { "circeq", "\342\211\227" },
+  { "iiint", "\342\210\255" },
+  { "ShortDownArrow", "\342\206\223" },
+  { "itilde", "\304\251" },
+  { "dwangle", "\342\246\246" },
+  { "ugrave", "\303\271" },
+  { 0, 0 },
+  { "gvnE", "\342\211\251\357\270\200" },
+  { "thetasym", "\317\221" },
+  { 0, 0 },
+  { "circ", "\313\206" },
+  { "uuarr", "\342\207\210" },
+  { "nvltrie", "\342\212\264\342\203\222" },
+  { "racute", "\305\225" },
+  { "amalg", "\342\250\277" },
+  { "nrtri", "\342\213\253" },
+  { "Lstrok", "\305\201" },
+  { "NotTildeFullEqual", "\342\211\207" },
+  { "Nopf", "\342\204\225" },
+  { "sfr", "\360\235\224\260" },
+  { "Gbreve", "\304\236" },
+  { "Agrave", "\303\200" },
+  { 0, 0 },
+  { 0, 0 },
+  { "TripleDot", "\342\203\233" },
+  { 0, 0 },
+  { 0, 0 },
+  { "aogon", "\304\205" },
+  { "heartsuit", "\342\231\245" },
+  { 0, 0 },
+  { "nltri", "\342\213\252" },
+  { "ctdot", "\342\213\257" },
+  { "Ycy", "\320\253" },
+  { "LJcy", "\320\211" },
+  { "gvertneqq", "\342\211\251\357\270\200" },
+  { "gsim", "\342\211\263" },
+  { "ThinSpace", "\342\200\211" },
+  { 0, 0 },
+  { "half", "\302\275" },
+  { "Chi", "\316\247" },
+  { 0, 0 },
+  { "phmmat", "\342\204\263" },
+  { 0, 0 },
+  { 0, 0 },
+  { "cong", "\342\211\205" },
+  { "OpenCurlyQuote", "\342\200\230" },
+  { "Sum", "\342\210\221" },
+  { "frac35", "\342\205\227" },
+  { "orarr", "\342\206\273" },
+  { 0, 0 },
+  { "fltns", "\342\226\261" },
+  { "circlearrowleft", "\342\206\272" },
+  { "gE", "\342\211\247" },
+  { 0, 0 },
+  { 0, 0 },
+  { 0, 0 },
+  { "PlusMinus", "\302\261" },
+  { "UpDownArrow", "\342\206\225" },
+  { "isinE", "\342\213\271" },
+  { 0, 0 },
+  { "varpropto", "\342\210\235" },
+  { "bigsqcup", "\342\250\206" },
+  { "frac45", "\342\205\230" },
+  { "cedil", "\302\270" },
+  { "sbquo", "\342\200\232" },
+  { "gtquest", "\342\251\274" },
+  { "ngtr", "\342\211\257" },
+  { "uscr", "\360\235\223\212" },
+  { 0, 0 },
+  { "nvle", "\342\211\244\342\203\222" },
+  { "opar", "\342\246\267" },
+  { "vellip", "\342\213\256" },
+  { 0, 0 },
+  { 0, 0 },
+  { "OverBrace", "\342\217\236" },
+  { "dotsquare", "\342\212\241" },
+  { 0, 0 },
+  { "ohbar", "\342\246\265" },
+  { "frac56", "\342\205\232" },
+  { "SquareSubsetEqual", "\342\212\221" },
+  { "rightarrowtail", "\342\206\243" },
+  { "Qfr", "\360\235\224\224" },
+  { "wfr", "\360\235\224\264" },
+  { 0, 0 },
+  { "leftharpoondown", "\342\206\275" },
+  { "Sub", "\342\213\220" },
+  { "nrtrie", "\342\213\255" },
+  { "twoheadrightarrow", "\342\206\240" },
+  { "THORN", "\303\236" },
+  { "lneq", "\342\252\207" },
+  { "ltimes", "\342\213\211" },
+  { "LeftDoubleBracket", "\342\237\246" },
+  { "spades", "\342\231\240" },
+  { "curvearrowright", "\342\206\267" },
+  { "Kappa", "\316\232" },
+  { "aring", "\303\245" },
+  { "caps", "\342\210\251\357\270\200" },
+  { "pr", "\342\211\272" },
+  { "lessgtr", "\342\211\266" },
+  { "NotSubset", "\342\212\202\342\203\222" },
+  { "eDot", "\342\211\221" },
+  { "LeftTriangle", "\342\212\262" },
+  { 0, 0 },
+  { "lthree", "\342\213\213" },
+  { "TildeFullEqual", "\342\211\205" },
+  { "copysr", "\342\204\227" },
+  { "nsimeq", "\342\211\204" },
+  { "lcy", "\320\273" },
+  { 0, 0 },
+  { 0, 0 },
+  { "nequiv", "\342\211\242" },
+  { "pscr", "\360\235\223\205" },
+  { "between", "\342\211\254" },
+  { 0, 0 },
+  { "Dstrok", "\304\220" },
+  { 0, 0 },
+  { "omacr", "\305\215" },
+  { "utrif", "\342\226\264" },
+  { "angle", "\342\210\240" },
+  { 0, 0 },
+  { "AMP", "&" },
+  { "ecy", "\321\215" },
+  { "Uacute", "\303\232" },
+  { 0, 0 },
+  { "lbarr", "\342\244\214" },
+  { "xlArr", "\342\237\270" },
+  { "xwedge", "\342\213\200" },
+  { 0, 0 },
+  { "simeq", "\342\211\203" },
+  { "ltcc", "\342\252\246" },
+  { "gimel", "\342\204\267" },
+  { 0, 0 },
+  { "ofr", "\360\235\224\254" },
+  { "nvsim", "\342\210\274\342\203\222" },
+  { 0, 0 },
+  { "ltrif", "\342\227\202" },
+  { "rightthreetimes", "\342\213\214" },
+  { "Abreve", "\304\202" },
+  { "bbrktbrk", "\342\216\266" },
+  { "drcrop", "\342\214\214" },
+  { 0, 0 },
+  { "diams", "\342\231\246" },
+  { "bepsi", "\317\266" },
+  { "curarrm", "\342\244\274" },
+  { "apE", "\342\251\260" },
+  { 0, 0 },
+  { "emsp14", "\342\200\205" },
+  { "lvnE", "\342\211\250\357\270\200" },
+  { "Wedge", "\342\213\200" },
+  { "Cross", "\342\250\257" },
+  { "Equal", "\342\251\265" },
+};
+
+#endif
+
+#endif
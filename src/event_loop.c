@@ -0,0 +1,51 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "event_loop.h"
+
+#include <ncurses.h>
+#include <stdio.h>
+
+int event_getch(int busy) {
+  timeout(busy ? EVENT_TICK_MS : -1);
+  int ch = getch();
+  timeout(-1);
+  return ch;
+}
+
+void event_progress(FetchJob* job, char* out, size_t size) {
+  long long received, expected;
+  fetcher_progress(job, &received, &expected);
+
+  int mb = (expected > 0 ? expected : received) >= 1024 * 1024;
+  const char* unit = mb ? "MB" : "KB";
+  double scale = mb ? 1024.0 * 1024.0 : 1024.0;
+
+  if (expected > 0) snprintf(out, size, "%.1f of %.1f %s", received / scale, expected / scale, unit);
+  else if (received > 0) snprintf(out, size, "%.1f %s", received / scale, unit);
+  else snprintf(out, size, "connecting");
+}
+
+FetchState event_await(FetchJob* job, const char* label) {
+  if (!job) return FETCH_FAILED;
+
+  FetchState state;
+  while ((state = fetcher_state(job)) == FETCH_QUEUED || state == FETCH_RUNNING) {
+    char progress[64];
+    event_progress(job, progress, sizeof(progress));
+
+    int rows = getmaxy(stdscr);
+    move(rows - 1, 0);
+    clrtoeol();
+    attron(COLOR_PAIR(2));
+    mvprintw(rows - 1, 2, "%s  %s   Esc Cancel", label, progress);
+    attroff(COLOR_PAIR(2));
+    refresh();
+
+    int ch = event_getch(1);
+    if (ch == 27 || ch == 'q') {
+      fetcher_cancel(job);
+      return fetcher_wait(job);
+    }
+  }
+  return state;
+}
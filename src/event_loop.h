@@ -0,0 +1,31 @@
+#ifndef EVENT_LOOP_H
+#define EVENT_LOOP_H
+
+#include <stddef.h>
+
+#include "fetcher.h"
+
+// Longest a screen sleeps in getch() while something it shows is loading
+#define EVENT_TICK_MS 50
+
+/**
+ * The UI thread never performs a transfer itself: requests go to the
+ * fetcher's worker, and screens keep reading keys while they run, waking
+ * every EVENT_TICK_MS to redraw progress. A key is therefore handled
+ * within one tick however slow the network is, and Esc can always cancel.
+ */
+
+// getch() that wakes up every EVENT_TICK_MS while busy; ERR on a tick
+int event_getch(int busy);
+
+// "12.3 KB" or "1.2 of 3.4 MB": what a job has received so far
+void event_progress(FetchJob* job, char* out, size_t size);
+
+/**
+ * Waits for a job a screen can do nothing without, showing label and
+ * progress on the bottom row. Esc or q cancels it; the screen underneath
+ * is left as it was. Returns how the job ended.
+ */
+FetchState event_await(FetchJob* job, const char* label);
+
+#endif
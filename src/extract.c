@@ -0,0 +1,203 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "extract.h"
+#include "textscan.h"
+#include "entity.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+enum {
+  SEEK_MARKER,  // Looking for id="chapterText"
+  SEEK_TAG_END, // Inside the opening tag, waiting for '>'
+  IN_TEXT,      // Copying text until the next '<'
+  IN_ENTITY     // Buffering an &...; sequence
+};
+
+void extractor_init(ChapterExtractor* ex, paragraph_fn on_paragraph, void* userdata) {
+  memset(ex, 0, sizeof(*ex));
+  ex->state = SEEK_MARKER;
+  ex->on_paragraph = on_paragraph;
+  ex->userdata = userdata;
+}
+
+static int reserve(ChapterExtractor* ex, size_t extra) {
+  if (ex->len + extra < ex->cap) return 1;
+
+  size_t cap = ex->cap ? ex->cap : 4096;
+  while (ex->len + extra >= cap) cap *= 2;
+  char* ptr = realloc(ex->text, cap);
+  if (!ptr) {
+    ex->failed = 1;
+    return 0;
+  }
+  ex->text = ptr;
+  ex->cap = cap;
+  return 1;
+}
+
+static int put(ChapterExtractor* ex, char c) {
+  if (!reserve(ex, 1)) return 0;
+  ex->text[ex->len++] = c;
+  return 1;
+}
+
+static void put_span(ChapterExtractor* ex, const char* data, size_t len) {
+  if (!reserve(ex, len)) return;
+  memcpy(ex->text + ex->len, data, len);
+  ex->len += len;
+}
+
+// Collapses whitespace runs into one space, never at the start of a line
+static void flush_space(ChapterExtractor* ex) {
+  if (ex->space_pending && ex->text[ex->len - 1] != '\n') put(ex, ' ');
+  ex->space_pending = 0;
+}
+
+static void flush_entity(ChapterExtractor* ex) {
+  char decoded[ENTITY_OUT_MAX];
+  size_t decoded_len = 0;
+  size_t used = entity_decode(ex->entity, ex->entity_len, decoded, &decoded_len);
+
+  if (used) {
+    // A non-breaking space reads better as an ordinary one
+    if (decoded_len == 2 && memcmp(decoded, "\xC2\xA0", 2) == 0) put(ex, ' ');
+    else put_span(ex, decoded, decoded_len);
+  }
+  // Whatever didn't belong to a known entity is ordinary text
+  for (size_t i = used; i < ex->entity_len; i++) put(ex, ex->entity[i]);
+
+  ex->entity_len = 0;
+  ex->state = IN_TEXT;
+}
+
+static void end_block(ChapterExtractor* ex) {
+  // Add paragraph break (double newline)
+  if (ex->len > 0 && ex->text[ex->len - 1] != '\n') {
+    size_t para_end = ex->len;
+    put(ex, '\n');
+    put(ex, '\n');
+    if (ex->on_paragraph && !ex->failed)
+      ex->on_paragraph(ex->text + ex->para_start, para_end - ex->para_start, ex->userdata);
+  }
+  ex->para_start = ex->len;
+  ex->state = SEEK_MARKER;
+  ex->marker_pos = 0;
+}
+
+static void text_char(ChapterExtractor* ex, char c) {
+  if (c == '<') {
+    end_block(ex);
+  } else if (textscan_is_space(c)) {
+    if (ex->len > 0) ex->space_pending = 1;
+  } else if (c == '&') {
+    flush_space(ex);
+    ex->entity[0] = '&';
+    ex->entity_len = 1;
+    ex->state = IN_ENTITY;
+  } else {
+    flush_space(ex);
+    put(ex, c);
+  }
+}
+
+/**
+ * Plain text spans, the gaps between markers and tag bodies are skipped or
+ * copied in bulk (textscan_plain_run / memchr); only the bytes that change
+ * state go through the per-character paths.
+ */
+int extractor_feed(ChapterExtractor* ex, const char* data, size_t len) {
+  static const char marker[] = EXTRACT_MARKER;
+  size_t i = 0;
+
+  while (i < len && !ex->failed) {
+    switch (ex->state) {
+      case SEEK_MARKER: {
+        if (ex->marker_pos == 0) {
+          const char* hit = memchr(data + i, marker[0], len - i);
+          if (!hit) return 1;
+          i = hit - data;
+        }
+        char c = data[i++];
+        // The marker's first character never recurs in it, so a mismatch
+        // can only restart the match at this very byte
+        if (c == marker[ex->marker_pos]) {
+          if (++ex->marker_pos == sizeof(marker) - 1) {
+            ex->state = SEEK_TAG_END;
+            ex->marker_pos = 0;
+          }
+        } else {
+          ex->marker_pos = (c == marker[0]) ? 1 : 0;
+        }
+        break;
+      }
+
+      case SEEK_TAG_END: {
+        const char* gt = memchr(data + i, '>', len - i);
+        if (!gt) return 1;
+        i = gt - data + 1;
+        ex->state = IN_TEXT;
+        ex->space_pending = 0;
+        break;
+      }
+
+      case IN_TEXT: {
+        while (i < len && ex->state == IN_TEXT && !ex->failed) {
+          // A run may not open with a space: it could be leading or follow
+          // a collapsed run, and only text_char() knows which
+          size_t run = (data[i] == ' ') ? 0 : textscan_plain_run(data + i, len - i);
+          if (run > 0) {
+            flush_space(ex);
+            put_span(ex, data + i, run);
+            i += run;
+          } else {
+            text_char(ex, data[i++]);
+          }
+        }
+        break;
+      }
+
+      case IN_ENTITY: {
+        char c = data[i++];
+        if (c == ';') {
+          ex->entity[ex->entity_len++] = c;
+          flush_entity(ex);
+        } else if ((isalnum((unsigned char)c) || c == '#') && ex->entity_len < EXTRACT_ENTITY_MAX - 1) {
+          ex->entity[ex->entity_len++] = c;
+        } else {
+          flush_entity(ex);
+          text_char(ex, c);
+        }
+        break;
+      }
+    }
+  }
+  return !ex->failed;
+}
+
+size_t extractor_write(void* data, size_t size, size_t nmemb, void* userdata) {
+  size_t len = size * nmemb;
+  return extractor_feed(userdata, data, len) ? len : 0;
+}
+
+char* extractor_finish(ChapterExtractor* ex, size_t* len) {
+  if (ex->state == IN_ENTITY) flush_entity(ex);
+  if (ex->state == IN_TEXT) end_block(ex);
+
+  if (ex->failed || !put(ex, '\0')) {
+    extractor_free(ex);
+    return NULL;
+  }
+
+  char* text = ex->text;
+  if (len) *len = ex->len - 1;
+  ex->text = NULL;
+  extractor_free(ex);
+  return text;
+}
+
+void extractor_free(ChapterExtractor* ex) {
+  free(ex->text);
+  extractor_init(ex, ex->on_paragraph, ex->userdata);
+}
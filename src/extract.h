@@ -0,0 +1,49 @@
+#ifndef EXTRACT_H
+#define EXTRACT_H
+
+#include <stddef.h>
+
+#include "entity.h"
+
+#define EXTRACT_MARKER "id=\"chapterText\""
+#define EXTRACT_ENTITY_MAX ENTITY_REF_MAX
+
+typedef void (*paragraph_fn)(const char* text, size_t len, void* userdata);
+
+/**
+ * Resumable extractor for the text inside id="chapterText" blocks. Bytes
+ * can be fed in arbitrary chunks (straight from a curl write callback); the
+ * state machine carries marker matches and half-read entities across chunk
+ * boundaries, so the page HTML is never held in memory.
+ */
+typedef struct {
+  int state;
+  size_t marker_pos;     // Bytes of EXTRACT_MARKER matched so far
+  int space_pending;
+  char entity[EXTRACT_ENTITY_MAX];
+  size_t entity_len;
+
+  char* text;            // Cleaned output, paragraphs separated by "\n\n"
+  size_t len;
+  size_t cap;
+  size_t para_start;     // Where the paragraph being built begins
+  int failed;
+
+  paragraph_fn on_paragraph; // Optional, called for each finished block
+  void* userdata;
+} ChapterExtractor;
+
+void extractor_init(ChapterExtractor* ex, paragraph_fn on_paragraph, void* userdata);
+
+// Consumes the next chunk; returns 0 once the extractor ran out of memory
+int extractor_feed(ChapterExtractor* ex, const char* data, size_t len);
+
+// curl CURLOPT_WRITEFUNCTION adapter, userdata is the ChapterExtractor
+size_t extractor_write(void* data, size_t size, size_t nmemb, void* userdata);
+
+// Returns the extracted text (caller frees) and resets the extractor
+char* extractor_finish(ChapterExtractor* ex, size_t* len);
+
+void extractor_free(ChapterExtractor* ex);
+
+#endif
@@ -0,0 +1,398 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "fetcher.h"
+#include "http.h"
+
+#include <curl/curl.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+struct FetchJob {
+  char* url;
+  FetchPriority priority;
+  FetchState state;
+  int cancel_requested;
+  int refs;
+
+  FetchSink sink;
+  struct curl_slist* request_headers;
+  char* body;
+  size_t size;
+
+  long long received;    // Bytes on the wire so far, and in all if known
+  long long expected;
+
+  CURL* handle;
+  HttpSink http_sink;
+  struct FetchJob* next; // Pending queue link
+};
+
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t finished = PTHREAD_COND_INITIALIZER;
+static pthread_t worker;
+static int worker_running = 0;
+static int stopping = 0;
+
+static CURLM* multi = NULL;
+static FetchJob* pending = NULL;
+static FetchJob* active[FETCHER_MAX_TRANSFERS];
+static int active_count = 0;
+
+static void job_unref(FetchJob* job) {
+  if (--job->refs > 0) return;
+  free(job->url);
+  free(job->body);
+  curl_slist_free_all(job->request_headers);
+  free(job);
+}
+
+static size_t job_header(char* data, size_t size, size_t nmemb, void* userp) {
+  FetchJob* job = userp;
+  job->sink.header(data, size * nmemb, job->sink.userdata);
+  return size * nmemb;
+}
+
+static size_t job_write(void* data, size_t size, size_t nmemb, void* userp) {
+  FetchJob* job = userp;
+  size_t len = size * nmemb;
+
+  pthread_mutex_lock(&lock);
+  int cancelled = job->cancel_requested;
+  pthread_mutex_unlock(&lock);
+
+  if (cancelled) return 0;
+  if (job->sink.write) return job->sink.write(data, len, job->sink.userdata);
+
+  char* ptr = realloc(job->body, job->size + len + 1);
+  if (!ptr) return 0;
+  job->body = ptr;
+  memcpy(job->body + job->size, data, len);
+  job->size += len;
+  job->body[job->size] = '\0';
+  return len;
+}
+
+// Also aborts a cancelled transfer that is still connecting or stalled
+static int job_progress(void* userp, curl_off_t dltotal, curl_off_t dlnow, curl_off_t ultotal, curl_off_t ulnow) {
+  (void) ultotal;
+  (void) ulnow;
+  FetchJob* job = userp;
+
+  pthread_mutex_lock(&lock);
+  job->received = dlnow;
+  job->expected = dltotal;
+  int cancelled = job->cancel_requested;
+  pthread_mutex_unlock(&lock);
+  return cancelled;
+}
+
+/**
+ * Called on the worker with the lock held. The sink's done callback runs
+ * unlocked so slow consumers don't stall the UI thread; the job only turns
+ * terminal afterwards, so waiters never see a half-finished result.
+ */
+static void job_finish(FetchJob* job, FetchState state) {
+  if (job->handle) {
+    curl_multi_remove_handle(multi, job->handle);
+    http_release(job->handle);
+    job->handle = NULL;
+  }
+  if (job->cancel_requested) state = FETCH_CANCELLED;
+
+  if (job->sink.done) {
+    pthread_mutex_unlock(&lock);
+    job->sink.done(state == FETCH_DONE, job->sink.userdata);
+    pthread_mutex_lock(&lock);
+  }
+
+  job->state = state;
+  pthread_cond_broadcast(&finished);
+  job_unref(job);
+}
+
+// Finishes queued jobs nobody wants any more, so they don't wait for a slot
+static void reap_pending(void) {
+  FetchJob** link = &pending;
+  while (*link) {
+    FetchJob* job = *link;
+    if (!job->cancel_requested) {
+      link = &job->next;
+      continue;
+    }
+    *link = job->next;
+    job->next = NULL;
+    job_finish(job, FETCH_CANCELLED);
+    link = &pending; // The queue may have changed while the lock was dropped
+  }
+}
+
+static int active_speculative(void) {
+  int n = 0;
+  for (int i = 0; i < active_count; i++) n += active[i]->priority == FETCH_PRIORITY_PREFETCH;
+  return n;
+}
+
+static void start_pending(void) {
+  while (pending && active_count < FETCHER_MAX_TRANSFERS) {
+    FetchJob* job = pending;
+    // The queue is in priority order, so everything behind is speculative too
+    if (job->priority == FETCH_PRIORITY_PREFETCH && active_speculative() >= FETCHER_MAX_SPECULATIVE) break;
+    pending = job->next;
+    job->next = NULL;
+
+    if (job->cancel_requested) {
+      job_finish(job, FETCH_CANCELLED);
+      continue;
+    }
+
+    job->handle = http_handle();
+    if (!job->handle) {
+      job_finish(job, FETCH_FAILED);
+      continue;
+    }
+
+    curl_easy_setopt(job->handle, CURLOPT_URL, job->url);
+    http_set_sink(job->handle, &job->http_sink, job_write, job);
+    // A stalled transfer fails; a slow one, e.g. a whole book, goes on
+    // for as long as the user leaves it running
+    curl_easy_setopt(job->handle, CURLOPT_CONNECTTIMEOUT, 15L);
+    curl_easy_setopt(job->handle, CURLOPT_LOW_SPEED_LIMIT, 1L);
+    curl_easy_setopt(job->handle, CURLOPT_LOW_SPEED_TIME, 30L);
+    curl_easy_setopt(job->handle, CURLOPT_XFERINFOFUNCTION, job_progress);
+    curl_easy_setopt(job->handle, CURLOPT_XFERINFODATA, job);
+    curl_easy_setopt(job->handle, CURLOPT_NOPROGRESS, 0L);
+    curl_easy_setopt(job->handle, CURLOPT_SSL_VERIFYPEER, 0L);
+    if (job->request_headers) curl_easy_setopt(job->handle, CURLOPT_HTTPHEADER, job->request_headers);
+    if (job->sink.header) {
+      curl_easy_setopt(job->handle, CURLOPT_HEADERFUNCTION, job_header);
+      curl_easy_setopt(job->handle, CURLOPT_HEADERDATA, job);
+    }
+
+    job->state = FETCH_RUNNING;
+    active[active_count++] = job;
+    curl_multi_add_handle(multi, job->handle);
+  }
+}
+
+// Insert after every job of the same or higher priority
+static void enqueue(FetchJob* job) {
+  FetchJob** link = &pending;
+  while (*link && (*link)->priority <= job->priority) link = &(*link)->next;
+  job->next = *link;
+  *link = job;
+}
+
+static void drop_active(FetchJob* job) {
+  for (int i = 0; i < active_count; i++) {
+    if (active[i] == job) {
+      active[i] = active[--active_count];
+      return;
+    }
+  }
+}
+
+static void* worker_main(void* arg) {
+  (void) arg;
+
+  pthread_mutex_lock(&lock);
+  while (!stopping) {
+    // Reap transfers the UI asked us to abandon
+    for (int i = active_count - 1; i >= 0; i--) {
+      FetchJob* job = active[i];
+      if (job->cancel_requested) {
+        drop_active(job);
+        job_finish(job, FETCH_CANCELLED);
+      }
+    }
+    reap_pending();
+    start_pending();
+    pthread_mutex_unlock(&lock);
+
+    int running = 0;
+    curl_multi_perform(multi, &running);
+    curl_multi_poll(multi, NULL, 0, 200, NULL);
+    curl_multi_perform(multi, &running);
+
+    pthread_mutex_lock(&lock);
+    CURLMsg* msg;
+    int left;
+    while ((msg = curl_multi_info_read(multi, &left))) {
+      if (msg->msg != CURLMSG_DONE) continue;
+
+      HttpSink* http_sink = NULL;
+      curl_easy_getinfo(msg->easy_handle, CURLINFO_PRIVATE, (char**)&http_sink);
+      if (!http_sink) continue;
+      FetchJob* job = http_sink->userdata;
+
+      http_record_transfer(msg->easy_handle, msg->data.result);
+
+      drop_active(job);
+      job_finish(job, msg->data.result == CURLE_OK ? FETCH_DONE : FETCH_FAILED);
+    }
+  }
+
+  // Fail whatever is left so nobody waits forever
+  while (active_count > 0) {
+    FetchJob* job = active[--active_count];
+    job_finish(job, FETCH_FAILED);
+  }
+  while (pending) {
+    FetchJob* job = pending;
+    pending = job->next;
+    job_finish(job, FETCH_FAILED);
+  }
+  pthread_mutex_unlock(&lock);
+  return NULL;
+}
+
+static int ensure_worker(void) {
+  if (worker_running) return 1;
+
+  multi = curl_multi_init();
+  if (!multi) return 0;
+  curl_multi_setopt(multi, CURLMOPT_MAX_TOTAL_CONNECTIONS, (long)FETCHER_MAX_TRANSFERS);
+
+  stopping = 0;
+  if (pthread_create(&worker, NULL, worker_main, NULL) != 0) {
+    curl_multi_cleanup(multi);
+    multi = NULL;
+    return 0;
+  }
+  worker_running = 1;
+  return 1;
+}
+
+FetchJob* fetcher_submit(const char* url, FetchPriority priority, const FetchSink* sink) {
+  FetchJob* job = calloc(1, sizeof(FetchJob));
+  if (!job) return NULL;
+
+  job->url = strdup(url);
+  job->priority = priority;
+  job->state = FETCH_QUEUED;
+  job->refs = 2; // Caller + worker
+  int ok = job->url != NULL;
+  if (sink) {
+    job->sink = *sink;
+    for (const char* const* h = sink->request_headers; ok && h && *h; h++) {
+      struct curl_slist* list = curl_slist_append(job->request_headers, *h);
+      if (list) job->request_headers = list;
+      else ok = 0;
+    }
+    job->sink.request_headers = NULL;
+  }
+
+  pthread_mutex_lock(&lock);
+  if (!ok || !ensure_worker()) {
+    pthread_mutex_unlock(&lock);
+    curl_slist_free_all(job->request_headers);
+    free(job->url);
+    free(job);
+    return NULL;
+  }
+
+  enqueue(job);
+  pthread_mutex_unlock(&lock);
+
+  curl_multi_wakeup(multi);
+  return job;
+}
+
+FetchState fetcher_state(FetchJob* job) {
+  pthread_mutex_lock(&lock);
+  FetchState state = job->state;
+  pthread_mutex_unlock(&lock);
+  return state;
+}
+
+void fetcher_progress(FetchJob* job, long long* received, long long* expected) {
+  pthread_mutex_lock(&lock);
+  *received = job->received;
+  *expected = job->expected;
+  pthread_mutex_unlock(&lock);
+}
+
+FetchState fetcher_wait(FetchJob* job) {
+  pthread_mutex_lock(&lock);
+  while (job->state == FETCH_QUEUED || job->state == FETCH_RUNNING)
+    pthread_cond_wait(&finished, &lock);
+  FetchState state = job->state;
+  pthread_mutex_unlock(&lock);
+  return state;
+}
+
+void fetcher_promote(FetchJob* job) {
+  pthread_mutex_lock(&lock);
+  if (job->priority != FETCH_PRIORITY_FOREGROUND) {
+    job->priority = FETCH_PRIORITY_FOREGROUND;
+
+    // A queued job moves up behind the other foreground work; a running
+    // one just stops counting against the speculative slots
+    if (job->state == FETCH_QUEUED) {
+      FetchJob** link = &pending;
+      while (*link && *link != job) link = &(*link)->next;
+      if (*link) {
+        *link = job->next;
+        enqueue(job);
+      }
+    }
+  }
+  pthread_mutex_unlock(&lock);
+  if (multi) curl_multi_wakeup(multi);
+}
+
+void fetcher_cancel(FetchJob* job) {
+  pthread_mutex_lock(&lock);
+  job->cancel_requested = 1;
+  pthread_mutex_unlock(&lock);
+  if (multi) curl_multi_wakeup(multi);
+}
+
+char* fetcher_take_body(FetchJob* job, size_t* size) {
+  pthread_mutex_lock(&lock);
+  char* body = job->body;
+  if (size) *size = job->size;
+  job->body = NULL;
+  job->size = 0;
+  pthread_mutex_unlock(&lock);
+  return body;
+}
+
+void fetcher_release(FetchJob* job) {
+  if (!job) return;
+
+  pthread_mutex_lock(&lock);
+  if (job->state == FETCH_QUEUED || job->state == FETCH_RUNNING)
+    job->cancel_requested = 1;
+  job_unref(job);
+  pthread_mutex_unlock(&lock);
+  if (multi) curl_multi_wakeup(multi);
+}
+
+int fetcher_abandon(FetchJob* job, pthread_mutex_t* lock, const int* finished, int* orphaned) {
+  pthread_mutex_lock(lock);
+  int done = *finished;
+  *orphaned = 1;
+  pthread_mutex_unlock(lock);
+
+  // Past the unlock the userdata may already be gone; job was read before
+  fetcher_release(job);
+  return done;
+}
+
+void fetcher_shutdown(void) {
+  pthread_mutex_lock(&lock);
+  if (!worker_running) {
+    pthread_mutex_unlock(&lock);
+    return;
+  }
+  stopping = 1;
+  pthread_mutex_unlock(&lock);
+
+  curl_multi_wakeup(multi);
+  pthread_join(worker, NULL);
+
+  curl_multi_cleanup(multi);
+  multi = NULL;
+  worker_running = 0;
+}
@@ -0,0 +1,76 @@
+#ifndef FETCHER_H
+#define FETCHER_H
+
+#include <pthread.h>
+#include <stddef.h>
+
+#define FETCHER_MAX_TRANSFERS 4
+// Transfers speculative work may hold at once; the rest are kept for
+// whatever the user asks for next
+#define FETCHER_MAX_SPECULATIVE (FETCHER_MAX_TRANSFERS - 1)
+
+typedef enum {
+  FETCH_PRIORITY_FOREGROUND = 0, // Something the user is waiting on
+  FETCH_PRIORITY_PREFETCH = 1    // Speculative work, served after foreground
+} FetchPriority;
+
+typedef enum {
+  FETCH_QUEUED,
+  FETCH_RUNNING,
+  FETCH_DONE,
+  FETCH_FAILED,
+  FETCH_CANCELLED
+} FetchState;
+
+/**
+ * Optional body consumer. The callbacks run on the worker thread: header
+ * sees each response header line, status lines included; write receives
+ * the body as it arrives (return len to continue); done is called once
+ * with ok != 0 when the transfer succeeded. request_headers is a
+ * NULL-terminated list of extra "Name: value" lines, copied at submit.
+ */
+typedef struct {
+  void (*header)(const char* line, size_t len, void* userdata);
+  size_t (*write)(const char* data, size_t len, void* userdata);
+  void (*done)(int ok, void* userdata);
+  void* userdata;
+  const char* const* request_headers;
+} FetchSink;
+
+typedef struct FetchJob FetchJob;
+
+// Queues a GET; with a NULL sink the body is collected in memory
+FetchJob* fetcher_submit(const char* url, FetchPriority priority, const FetchSink* sink);
+
+FetchState fetcher_state(FetchJob* job);
+
+// Bytes received so far and, when the server said, in all (else 0)
+void fetcher_progress(FetchJob* job, long long* received, long long* expected);
+
+// Blocks until the job has finished, failed or been cancelled
+FetchState fetcher_wait(FetchJob* job);
+
+// Makes a speculative job one the user is waiting on, moving it up the queue
+void fetcher_promote(FetchJob* job);
+
+// Stops a queued or running job; the sink's done callback still fires
+void fetcher_cancel(FetchJob* job);
+
+// Hands over the in-memory body (NULL-terminated), caller frees
+char* fetcher_take_body(FetchJob* job, size_t* size);
+
+// Drops the caller's reference, cancelling the job if it is still active
+void fetcher_release(FetchJob* job);
+
+/**
+ * Gives up on a job whose sink userdata the done callback frees once
+ * *orphaned is set. Both flags are guarded by lock. Returns 1 if the
+ * callback already ran and the caller must free the userdata; otherwise
+ * the callback frees it, and the caller must not touch it again.
+ */
+int fetcher_abandon(FetchJob* job, pthread_mutex_t* lock, const int* finished, int* orphaned);
+
+// Stops the worker thread and fails every outstanding job
+void fetcher_shutdown(void);
+
+#endif
@@ -0,0 +1,1232 @@
+#define _POSIX_C_SOURCE 200809L
+#define _DEFAULT_SOURCE // _SC_NPROCESSORS_ONLN
+
+#include "fulltext.h"
+#include "controller.h"
+#include "chapter_cache.h"
+#include "crc32.h"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <math.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+/*
+ * Segment layout, integers in host byte order:
+ *
+ *   "NCX1"  u32 crc  u32 doc_count  u32 term_count
+ *   u64 meta_off  u64 dict_off  u64 offsets_off
+ *   postings, one run per term, df x {
+ *     varint doc_delta  varint tf  varint positions_len  tf x varint pos_delta }
+ *   doc_count x { u8 flags  u8 kind  u16 name_len  u32 length  i64 mtime  u64 size  name }
+ *   term_count x { u8 len  term  u32 df  u64 postings_off  u64 postings_len }, sorted
+ *   term_count x u32 offset of the entry above from dict_off
+ *
+ * The CRC covers everything from meta_off on, so opening a segment checks
+ * its tables without reading the postings. Segments never change: an
+ * update writes a new one, whose documents replace older entries under
+ * the same name and whose tombstones (DOC_DELETED) remove them.
+ */
+#define SEGMENT_MAGIC "NCX1"
+#define SEGMENT_HEADER 40
+#define DOC_RECORD 24
+#define DOC_DELETED 1
+
+#define MANIFEST "segments"
+#define INDEX_MEMORY ((size_t)256 << 20) // Builder memory across all indexing threads
+#define SMALL_SEGMENT ((size_t)4 << 20)
+#define MERGE_AT 8                     // Small segments at the end that get merged
+#define MAX_SEGMENTS 64                // Past this everything is merged
+#define MAX_QUERY_TERMS 16
+#define BM25_K1 1.2
+#define BM25_B 0.75
+
+typedef struct {
+  unsigned char* data;
+  size_t len, cap;
+} Buf;
+
+static int buf_grow(Buf* b, size_t more) {
+  if (b->len + more <= b->cap) return 1;
+  size_t cap = b->cap ? b->cap : 16;
+  while (cap < b->len + more) cap *= 2;
+  unsigned char* ptr = realloc(b->data, cap);
+  if (!ptr) return 0;
+  b->data = ptr;
+  b->cap = cap;
+  return 1;
+}
+
+static int buf_put(Buf* b, const void* data, size_t n) {
+  if (n == 0) return 1;
+  if (!buf_grow(b, n)) return 0;
+  memcpy(b->data + b->len, data, n);
+  b->len += n;
+  return 1;
+}
+
+static int buf_varint(Buf* b, uint64_t v) {
+  unsigned char tmp[10];
+  int n = 0;
+  do {
+    tmp[n] = v & 0x7F;
+    v >>= 7;
+    if (v) tmp[n] |= 0x80;
+    n++;
+  } while (v);
+  return buf_put(b, tmp, n);
+}
+
+// Leaves *p at end if the number runs past it
+static uint64_t get_varint(const unsigned char** p, const unsigned char* end) {
+  uint64_t v = 0;
+  for (int shift = 0; *p < end && shift < 64; shift += 7) {
+    unsigned char c = *(*p)++;
+    v |= (uint64_t)(c & 0x7F) << shift;
+    if (!(c & 0x80)) return v;
+  }
+  *p = end;
+  return v;
+}
+
+// ---- Terms ----
+
+static int is_word(unsigned char c) {
+  return (c >= '0' && c <= '9') || ((c | 0x20) >= 'a' && (c | 0x20) <= 'z') || c >= 0x80;
+}
+
+// Length of the UTF-8 punctuation at p (curly quotes, dashes, nbsp, guillemets), or 0
+static size_t punct_len(const char* s, size_t len, size_t p) {
+  const unsigned char* u = (const unsigned char*)s + p;
+  if (len - p >= 3 && u[0] == 0xE2 && u[1] == 0x80) return 3;
+  if (len - p >= 2 && u[0] == 0xC2 && u[1] >= 0xA0 && u[1] <= 0xBF) return 2;
+  return 0;
+}
+
+// Next word at or after *i, ASCII case folded into term; returns its length, 0 at the end
+static size_t next_term(const char* s, size_t len, size_t* i, char* term) {
+  size_t p = *i;
+  while (p < len) {
+    size_t skip = is_word(s[p]) ? punct_len(s, len, p) : 1;
+    if (!skip) break;
+    p += skip;
+  }
+
+  size_t n = 0;
+  while (p < len && is_word(s[p]) && !punct_len(s, len, p)) {
+    unsigned char c = s[p++];
+    if (n < FULLTEXT_TERM_MAX) term[n++] = c >= 'A' && c <= 'Z' ? c + ('a' - 'A') : c;
+  }
+  *i = p;
+  return n;
+}
+
+static uint32_t hash_bytes(const char* s, size_t len, uint32_t h) {
+  for (size_t i = 0; i < len; i++) h = (h ^ (unsigned char)s[i]) * 16777619u;
+  return h;
+}
+
+static int compare_terms(const char* a, size_t alen, const char* b, size_t blen) {
+  int c = memcmp(a, b, alen < blen ? alen : blen);
+  if (c) return c;
+  return (alen > blen) - (alen < blen);
+}
+
+// ---- Building a segment ----
+
+typedef struct {
+  char term[FULLTEXT_TERM_MAX];
+  uint8_t len;
+  uint32_t df;
+  uint32_t last_doc;
+  Buf postings;
+  // In the document being added
+  Buf positions;
+  uint32_t tf;
+  uint32_t last_pos;
+} Term;
+
+typedef struct {
+  Term* terms;
+  int count, cap;
+  int* table;          // Open addressing over terms, index + 1
+  int table_size;
+  int* touched;        // Terms in the document being added
+  int touched_count, touched_cap;
+  Buf docs;
+  uint32_t doc_count;
+  size_t bytes;        // Roughly what all of this takes
+} Builder;
+
+static void builder_free(Builder* b) {
+  for (int i = 0; i < b->count; i++) {
+    free(b->terms[i].postings.data);
+    free(b->terms[i].positions.data);
+  }
+  free(b->terms);
+  free(b->table);
+  free(b->touched);
+  free(b->docs.data);
+  memset(b, 0, sizeof(*b));
+}
+
+static Term* builder_term(Builder* b, const char* term, size_t len) {
+  if ((b->count + 1) * 2 > b->table_size) {
+    int size = b->table_size ? b->table_size * 2 : 4096;
+    int* table = calloc(size, sizeof(int));
+    if (!table) return NULL;
+    for (int i = 0; i < b->count; i++) {
+      uint32_t h = hash_bytes(b->terms[i].term, b->terms[i].len, 2166136261u) & (size - 1);
+      while (table[h]) h = (h + 1) & (size - 1);
+      table[h] = i + 1;
+    }
+    free(b->table);
+    b->table = table;
+    b->table_size = size;
+    b->bytes += size / 2 * sizeof(int);
+  }
+
+  uint32_t h = hash_bytes(term, len, 2166136261u) & (b->table_size - 1);
+  for (; b->table[h]; h = (h + 1) & (b->table_size - 1)) {
+    Term* t = &b->terms[b->table[h] - 1];
+    if (t->len == len && memcmp(t->term, term, len) == 0) return t;
+  }
+
+  if (b->count == b->cap) {
+    int cap = b->cap ? b->cap * 2 : 4096;
+    Term* ptr = realloc(b->terms, cap * sizeof(Term));
+    if (!ptr) return NULL;
+    b->terms = ptr;
+    b->cap = cap;
+    b->bytes += (cap - b->count) * sizeof(Term);
+  }
+  Term* t = &b->terms[b->count++];
+  memset(t, 0, sizeof(*t));
+  memcpy(t->term, term, len);
+  t->len = len;
+  b->table[h] = b->count;
+  return t;
+}
+
+static int builder_add(Builder* b, uint8_t flags, uint8_t kind, const char* name,
+                       int64_t mtime, uint64_t size, const char* text, size_t len) {
+  uint32_t doc = b->doc_count;
+  uint32_t length = 0;
+  char term[FULLTEXT_TERM_MAX];
+  size_t i = 0, n;
+
+  while ((n = next_term(text, len, &i, term)) > 0) {
+    Term* t = builder_term(b, term, n);
+    if (!t) return 0;
+    if (t->tf == 0) {
+      if (b->touched_count == b->touched_cap) {
+        int cap = b->touched_cap ? b->touched_cap * 2 : 1024;
+        int* ptr = realloc(b->touched, cap * sizeof(int));
+        if (!ptr) return 0;
+        b->touched = ptr;
+        b->touched_cap = cap;
+      }
+      b->touched[b->touched_count++] = t - b->terms;
+    }
+    size_t cap = t->positions.cap;
+    if (!buf_varint(&t->positions, t->tf ? length - t->last_pos : length)) return 0;
+    b->bytes += t->positions.cap - cap;
+    t->tf++;
+    t->last_pos = length++;
+  }
+
+  for (int k = 0; k < b->touched_count; k++) {
+    Term* t = &b->terms[b->touched[k]];
+    size_t cap = t->postings.cap;
+    if (!buf_varint(&t->postings, t->df ? doc - t->last_doc : doc) || !buf_varint(&t->postings, t->tf) ||
+        !buf_varint(&t->postings, t->positions.len) ||
+        !buf_put(&t->postings, t->positions.data, t->positions.len)) return 0;
+    b->bytes += t->postings.cap - cap;
+    t->df++;
+    t->last_doc = doc;
+    t->tf = 0;
+    t->positions.len = 0;
+  }
+  b->touched_count = 0;
+
+  unsigned char rec[DOC_RECORD];
+  uint16_t name_len = strlen(name);
+  rec[0] = flags;
+  rec[1] = kind;
+  memcpy(rec + 2, &name_len, 2);
+  memcpy(rec + 4, &length, 4);
+  memcpy(rec + 8, &mtime, 8);
+  memcpy(rec + 16, &size, 8);
+  if (!buf_put(&b->docs, rec, DOC_RECORD) || !buf_put(&b->docs, name, name_len)) return 0;
+  b->doc_count++;
+  return 1;
+}
+
+// Postings go straight to the file; the tables follow them
+typedef struct {
+  FILE* f;
+  char tmp[PATH_MAX + 32];
+  uint64_t off;
+  Buf dict;
+  Buf offsets;
+  uint32_t terms;
+} SegmentWriter;
+
+static int writer_open(SegmentWriter* w, const char* path) {
+  memset(w, 0, sizeof(*w));
+  snprintf(w->tmp, sizeof(w->tmp), "%s.tmp.XXXXXX", path);
+  int fd = mkstemp(w->tmp);
+  if (fd < 0) return 0;
+  w->f = fdopen(fd, "wb");
+  if (!w->f) {
+    close(fd);
+    unlink(w->tmp);
+    return 0;
+  }
+
+  unsigned char header[SEGMENT_HEADER] = {0};
+  w->off = SEGMENT_HEADER;
+  return fwrite(header, 1, SEGMENT_HEADER, w->f) == SEGMENT_HEADER;
+}
+
+static int writer_term(SegmentWriter* w, const char* term, uint8_t len, uint32_t df,
+                       const void* postings, uint64_t n) {
+  uint32_t at = w->dict.len;
+  if (fwrite(postings, 1, n, w->f) != n || !buf_put(&w->offsets, &at, 4) ||
+      !buf_put(&w->dict, &len, 1) || !buf_put(&w->dict, term, len) || !buf_put(&w->dict, &df, 4) ||
+      !buf_put(&w->dict, &w->off, 8) || !buf_put(&w->dict, &n, 8)) return 0;
+  w->off += n;
+  w->terms++;
+  return 1;
+}
+
+// Writes the tables and renames the file into place; ok = 0 just cleans up
+static int writer_close(SegmentWriter* w, int ok, const char* path, const Buf* docs, uint32_t doc_count) {
+  uint64_t meta_off = w->off;
+  uint64_t dict_off = meta_off + docs->len;
+  uint64_t offsets_off = dict_off + w->dict.len;
+
+  Buf meta = {0};
+  ok = ok && buf_grow(&meta, docs->len + w->dict.len + w->offsets.len) &&
+       buf_put(&meta, docs->data, docs->len) && buf_put(&meta, w->dict.data, w->dict.len) &&
+       buf_put(&meta, w->offsets.data, w->offsets.len) &&
+       fwrite(meta.data, 1, meta.len, w->f) == meta.len;
+
+  if (ok) {
+    unsigned char header[SEGMENT_HEADER];
+    uint32_t crc = crc32(meta.data, meta.len);
+    memcpy(header, SEGMENT_MAGIC, 4);
+    memcpy(header + 4, &crc, 4);
+    memcpy(header + 8, &doc_count, 4);
+    memcpy(header + 12, &w->terms, 4);
+    memcpy(header + 16, &meta_off, 8);
+    memcpy(header + 24, &dict_off, 8);
+    memcpy(header + 32, &offsets_off, 8);
+    ok = fseek(w->f, 0, SEEK_SET) == 0 && fwrite(header, 1, SEGMENT_HEADER, w->f) == SEGMENT_HEADER;
+  }
+
+  if (fclose(w->f) != 0) ok = 0;
+  if (!ok || rename(w->tmp, path) != 0) {
+    unlink(w->tmp);
+    ok = 0;
+  }
+  free(meta.data);
+  free(w->dict.data);
+  free(w->offsets.data);
+  return ok;
+}
+
+static int by_term(const void* a, const void* b) {
+  const Term* x = *(Term* const*)a;
+  const Term* y = *(Term* const*)b;
+  return compare_terms(x->term, x->len, y->term, y->len);
+}
+
+static int builder_write(Builder* b, const char* path) {
+  Term** order = malloc((b->count ? b->count : 1) * sizeof(Term*));
+  if (!order) return 0;
+  for (int i = 0; i < b->count; i++) order[i] = &b->terms[i];
+  qsort(order, b->count, sizeof(Term*), by_term);
+
+  SegmentWriter w = {0};
+  int ok = writer_open(&w, path);
+  for (int i = 0; ok && i < b->count; i++) {
+    const Term* t = order[i];
+    if (t->df) ok = writer_term(&w, t->term, t->len, t->df, t->postings.data, t->postings.len);
+  }
+  free(order);
+  return w.f ? writer_close(&w, ok, path, &b->docs, b->doc_count) : 0;
+}
+
+// ---- Reading segments ----
+
+typedef struct {
+  uint8_t flags;
+  uint8_t kind;
+  uint16_t name_len;
+  uint32_t length;
+  int64_t mtime;
+  uint64_t size;
+  const char* name;   // In the mapping, not NUL-terminated
+  uint8_t newest;     // Whether no later segment has this name
+  uint8_t seen;       // Still on disk, during a sync
+} Doc;
+
+typedef struct {
+  char file[32];
+  const unsigned char* map;
+  size_t size;
+  uint32_t doc_count;
+  uint32_t term_count;
+  uint64_t meta_off;
+  const unsigned char* dict;
+  const unsigned char* offsets;
+  Doc* docs;
+} Segment;
+
+static void segment_close(Segment* s) {
+  if (s->map) munmap((void*)s->map, s->size);
+  free(s->docs);
+  memset(s, 0, sizeof(*s));
+}
+
+static int segment_open(Segment* s, const char* dir, const char* file) {
+  memset(s, 0, sizeof(*s));
+  snprintf(s->file, sizeof(s->file), "%s", file);
+
+  char path[PATH_MAX + 64];
+  snprintf(path, sizeof(path), "%s/%s", dir, file);
+  int fd = open(path, O_RDONLY);
+  if (fd < 0) return 0;
+  struct stat st;
+  void* map = MAP_FAILED;
+  if (fstat(fd, &st) == 0 && st.st_size >= SEGMENT_HEADER)
+    map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (map == MAP_FAILED) return 0;
+  s->map = map;
+  s->size = st.st_size;
+
+  uint32_t crc;
+  uint64_t dict_off, offsets_off;
+  memcpy(&crc, s->map + 4, 4);
+  memcpy(&s->doc_count, s->map + 8, 4);
+  memcpy(&s->term_count, s->map + 12, 4);
+  memcpy(&s->meta_off, s->map + 16, 8);
+  memcpy(&dict_off, s->map + 24, 8);
+  memcpy(&offsets_off, s->map + 32, 8);
+  int ok = memcmp(s->map, SEGMENT_MAGIC, 4) == 0 && s->meta_off >= SEGMENT_HEADER &&
+           s->meta_off <= dict_off && dict_off <= offsets_off &&
+           offsets_off + (uint64_t)s->term_count * 4 == s->size &&
+           crc32(s->map + s->meta_off, s->size - s->meta_off) == crc &&
+           (s->docs = calloc(s->doc_count ? s->doc_count : 1, sizeof(Doc)));
+
+  const unsigned char* p = s->map + s->meta_off;
+  const unsigned char* end = s->map + dict_off;
+  for (uint32_t i = 0; ok && i < s->doc_count; i++) {
+    Doc* d = &s->docs[i];
+    if (end - p < DOC_RECORD) {
+      ok = 0;
+      break;
+    }
+    d->flags = p[0];
+    d->kind = p[1];
+    memcpy(&d->name_len, p + 2, 2);
+    memcpy(&d->length, p + 4, 4);
+    memcpy(&d->mtime, p + 8, 8);
+    memcpy(&d->size, p + 16, 8);
+    d->name = (const char*)p + DOC_RECORD;
+    p += DOC_RECORD + d->name_len;
+    ok = p <= end && d->name_len < FULLTEXT_NAME_MAX;
+  }
+
+  if (!ok || p != end) {
+    segment_close(s);
+    return 0;
+  }
+  s->dict = s->map + dict_off;
+  s->offsets = s->map + offsets_off;
+  return 1;
+}
+
+// Finds a term's postings; returns its document count, 0 if absent
+static uint32_t segment_term(const Segment* s, const char* term, size_t len,
+                             const unsigned char** postings, const unsigned char** end) {
+  uint32_t lo = 0, hi = s->term_count;
+  while (lo < hi) {
+    uint32_t mid = lo + (hi - lo) / 2, at;
+    memcpy(&at, s->offsets + 4 * (size_t)mid, 4);
+    const unsigned char* e = s->dict + at;
+    if (e + 21 > s->offsets || e + 21 + e[0] > s->offsets) return 0;
+
+    int c = compare_terms(term, len, (const char*)e + 1, e[0]);
+    if (c < 0) {
+      hi = mid;
+    } else if (c > 0) {
+      lo = mid + 1;
+    } else {
+      uint32_t df;
+      uint64_t off, n;
+      memcpy(&df, e + 1 + e[0], 4);
+      memcpy(&off, e + 5 + e[0], 8);
+      memcpy(&n, e + 13 + e[0], 8);
+      if (off < SEGMENT_HEADER || off > s->meta_off || n > s->meta_off - off) return 0;
+      *postings = s->map + off;
+      *end = s->map + off + n;
+      return df;
+    }
+  }
+  return 0;
+}
+
+// Walks one term's postings a document at a time, skipping positions unread
+typedef struct {
+  const unsigned char* p;
+  const unsigned char* end;
+  uint32_t left;
+  uint32_t doc;
+  uint32_t tf;
+  const unsigned char* positions;
+  size_t positions_len;
+  int started;
+} Cursor;
+
+static int cursor_next(Cursor* c) {
+  if (c->left == 0 || c->p >= c->end) return 0;
+  uint64_t delta = get_varint(&c->p, c->end);
+  c->doc = c->started ? c->doc + delta : delta;
+  c->started = 1;
+  c->tf = get_varint(&c->p, c->end);
+  uint64_t n = get_varint(&c->p, c->end);
+  if (n > (uint64_t)(c->end - c->p)) return 0;
+  c->positions = c->p;
+  c->positions_len = n;
+  c->p += n;
+  c->left--;
+  return 1;
+}
+
+// ---- The index ----
+
+static struct {
+  int loaded;          // 1 once read, -1 if the directory is unusable
+  char dir[PATH_MAX];
+  Segment* segs;
+  int count;
+  uint32_t next_id;
+
+  // Newest entry for each (kind, name), as segment << 32 | doc, +1; 0 is empty
+  uint64_t* names;
+  size_t names_size;
+  long live;
+  uint64_t total_length;
+} ix;
+
+static FulltextStats stats;
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+
+static uint32_t name_hash(uint8_t kind, const char* name, size_t len) {
+  return hash_bytes(name, len, 2166136261u ^ kind);
+}
+
+static Doc* doc_at(uint64_t ref) {
+  return &ix.segs[(ref - 1) >> 32].docs[(uint32_t)(ref - 1)];
+}
+
+static uint64_t* name_slot(uint8_t kind, const char* name, size_t len) {
+  if (!ix.names_size) return NULL;
+  size_t h = name_hash(kind, name, len) & (ix.names_size - 1);
+  for (; ix.names[h]; h = (h + 1) & (ix.names_size - 1)) {
+    Doc* d = doc_at(ix.names[h]);
+    if (d->kind == kind && d->name_len == len && memcmp(d->name, name, len) == 0) break;
+  }
+  return &ix.names[h];
+}
+
+// Marks the newest entry for each name and totals the live documents
+static void index_names(void) {
+  size_t docs = 0;
+  for (int s = 0; s < ix.count; s++) docs += ix.segs[s].doc_count;
+  size_t size = 64;
+  while (size < docs * 2) size *= 2;
+
+  free(ix.names);
+  ix.names = calloc(size, sizeof(uint64_t));
+  ix.names_size = ix.names ? size : 0;
+  ix.live = 0;
+  ix.total_length = 0;
+
+  for (int s = 0; s < ix.count; s++) {
+    for (uint32_t i = 0; i < ix.segs[s].doc_count; i++) {
+      Doc* d = &ix.segs[s].docs[i];
+      uint64_t* slot = name_slot(d->kind, d->name, d->name_len);
+      if (!slot) {
+        d->newest = 1;
+        continue;
+      }
+      if (*slot) doc_at(*slot)->newest = 0;
+      *slot = ((uint64_t)s << 32 | i) + 1;
+      d->newest = 1;
+    }
+  }
+
+  for (int s = 0; s < ix.count; s++) {
+    for (uint32_t i = 0; i < ix.segs[s].doc_count; i++) {
+      const Doc* d = &ix.segs[s].docs[i];
+      if (d->newest && !(d->flags & DOC_DELETED)) {
+        ix.live++;
+        ix.total_length += d->length;
+      }
+    }
+  }
+}
+
+static int save_manifest(void) {
+  char path[PATH_MAX + 16], tmp[PATH_MAX + 32];
+  snprintf(path, sizeof(path), "%s/%s", ix.dir, MANIFEST);
+  snprintf(tmp, sizeof(tmp), "%s.tmp.XXXXXX", path);
+  int fd = mkstemp(tmp);
+  if (fd < 0) return 0;
+  FILE* f = fdopen(fd, "w");
+  if (!f) {
+    close(fd);
+    unlink(tmp);
+    return 0;
+  }
+  for (int s = 0; s < ix.count; s++) fprintf(f, "%s\n", ix.segs[s].file);
+  int ok = fclose(f) == 0;
+  if (!ok || rename(tmp, path) != 0) {
+    unlink(tmp);
+    return 0;
+  }
+  return 1;
+}
+
+static int add_segment(const char* file) {
+  Segment* ptr = realloc(ix.segs, (ix.count + 1) * sizeof(Segment));
+  if (!ptr) return 0;
+  ix.segs = ptr;
+  if (!segment_open(&ix.segs[ix.count], ix.dir, file)) return 0;
+  ix.count++;
+  return 1;
+}
+
+// Call with lock held
+static int ensure_loaded(void) {
+  if (ix.loaded) return ix.loaded > 0;
+
+  get_user_path(ix.dir, FULLTEXT_DIR, sizeof(ix.dir));
+  struct stat st;
+  if (stat(ix.dir, &st) != 0 || !S_ISDIR(st.st_mode)) {
+    ix.loaded = -1;
+    return 0;
+  }
+
+  char path[PATH_MAX + 16];
+  snprintf(path, sizeof(path), "%s/%s", ix.dir, MANIFEST);
+  FILE* f = fopen(path, "r");
+  char line[64];
+  int dropped = 0;
+  while (f && fgets(line, sizeof(line), f)) {
+    line[strcspn(line, "\n")] = '\0';
+    unsigned id;
+    if (sscanf(line, "%u.seg", &id) != 1) continue;
+    if (id >= ix.next_id) ix.next_id = id + 1;
+    // A segment that won't open is dropped; its files get indexed again
+    if (!add_segment(line)) dropped = 1;
+  }
+  if (f) fclose(f);
+  if (dropped) save_manifest();
+
+  index_names();
+  ix.loaded = 1;
+  return 1;
+}
+
+static void segment_name(char* file, size_t size) {
+  snprintf(file, size, "%08u.seg", ix.next_id++);
+}
+
+/**
+ * Rewrites segments [from, count) as one. Of each document only the
+ * newest entry is kept, and tombstones only while an older segment may
+ * still hold what they delete. Postings are copied run by run with the
+ * documents renumbered, so nothing is tokenised again.
+ */
+static int merge_segments(int from) {
+  int n = ix.count - from;
+  int32_t** remap = calloc(n, sizeof(int32_t*));
+  uint32_t* next = calloc(n, sizeof(uint32_t));
+  Buf docs = {0}, out = {0};
+  uint32_t doc_count = 0;
+  int ok = remap && next;
+
+  for (int k = 0; ok && k < n; k++) {
+    const Segment* s = &ix.segs[from + k];
+    ok = (remap[k] = malloc((s->doc_count ? s->doc_count : 1) * sizeof(int32_t))) != NULL;
+    for (uint32_t i = 0; ok && i < s->doc_count; i++) {
+      const Doc* d = &s->docs[i];
+      remap[k][i] = -1;
+      if (!d->newest || (from == 0 && (d->flags & DOC_DELETED))) continue;
+      remap[k][i] = doc_count++;
+      ok = buf_put(&docs, s->map + (d->name - (const char*)s->map) - DOC_RECORD, DOC_RECORD + d->name_len);
+    }
+  }
+
+  char file[32], path[PATH_MAX + 64];
+  segment_name(file, sizeof(file));
+  snprintf(path, sizeof(path), "%s/%s", ix.dir, file);
+
+  SegmentWriter w = {0};
+  ok = ok && writer_open(&w, path);
+  while (ok) {
+    // Smallest term not yet written, across the segments
+    const unsigned char* best = NULL;
+    for (int k = 0; k < n; k++) {
+      const Segment* s = &ix.segs[from + k];
+      if (next[k] >= s->term_count) continue;
+      uint32_t at;
+      memcpy(&at, s->offsets + 4 * (size_t)next[k], 4);
+      const unsigned char* e = s->dict + at;
+      if (!best || compare_terms((const char*)e + 1, e[0], (const char*)best + 1, best[0]) < 0) best = e;
+    }
+    if (!best) break;
+
+    char term[FULLTEXT_TERM_MAX];
+    uint8_t len = best[0] < FULLTEXT_TERM_MAX ? best[0] : FULLTEXT_TERM_MAX;
+    memcpy(term, best + 1, len);
+
+    out.len = 0;
+    uint32_t df = 0, last = 0;
+    for (int k = 0; ok && k < n; k++) {
+      const Segment* s = &ix.segs[from + k];
+      Cursor c = {0};
+      if (next[k] >= s->term_count) continue;
+      uint32_t at;
+      memcpy(&at, s->offsets + 4 * (size_t)next[k], 4);
+      const unsigned char* e = s->dict + at;
+      if (compare_terms(term, len, (const char*)e + 1, e[0]) != 0) continue;
+      next[k]++;
+
+      c.left = segment_term(s, term, len, &c.p, &c.end);
+      while (ok && cursor_next(&c)) {
+        if (c.doc >= s->doc_count || remap[k][c.doc] < 0) continue;
+        uint32_t doc = remap[k][c.doc];
+        ok = buf_varint(&out, df ? doc - last : doc) && buf_varint(&out, c.tf) &&
+             buf_varint(&out, c.positions_len) && buf_put(&out, c.positions, c.positions_len);
+        df++;
+        last = doc;
+      }
+    }
+    if (ok && df) ok = writer_term(&w, term, len, df, out.data, out.len);
+  }
+  if (w.f) ok = writer_close(&w, ok, path, &docs, doc_count);
+
+  for (int k = 0; remap && k < n; k++) free(remap[k]);
+  free(remap);
+  free(next);
+  free(docs.data);
+  free(out.data);
+  if (!ok) return 0;
+
+  // The new manifest goes in before the old files go away
+  Segment merged;
+  if (!segment_open(&merged, ix.dir, file)) {
+    unlink(path);
+    return 0;
+  }
+  char (*old)[32] = malloc(n * sizeof(*old));
+  for (int k = 0; k < n; k++) {
+    if (old) memcpy(old[k], ix.segs[from + k].file, 32);
+    segment_close(&ix.segs[from + k]);
+  }
+  ix.segs[from] = merged;
+  ix.count = from + 1;
+  save_manifest();
+  for (int k = 0; old && k < n; k++) {
+    snprintf(path, sizeof(path), "%s/%.31s", ix.dir, old[k]);
+    unlink(path);
+  }
+  free(old);
+  index_names();
+  stats.merges++;
+  return 1;
+}
+
+static void maybe_merge(void) {
+  int from = ix.count;
+  while (from > 0 && ix.segs[from - 1].size < SMALL_SEGMENT) from--;
+  if (ix.count > MAX_SEGMENTS) from = 0;
+  if (ix.count - from >= MERGE_AT || (from == 0 && ix.count > MAX_SEGMENTS)) merge_segments(from);
+}
+
+// ---- Indexing files ----
+
+typedef struct {
+  uint8_t kind;
+  uint8_t deleted;
+  char name[FULLTEXT_NAME_MAX];
+} Job;
+
+typedef struct {
+  const Job* jobs;
+  int count;
+  const char* dirs[2];
+  size_t flush_bytes;        // Builder memory a thread holds before writing a segment
+  int next;                  // Next job to take
+  int done;
+  char (*written)[32];       // Segments written, in no particular order
+  int written_count;
+  int failed;
+  pthread_mutex_t lock;
+} Work;
+
+static void index_file(Builder* b, const char* dir, const Job* job) {
+  if (job->deleted) {
+    builder_add(b, DOC_DELETED, job->kind, job->name, 0, 0, NULL, 0);
+    return;
+  }
+
+  char path[PATH_MAX + FULLTEXT_NAME_MAX + 2];
+  snprintf(path, sizeof(path), "%s/%s", dir, job->name);
+  int fd = open(path, O_RDONLY);
+  if (fd < 0) return; // Gone since the directory was read
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    close(fd);
+    return;
+  }
+
+  void* text = NULL;
+  if (st.st_size > 0) {
+    text = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (text == MAP_FAILED) {
+      close(fd);
+      return;
+    }
+    posix_madvise(text, st.st_size, POSIX_MADV_SEQUENTIAL);
+  }
+  close(fd);
+
+  builder_add(b, 0, job->kind, job->name, st.st_mtime, st.st_size, text, st.st_size);
+  if (text) munmap(text, st.st_size);
+}
+
+static void flush_builder(Work* w, Builder* b) {
+  char file[32], path[PATH_MAX + 64];
+  pthread_mutex_lock(&w->lock);
+  segment_name(file, sizeof(file));
+  pthread_mutex_unlock(&w->lock);
+
+  snprintf(path, sizeof(path), "%s/%s", ix.dir, file);
+  int ok = builder_write(b, path);
+
+  pthread_mutex_lock(&w->lock);
+  if (ok) snprintf(w->written[w->written_count++], 32, "%s", file);
+  else w->failed = 1;
+  pthread_mutex_unlock(&w->lock);
+  builder_free(b);
+}
+
+static void* index_worker(void* arg) {
+  Work* w = arg;
+  Builder b = {0};
+
+  for (;;) {
+    pthread_mutex_lock(&w->lock);
+    int i = w->next++;
+    pthread_mutex_unlock(&w->lock);
+    if (i >= w->count) break;
+
+    index_file(&b, w->dirs[w->jobs[i].kind], &w->jobs[i]);
+
+    pthread_mutex_lock(&w->lock);
+    w->done++;
+    pthread_mutex_unlock(&w->lock);
+    if (b.bytes > w->flush_bytes) flush_builder(w, &b);
+  }
+  if (b.doc_count) flush_builder(w, &b);
+  builder_free(&b);
+  return NULL;
+}
+
+// Call with lock held; indexes jobs on up to one thread per core
+static int run_jobs(const Job* jobs, int count, const char* dirs[2],
+                    void (*progress)(int done, int total, void* ud), void* ud) {
+  if (count == 0) return 0;
+
+  long cores = sysconf(_SC_NPROCESSORS_ONLN);
+  int threads = cores > 0 ? (int)cores : 1;
+  if (threads > count) threads = count;
+  if (threads > 32) threads = 32;
+
+  Work w = {0};
+  w.jobs = jobs;
+  w.count = count;
+  w.dirs[0] = dirs[0];
+  w.dirs[1] = dirs[1];
+  // However many cores, the builders together stay within INDEX_MEMORY
+  w.flush_bytes = INDEX_MEMORY / threads;
+  // Each thread writes a segment per flush_bytes; a file is never bigger than that many
+  w.written = calloc(count + threads, sizeof(*w.written));
+  if (!w.written) return -1;
+  pthread_mutex_init(&w.lock, NULL);
+
+  pthread_t ids[32];
+  int started = 0;
+  for (; started < threads; started++) {
+    if (pthread_create(&ids[started], NULL, index_worker, &w) != 0) break;
+  }
+  if (started == 0) index_worker(&w);
+
+  while (progress) {
+    pthread_mutex_lock(&w.lock);
+    int done = w.done;
+    pthread_mutex_unlock(&w.lock);
+    progress(done, count, ud);
+    if (done >= count) break;
+    nanosleep(&(struct timespec){0, 50 * 1000000L}, NULL);
+  }
+  for (int i = 0; i < started; i++) pthread_join(ids[i], NULL);
+
+  for (int i = 0; i < w.written_count; i++) add_segment(w.written[i]);
+  save_manifest();
+  index_names();
+  maybe_merge();
+
+  free(w.written);
+  pthread_mutex_destroy(&w.lock);
+  stats.indexed += count;
+  return w.failed ? -1 : count;
+}
+
+static int push_job(Job** jobs, int* count, int* cap, uint8_t kind, uint8_t deleted, const char* name, size_t len) {
+  if (*count == *cap) {
+    int grown = *cap ? *cap * 2 : 256;
+    Job* ptr = realloc(*jobs, grown * sizeof(Job));
+    if (!ptr) return 0;
+    *jobs = ptr;
+    *cap = grown;
+  }
+  Job* j = &(*jobs)[(*count)++];
+  j->kind = kind;
+  j->deleted = deleted;
+  memcpy(j->name, name, len);
+  j->name[len] = '\0';
+  return 1;
+}
+
+// Queues the files in dir that are new or changed since they were indexed
+static void scan_dir(const char* dir, uint8_t kind, Job** jobs, int* count, int* cap) {
+  DIR* d = opendir(dir);
+  if (!d) return;
+
+  struct dirent* e;
+  while ((e = readdir(d)) != NULL) {
+    size_t len = strlen(e->d_name);
+    if (e->d_name[0] == '.' || len >= FULLTEXT_NAME_MAX || strstr(e->d_name, ".tmp.")) continue;
+    if (kind == FULLTEXT_CHAPTER && (len < 4 || strcmp(e->d_name + len - 4, ".txt") != 0)) continue;
+
+    char path[PATH_MAX + FULLTEXT_NAME_MAX + 2];
+    struct stat st;
+    snprintf(path, sizeof(path), "%s/%s", dir, e->d_name);
+    if (stat(path, &st) != 0 || !S_ISREG(st.st_mode)) continue;
+
+    uint64_t* slot = name_slot(kind, e->d_name, len);
+    Doc* doc = slot && *slot ? doc_at(*slot) : NULL;
+    if (doc && !(doc->flags & DOC_DELETED)) {
+      doc->seen = 1;
+      if (doc->mtime == (int64_t)st.st_mtime && doc->size == (uint64_t)st.st_size) continue;
+    }
+    push_job(jobs, count, cap, kind, 0, e->d_name, len);
+  }
+  closedir(d);
+}
+
+int fulltext_sync(void (*progress)(int done, int total, void* ud), void* ud) {
+  char library[PATH_MAX], chapters[PATH_MAX];
+  get_user_path(library, "library", sizeof(library));
+  get_user_path(chapters, CHAPTER_CACHE_DIR, sizeof(chapters));
+  const char* dirs[2] = {library, chapters};
+
+  pthread_mutex_lock(&lock);
+  if (!ensure_loaded()) {
+    pthread_mutex_unlock(&lock);
+    return -1;
+  }
+
+  for (int s = 0; s < ix.count; s++) {
+    for (uint32_t i = 0; i < ix.segs[s].doc_count; i++) ix.segs[s].docs[i].seen = 0;
+  }
+
+  Job* jobs = NULL;
+  int count = 0, cap = 0;
+  scan_dir(library, FULLTEXT_BOOK, &jobs, &count, &cap);
+  scan_dir(chapters, FULLTEXT_CHAPTER, &jobs, &count, &cap);
+
+  // Whatever is indexed but no longer on disk gets a tombstone
+  for (int s = 0; s < ix.count; s++) {
+    for (uint32_t i = 0; i < ix.segs[s].doc_count; i++) {
+      const Doc* d = &ix.segs[s].docs[i];
+      if (d->newest && !d->seen && !(d->flags & DOC_DELETED))
+        push_job(&jobs, &count, &cap, d->kind, 1, d->name, d->name_len);
+    }
+  }
+
+  int indexed = run_jobs(jobs, count, dirs, progress, ud);
+  pthread_mutex_unlock(&lock);
+  free(jobs);
+  return indexed;
+}
+
+void fulltext_add_book(const char* path) {
+  const char* slash = strrchr(path, '/');
+  const char* name = slash ? slash + 1 : path;
+  size_t len = strlen(name);
+  if (len == 0 || len >= FULLTEXT_NAME_MAX) return;
+
+  char dir[PATH_MAX];
+  snprintf(dir, sizeof(dir), "%.*s", slash ? (int)(slash - path) : 1, slash ? path : ".");
+  const char* dirs[2] = {dir, dir};
+
+  Job job;
+  job.kind = FULLTEXT_BOOK;
+  job.deleted = 0;
+  memcpy(job.name, name, len + 1);
+
+  pthread_mutex_lock(&lock);
+  if (ensure_loaded()) run_jobs(&job, 1, dirs, NULL, NULL);
+  pthread_mutex_unlock(&lock);
+}
+
+// ---- Queries ----
+
+typedef struct {
+  int first, count;  // Range of the query's terms
+  int phrase;
+} Clause;
+
+typedef struct {
+  char term[MAX_QUERY_TERMS][FULLTEXT_TERM_MAX];
+  uint8_t len[MAX_QUERY_TERMS];
+  int distinct[MAX_QUERY_TERMS];  // First query term with the same text
+  int terms;
+  Clause clauses[MAX_QUERY_TERMS];
+  int clause_count;
+} Query;
+
+static void add_clause(Query* q, const char* text, size_t len, int quoted) {
+  size_t i = 0, n;
+  char term[FULLTEXT_TERM_MAX];
+  int first = q->terms;
+
+  while (q->terms < MAX_QUERY_TERMS && (n = next_term(text, len, &i, term)) > 0) {
+    int t = q->terms++;
+    memcpy(q->term[t], term, n);
+    q->len[t] = n;
+    q->distinct[t] = t;
+    for (int k = 0; k < t; k++) {
+      if (q->len[k] == n && memcmp(q->term[k], term, n) == 0) {
+        q->distinct[t] = q->distinct[k];
+        break;
+      }
+    }
+    if (!quoted) q->clauses[q->clause_count++] = (Clause){t, 1, 0};
+  }
+  if (quoted && q->terms > first) q->clauses[q->clause_count++] = (Clause){first, q->terms - first, q->terms - first > 1};
+}
+
+static void parse_query(const char* text, Query* q) {
+  memset(q, 0, sizeof(*q));
+  const char* p = text;
+  while (*p) {
+    int quoted = *p == '"';
+    if (quoted) p++;
+    const char* end = strchr(p, '"');
+    if (!end) end = p + strlen(p);
+    add_clause(q, p, end - p, quoted);
+    p = *end ? end + (quoted ? 1 : 0) : end;
+  }
+}
+
+static uint32_t decode_positions(const Cursor* c, uint32_t** buf, uint32_t* cap) {
+  if (c->tf > *cap) {
+    uint32_t* ptr = realloc(*buf, c->tf * sizeof(uint32_t));
+    if (!ptr) return 0;
+    *buf = ptr;
+    *cap = c->tf;
+  }
+  const unsigned char* p = c->positions;
+  const unsigned char* end = p + c->positions_len;
+  uint32_t pos = 0, n = 0;
+  while (n < c->tf && p < end) {
+    pos = n ? pos + (uint32_t)get_varint(&p, end) : (uint32_t)get_varint(&p, end);
+    (*buf)[n++] = pos;
+  }
+  return n;
+}
+
+// Occurrences of the clause's words one after another
+static uint32_t count_phrase(const Query* q, const Clause* c, Cursor* cursors,
+                             uint32_t** pos, uint32_t* cap) {
+  uint32_t n[MAX_QUERY_TERMS], at[MAX_QUERY_TERMS] = {0};
+  for (int k = 0; k < c->count; k++) {
+    n[k] = decode_positions(&cursors[q->distinct[c->first + k]], &pos[k], &cap[k]);
+    if (n[k] == 0) return 0;
+  }
+
+  uint32_t found = 0;
+  for (uint32_t i = 0; i < n[0]; i++) {
+    uint32_t start = pos[0][i];
+    int ok = 1;
+    for (int k = 1; ok && k < c->count; k++) {
+      while (at[k] < n[k] && pos[k][at[k]] < start + k) at[k]++;
+      if (at[k] == n[k]) return found;
+      ok = pos[k][at[k]] == start + k;
+    }
+    found += ok;
+  }
+  return found;
+}
+
+static double bm25(double idf, uint32_t tf, uint32_t length, double avg_length) {
+  double norm = 1 - BM25_B + BM25_B * (avg_length > 0 ? length / avg_length : 1);
+  return idf * tf * (BM25_K1 + 1) / (tf + BM25_K1 * norm);
+}
+
+static void keep_hit(FulltextHit* hits, int* n, int max, const Doc* d, double score, uint32_t count) {
+  if (max <= 0 || (*n == max && score <= hits[max - 1].score)) return;
+  int i = *n < max ? (*n)++ : max - 1;
+  while (i > 0 && hits[i - 1].score < score) {
+    hits[i] = hits[i - 1];
+    i--;
+  }
+  hits[i].kind = d->kind;
+  hits[i].score = score;
+  hits[i].hits = count;
+  snprintf(hits[i].name, sizeof(hits[i].name), "%.*s", (int)d->name_len, d->name);
+}
+
+int fulltext_query(const char* text, FulltextHit* hits, int max) {
+  struct timespec start, end;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+
+  Query q;
+  parse_query(text, &q);
+
+  pthread_mutex_lock(&lock);
+  if (!ensure_loaded() || q.clause_count == 0 || ix.live == 0) {
+    pthread_mutex_unlock(&lock);
+    return 0;
+  }
+
+  double docs = ix.live;
+  double avg_length = (double)ix.total_length / ix.live;
+  double idf[MAX_QUERY_TERMS];
+  for (int t = 0; t < q.terms; t++) {
+    if (q.distinct[t] != t) continue;
+    double df = 0;
+    for (int s = 0; s < ix.count; s++) {
+      const unsigned char *p, *e;
+      df += segment_term(&ix.segs[s], q.term[t], q.len[t], &p, &e);
+    }
+    if (df > docs) df = docs;
+    idf[t] = log(1 + (docs - df + 0.5) / (df + 0.5));
+  }
+
+  uint32_t* pos[MAX_QUERY_TERMS] = {0};
+  uint32_t cap[MAX_QUERY_TERMS] = {0};
+  int found = 0;
+
+  for (int s = 0; s < ix.count; s++) {
+    const Segment* seg = &ix.segs[s];
+    Cursor cursors[MAX_QUERY_TERMS];
+    int lead = -1, missing = 0;
+    for (int t = 0; t < q.terms && !missing; t++) {
+      if (q.distinct[t] != t) continue;
+      memset(&cursors[t], 0, sizeof(Cursor));
+      cursors[t].left = segment_term(seg, q.term[t], q.len[t], &cursors[t].p, &cursors[t].end);
+      if (cursors[t].left == 0) missing = 1;
+      else if (lead < 0 || cursors[t].left < cursors[lead].left) lead = t;
+    }
+    if (missing) continue;
+
+    // Documents with every word, found by walking the rarest one's list
+    int valid[MAX_QUERY_TERMS] = {0};
+    while (cursor_next(&cursors[lead])) {
+      uint32_t doc = cursors[lead].doc;
+      int all = 1, exhausted = 0;
+      for (int t = 0; t < q.terms && all; t++) {
+        if (q.distinct[t] != t || t == lead) continue;
+        while (!valid[t] || cursors[t].doc < doc) {
+          if (!(valid[t] = cursor_next(&cursors[t]))) break;
+        }
+        if (!valid[t]) exhausted = 1;
+        all = valid[t] && cursors[t].doc == doc;
+      }
+      if (exhausted) break;
+      if (!all || doc >= seg->doc_count) continue;
+
+      const Doc* d = &seg->docs[doc];
+      if (!d->newest || (d->flags & DOC_DELETED)) continue;
+
+      double score = 0;
+      uint32_t count = 0;
+      for (int c = 0; c < q.clause_count && all; c++) {
+        const Clause* cl = &q.clauses[c];
+        uint32_t tf;
+        double weight = 0;
+        for (int k = 0; k < cl->count; k++) weight += idf[q.distinct[cl->first + k]];
+        if (cl->phrase) tf = count_phrase(&q, cl, cursors, pos, cap);
+        else tf = cursors[q.distinct[cl->first]].tf;
+        all = tf > 0;
+        score += bm25(weight, tf, d->length, avg_length);
+        count += tf;
+      }
+      if (all) keep_hit(hits, &found, max, d, score, count);
+    }
+  }
+
+  for (int t = 0; t < MAX_QUERY_TERMS; t++) free(pos[t]);
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  stats.queries++;
+  stats.last_query_us = (end.tv_sec - start.tv_sec) * 1000000L + (end.tv_nsec - start.tv_nsec) / 1000;
+  pthread_mutex_unlock(&lock);
+  return found;
+}
+
+void fulltext_focus(const char* query, char* out, size_t size) {
+  const char* open = strchr(query, '"');
+  const char* close = open ? strchr(open + 1, '"') : NULL;
+  const char* p = close ? open + 1 : query;
+  const char* end = close ? close : query + strlen(query);
+
+  if (close) {
+    while (p < end && *p == ' ') p++;
+    while (end > p && end[-1] == ' ') end--;
+  } else {
+    while (p < end && !is_word(*p)) p++;
+    end = p;
+    while (*end && is_word(*end)) end++;
+  }
+  snprintf(out, size, "%.*s", (int)(end - p), p);
+}
+
+void fulltext_get_stats(FulltextStats* out) {
+  pthread_mutex_lock(&lock);
+  ensure_loaded();
+  *out = stats;
+  out->documents = ix.live;
+  out->segments = ix.count;
+  out->bytes = 0;
+  for (int s = 0; s < ix.count; s++) out->bytes += ix.segs[s].size;
+  pthread_mutex_unlock(&lock);
+}
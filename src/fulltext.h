@@ -0,0 +1,55 @@
+#ifndef FULLTEXT_H
+#define FULLTEXT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define FULLTEXT_DIR "index"
+#define FULLTEXT_TERM_MAX 32
+#define FULLTEXT_NAME_MAX 256
+#define FULLTEXT_MAX_RESULTS 100
+
+typedef enum { FULLTEXT_BOOK, FULLTEXT_CHAPTER } FulltextKind;
+
+typedef struct {
+  FulltextKind kind;
+  char name[FULLTEXT_NAME_MAX]; // File name in the library or the chapter cache
+  double score;
+  uint32_t hits;                // Occurrences of the query's words and phrases
+} FulltextHit;
+
+typedef struct {
+  int documents;
+  int segments;
+  uint64_t bytes;       // Index size on disk
+  long indexed;         // Files indexed this session
+  long merges;
+  long queries;
+  long last_query_us;
+} FulltextStats;
+
+/**
+ * Brings the index up to date with the library and the chapter cache: new
+ * and changed files are indexed, removed ones forgotten. The files are
+ * split across one thread per core; progress(done, total, ud) is called
+ * on the calling thread while it waits. Returns the files indexed, or -1
+ * if the index directory can't be used.
+ */
+int fulltext_sync(void (*progress)(int done, int total, void* ud), void* ud);
+
+// Indexes one library book right away, e.g. just after it was downloaded
+void fulltext_add_book(const char* path);
+
+/**
+ * Ranked search. Every word must occur, "quoted words" must occur next to
+ * each other in that order, and documents are ordered by BM25. Fills up
+ * to max hits, best first, and returns how many.
+ */
+int fulltext_query(const char* query, FulltextHit* hits, int max);
+
+// What to look for inside a matching text: the query's first phrase, or else its first word
+void fulltext_focus(const char* query, char* out, size_t size);
+
+void fulltext_get_stats(FulltextStats* out);
+
+#endif
@@ -2,101 +2,342 @@
 
 #include "history.h"
 #include "chapter_controller.h"
+#include "chapter_list.h"
 #include "network.h"
 #include "ui.h"
 #include "controller.h"
+#include "journal.h"
 
 #include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
 #include <string.h>
 #include <ncurses.h>
 #include <limits.h>
+#include <unistd.h>
+
+#define JOURNAL_MAGIC "NCH1"
+#define RECORD_MAX (12 + 4 * (2 + HISTORY_FIELD_MAX)) // Largest payload
+
+// Compact once the journal is this long and mostly superseded records
+#define COMPACT_MIN_RECORDS 256
+#define COMPACT_RATIO 4
+
+// The history.bin layout before the journal, read once to migrate it
+typedef struct {
+    char novel_title[256];
+    char chapter_title[256];
+    char chapter_slug[256];
+    char novel_slug[256];
+    int chapter_num;
+} LegacyEntry;
+
+// Latest entry per novel, found through an open-addressed slug table
+static HistoryEntry* entries = NULL;
+static int entry_count = 0;
+static int entry_cap = 0;
+static int* buckets = NULL;        // Entry index + 1, 0 when empty
+static int bucket_count = 0;
+
+static unsigned long next_seq = 0;
+static Journal journal;
+static int journal_ok = 0;       // Whether the journal has a path
+static int loaded = 0;
+
+static uint32_t hash_slug(const char* s) {
+  uint32_t h = 2166136261u;
+  while (*s) h = (h ^ (unsigned char)*s++) * 16777619u;
+  return h;
+}
 
-void save_to_history(const char* n_title, const char* c_title,
-                     const char* c_slug, const char* n_slug, int c_num) {
+static int history_file(char* dest, size_t size, const char* name) {
+  char dir[PATH_MAX];
+  get_user_path(dir, "history", sizeof(dir));
+  int n = snprintf(dest, size, "%s/%s", dir, name);
+  return n > 0 && n < (int)size;
+}
 
-  HistoryEntry history[MAX_HISTORY];
-  int count = load_history(history);
+// Bucket holding slug, or the empty bucket where it would go
+static int find_bucket(const char* slug) {
+  uint32_t mask = (uint32_t)bucket_count - 1;
+  uint32_t i = hash_slug(slug) & mask;
+  while (buckets[i] && strcmp(entries[buckets[i] - 1].novel_slug, slug) != 0) i = (i + 1) & mask;
+  return (int)i;
+}
 
-  int existing_idx = -1;
-  for(int i = 0; i < count; i++) {
-    if(strcmp(history[i].chapter_slug, c_slug) == 0) {
-      existing_idx = i;
-      break;
+static int grow_index(void) {
+  if (entry_count >= entry_cap) {
+    int cap = entry_cap ? entry_cap * 2 : 32;
+    HistoryEntry* ptr = realloc(entries, cap * sizeof(HistoryEntry));
+    if (!ptr) return 0;
+    entries = ptr;
+    entry_cap = cap;
+  }
+
+  // Keep the table at most half full
+  if ((entry_count + 1) * 2 > bucket_count) {
+    int count = bucket_count ? bucket_count * 2 : 64;
+    int* table = calloc(count, sizeof(int));
+    if (!table) return 0;
+    free(buckets);
+    buckets = table;
+    bucket_count = count;
+    for (int i = 0; i < entry_count; i++) buckets[find_bucket(entries[i].novel_slug)] = i + 1;
+  }
+  return 1;
+}
+
+static void free_entry(HistoryEntry* e) {
+  free(e->novel_title);
+  free(e->chapter_title);
+  free(e->chapter_slug);
+  free(e->novel_slug);
+}
+
+// Makes e the latest entry for its novel; takes ownership of its strings
+static void index_put(HistoryEntry* e) {
+  if (e->seq >= next_seq) next_seq = e->seq + 1;
+
+  if (bucket_count) {
+    int slot = find_bucket(e->novel_slug);
+    if (buckets[slot]) {
+      HistoryEntry* old = &entries[buckets[slot] - 1];
+      free_entry(old);
+      *old = *e;
+      return;
     }
   }
 
-  int move_count = (existing_idx != -1) ? existing_idx :
-    (count < MAX_HISTORY ? count : MAX_HISTORY - 1);
+  if (!grow_index()) {
+    free_entry(e);
+    return;
+  }
+  entries[entry_count] = *e;
+  buckets[find_bucket(e->novel_slug)] = ++entry_count;
+}
 
-  for(int i = move_count; i > 0; i--) {
-    history[i] = history[i-1];
+static char* field_dup(const char* s) {
+  size_t len = strnlen(s ? s : "", HISTORY_FIELD_MAX);
+  char* copy = malloc(len + 1);
+  if (copy) {
+    memcpy(copy, s ? s : "", len);
+    copy[len] = '\0';
   }
+  return copy;
+}
 
-  strncpy(history[0].novel_title, n_title, sizeof(history[0].novel_title)-1);
-  history[0].novel_title[sizeof(history[0].novel_title)-1] = '\0';
+static int make_entry(HistoryEntry* e, const char* n_title, const char* c_title,
+                      const char* c_slug, const char* n_slug, int c_num) {
+  e->novel_title = field_dup(n_title);
+  e->chapter_title = field_dup(c_title);
+  e->chapter_slug = field_dup(c_slug);
+  e->novel_slug = field_dup(n_slug);
+  e->chapter_num = c_num;
+  if (!e->novel_title || !e->chapter_title || !e->chapter_slug || !e->novel_slug) {
+    free_entry(e);
+    return 0;
+  }
+  return 1;
+}
 
-  strncpy(history[0].chapter_title, c_title, sizeof(history[0].chapter_title)-1);
-  history[0].chapter_title[sizeof(history[0].chapter_title)-1] = '\0';
+/* ---- Record format ----
+ * The journal frames each payload with its length and CRC-32. Payload:
+ * int32 chapter number, int64 read time, and four uint16-length-prefixed
+ * strings: novel slug, novel title, chapter slug, chapter title. */
 
-  strncpy(history[0].chapter_slug, c_slug, sizeof(history[0].chapter_slug)-1);
-  history[0].chapter_slug[sizeof(history[0].chapter_slug)-1] = '\0';
+static size_t put_field(unsigned char* p, const char* s) {
+  uint16_t len = (uint16_t)strlen(s);
+  memcpy(p, &len, 2);
+  memcpy(p + 2, s, len);
+  return 2 + len;
+}
 
-  strncpy(history[0].novel_slug, n_slug, sizeof(history[0].novel_slug)-1);
-  history[0].novel_slug[sizeof(history[0].novel_slug)-1] = '\0';
+static size_t encode_record(unsigned char* buf, const HistoryEntry* e) {
+  unsigned char* p = buf;
+  int32_t num = e->chapter_num;
+  int64_t when = (int64_t)e->read_at;
+  memcpy(p, &num, 4);
+  memcpy(p + 4, &when, 8);
+  p += 12;
+  p += put_field(p, e->novel_slug);
+  p += put_field(p, e->novel_title);
+  p += put_field(p, e->chapter_slug);
+  p += put_field(p, e->chapter_title);
+
+  return (size_t)(p - buf);
+}
 
-  history[0].chapter_num = c_num;
+static char* get_field(const unsigned char** p, const unsigned char* end) {
+  uint16_t len;
+  if (end - *p < 2) return NULL;
+  memcpy(&len, *p, 2);
+  if (len > HISTORY_FIELD_MAX || end - *p - 2 < len) return NULL;
+
+  char* s = malloc(len + 1);
+  if (!s) return NULL;
+  memcpy(s, *p + 2, len);
+  s[len] = '\0';
+  *p += 2 + len;
+  return s;
+}
 
-  if (existing_idx == -1 && count < MAX_HISTORY)
-    count++;
+static int decode_record(const unsigned char* payload, size_t len, HistoryEntry* e) {
+  if (len < 12) return 0;
+  int32_t num;
+  int64_t when;
+  memcpy(&num, payload, 4);
+  memcpy(&when, payload + 4, 8);
+
+  const unsigned char* p = payload + 12;
+  const unsigned char* end = payload + len;
+  memset(e, 0, sizeof(*e));
+  e->chapter_num = num;
+  e->read_at = (time_t)when;
+  e->novel_slug = get_field(&p, end);
+  e->novel_title = get_field(&p, end);
+  e->chapter_slug = get_field(&p, end);
+  e->chapter_title = get_field(&p, end);
+
+  if (!e->novel_slug || !e->novel_title || !e->chapter_slug || !e->chapter_title || p != end) {
+    free_entry(e);
+    return 0;
+  }
+  return 1;
+}
 
-  char dir[PATH_MAX];
-  get_user_path(dir, "history", sizeof(dir));
+/* ---- Journal ---- */
 
-  char file[PATH_MAX];
-  int n = snprintf(file, sizeof(file), "%s/history.bin", dir);
-  if (n < 0 || n >= (int)sizeof(file)) return;
+static int by_seq(const void* a, const void* b) {
+  unsigned long x = (*(const HistoryEntry* const*)a)->seq;
+  unsigned long y = (*(const HistoryEntry* const*)b)->seq;
+  return (x > y) - (x < y);
+}
+
+// Rewrites the journal with one record per novel
+static int compact_journal(void) {
+  if (!journal_ok || !journal_rewrite_begin(&journal)) return 0;
 
-  FILE* f = fopen(file, "wb");
+  // Oldest first, so replaying the file rebuilds the same order
+  HistoryEntry** order = malloc((entry_count ? entry_count : 1) * sizeof(HistoryEntry*));
+  unsigned char* buf = malloc(RECORD_MAX);
+  int ok = order && buf;
+  for (int i = 0; ok && i < entry_count; i++) order[i] = &entries[i];
+  if (ok) qsort(order, entry_count, sizeof(HistoryEntry*), by_seq);
 
-  if(f) {
-    fwrite(&count, sizeof(int), 1, f);
-    fwrite(history, sizeof(HistoryEntry), count, f);
-    fclose(f);
+  for (int i = 0; ok && i < entry_count; i++) {
+    size_t len = encode_record(buf, order[i]);
+    ok = journal_rewrite_put(&journal, buf, len);
   }
+  free(order);
+  free(buf);
+  return journal_rewrite_end(&journal, ok);
 }
 
-int load_history(HistoryEntry history[MAX_HISTORY]) {
+static int replay_record(const unsigned char* payload, size_t len, void* userdata) {
+  (void)userdata;
+  HistoryEntry e;
+  if (!decode_record(payload, len, &e)) return 0;
+  e.seq = next_seq;
+  index_put(&e);
+  return 1;
+}
 
-  char dir[PATH_MAX];
-  get_user_path(dir, "history", sizeof(dir));
+// Carries the old fixed-size history.bin over, oldest entry first
+static int migrate_legacy(const char* legacy) {
+  FILE* f = fopen(legacy, "rb");
+  if (!f) return 0;
 
-  char file[PATH_MAX];
-  int n = snprintf(file, sizeof(file), "%s/history.bin", dir);
-  if (n < 0 || n >= (int)sizeof(file)) return 0;
+  int count = 0;
+  LegacyEntry old[MAX_HISTORY];
+  if (fread(&count, sizeof(int), 1, f) != 1) count = 0;
+  if (count < 0) count = 0;
+  if (count > MAX_HISTORY) count = MAX_HISTORY;
+  count = (int)fread(old, sizeof(LegacyEntry), count, f);
+  fclose(f);
 
-  FILE* f = fopen(file, "rb");
+  for (int i = count - 1; i >= 0; i--) {
+    LegacyEntry* o = &old[i];
+    o->novel_title[255] = o->chapter_title[255] = o->chapter_slug[255] = o->novel_slug[255] = '\0';
 
-  if(!f) return 0;
+    HistoryEntry e = {0};
+    if (!make_entry(&e, o->novel_title, o->chapter_title, o->chapter_slug, o->novel_slug, o->chapter_num)) continue;
+    e.seq = next_seq;
+    index_put(&e);
+  }
+  return 1;
+}
 
-  int count = 0;
+static void ensure_loaded(void) {
+  if (loaded) return;
+  loaded = 1;
 
-  if (fread(&count, sizeof(int), 1, f) != 1) {
-    fclose(f);
-    return 0;
+  char path[PATH_MAX], legacy[PATH_MAX];
+  if (!history_file(path, sizeof(path), HISTORY_JOURNAL)) return;
+  if (!(journal_ok = journal_init(&journal, path, JOURNAL_MAGIC, RECORD_MAX))) return;
+
+  if (access(path, F_OK) != 0 && history_file(legacy, sizeof(legacy), "history.bin") &&
+      migrate_legacy(legacy)) {
+    // Only drop the old file once its entries are safely in the journal
+    if (compact_journal()) unlink(legacy);
+    return;
   }
+  // A bad journal is set aside as history.log.bad and history starts over
+  journal_load(&journal, replay_record, NULL);
+  if (journal.torn) compact_journal();
+}
+
+static int append_record(const HistoryEntry* e) {
+  if (!journal_ok) return 0;
+  unsigned char buf[RECORD_MAX];
+  size_t len = encode_record(buf, e);
+  return journal_append(&journal, buf, len);
+}
 
-  if (count > MAX_HISTORY)
-    count = MAX_HISTORY;
+void save_to_history(const char* n_title, const char* c_title,
+                     const char* c_slug, const char* n_slug, int c_num) {
+  ensure_loaded();
 
-  fread(history, sizeof(HistoryEntry), count, f);
-  fclose(f);
+  HistoryEntry e = {0};
+  if (!make_entry(&e, n_title, c_title, c_slug, n_slug, c_num)) return;
+  e.read_at = time(NULL);
+  e.seq = next_seq;
+
+  append_record(&e);
+  index_put(&e);
+
+  if (journal.records >= COMPACT_MIN_RECORDS && journal.records > COMPACT_RATIO * (long)entry_count)
+    compact_journal();
+}
+
+const HistoryEntry* history_last_read(const char* novel_slug) {
+  ensure_loaded();
+  if (!bucket_count || !novel_slug) return NULL;
 
+  int slot = find_bucket(novel_slug);
+  return buckets[slot] ? &entries[buckets[slot] - 1] : NULL;
+}
+
+static int by_seq_desc(const void* a, const void* b) {
+  return by_seq(b, a);
+}
+
+int history_recent(const HistoryEntry* out[], int max) {
+  ensure_loaded();
+
+  const HistoryEntry** all = malloc((entry_count ? entry_count : 1) * sizeof(HistoryEntry*));
+  if (!all) return 0;
+  for (int i = 0; i < entry_count; i++) all[i] = &entries[i];
+  qsort(all, entry_count, sizeof(HistoryEntry*), by_seq_desc);
+
+  int count = entry_count < max ? entry_count : max;
+  memcpy(out, all, count * sizeof(HistoryEntry*));
+  free(all);
   return count;
 }
 
 void show_history_menu() {
-  HistoryEntry history[MAX_HISTORY];
-  int count = load_history(history);
+  const HistoryEntry* history[MAX_HISTORY];
+  int count = history_recent(history, MAX_HISTORY);
 
   if (count == 0) {
     clear();
@@ -110,21 +351,28 @@ void show_history_menu() {
   for(int i = 0; i < count; i++) {
     snprintf(display_strings[i], sizeof(display_strings[i]),
              "[%.200s] %.200s",
-             history[i].novel_title,
-             history[i].chapter_title);
+             history[i]->novel_title,
+             history[i]->chapter_title);
     options[i] = display_strings[i];
   }
 
   int choice = display_menu(options, count); // Using your existing menu UI
   if (choice >= 0) {
-    char chapters[3500][128] = {0};
-    char titles[3500][128] = {0};
+    // The browser records history as it goes, which may move entries around
+    char novel_title[HISTORY_FIELD_MAX + 1], novel_slug[HISTORY_FIELD_MAX + 1];
+    snprintf(novel_title, sizeof(novel_title), "%s", history[choice]->novel_title);
+    snprintf(novel_slug, sizeof(novel_slug), "%s", history[choice]->novel_slug);
+    int start_idx = history[choice]->chapter_num - 1;
+
+    ChapterIndex chapters;
+    chapter_index_init(&chapters);
 
-    // Fetch full list for the selected novel to support Prev/Next navigation
-    int total = fetch_novel_chapters(history[choice].novel_slug, chapters, titles);
+    // Full list for the selected novel to support Prev/Next navigation
+    chapter_list_open(novel_slug, &chapters);
 
-    int start_idx = history[choice].chapter_num - 1;
     // Jump straight to the browser at the correct chapter
-    show_chapter_browser(chapters, titles, total, history[choice].novel_title, history[choice].novel_slug, start_idx);
+    show_chapter_browser(&chapters, novel_title, novel_slug, start_idx);
+    chapter_list_close();
+    chapter_index_free(&chapters);
   }
 }
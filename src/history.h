@@ -1,21 +1,38 @@
 #ifndef HISTORY_H
 #define HISTORY_H
 
+#include <time.h>
+
+// Entries shown in the history menu
 #define MAX_HISTORY 15
 
+#define HISTORY_JOURNAL "history.log"
+#define HISTORY_FIELD_MAX 1024
+
+// Latest chapter read in one novel
 typedef struct {
-    char novel_title[256];
-    char chapter_title[256];
-    char chapter_slug[256];
-    char novel_slug[256];
+    char* novel_title;
+    char* chapter_title;
+    char* chapter_slug;
+    char* novel_slug;
     int chapter_num;
+    time_t read_at;
+    unsigned long seq;   // Position in the journal, newer is larger
 } HistoryEntry;
 
-// Saves a new entry, maintaining only the last 15
+/**
+ * Records a chapter as read. One CRC-checked record is appended to the
+ * journal, so the cost doesn't depend on how much history there is;
+ * superseded records are compacted away now and then.
+ */
 void save_to_history(const char* n_title, const char* c_title, const char* c_slug, const char* n_slug, int c_num);
 
-// Loads history from disk
-int load_history(HistoryEntry history[MAX_HISTORY]);
+// Where the reader left novel_slug, or NULL if it was never opened.
+// Returned entries stay valid until the next save_to_history().
+const HistoryEntry* history_last_read(const char* novel_slug);
+
+// Fills out with up to max novels, most recently read first; returns the count
+int history_recent(const HistoryEntry* out[], int max);
 
 // Displays the history menu and handles selection
 void show_history_menu();
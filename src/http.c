@@ -0,0 +1,160 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "http.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+
+static CURLSH* share = NULL;
+static pthread_mutex_t share_locks[CURL_LOCK_DATA_LAST];
+
+static CURL* pool[HTTP_POOL_SIZE];
+static int pool_count = 0;
+static pthread_mutex_t pool_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static HttpStats stats;
+static pthread_mutex_t stats_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static void share_lock(CURL* handle, curl_lock_data data, curl_lock_access access, void* userp) {
+  (void) handle; (void) access; (void) userp;
+  pthread_mutex_lock(&share_locks[data]);
+}
+
+static void share_unlock(CURL* handle, curl_lock_data data, void* userp) {
+  (void) handle; (void) userp;
+  pthread_mutex_unlock(&share_locks[data]);
+}
+
+void http_init(void) {
+  if (share) return;
+
+  for (int i = 0; i < CURL_LOCK_DATA_LAST; i++)
+    pthread_mutex_init(&share_locks[i], NULL);
+
+  share = curl_share_init();
+  if (!share) return;
+
+  curl_share_setopt(share, CURLSHOPT_LOCKFUNC, share_lock);
+  curl_share_setopt(share, CURLSHOPT_UNLOCKFUNC, share_unlock);
+  curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+  curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+  curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_CONNECT);
+}
+
+void http_cleanup(void) {
+  pthread_mutex_lock(&pool_lock);
+  for (int i = 0; i < pool_count; i++)
+    curl_easy_cleanup(pool[i]);
+  pool_count = 0;
+  pthread_mutex_unlock(&pool_lock);
+
+  if (share) {
+    curl_share_cleanup(share);
+    share = NULL;
+    for (int i = 0; i < CURL_LOCK_DATA_LAST; i++)
+      pthread_mutex_destroy(&share_locks[i]);
+  }
+}
+
+/**
+ * Hands out an easy handle with the options every request in the app uses.
+ * curl_easy_reset() keeps the handle's connection and session caches, so a
+ * recycled handle goes straight back to a warm connection.
+ */
+CURL* http_handle(void) {
+  CURL* handle = NULL;
+
+  pthread_mutex_lock(&pool_lock);
+  if (pool_count > 0) handle = pool[--pool_count];
+  pthread_mutex_unlock(&pool_lock);
+
+  if (handle) curl_easy_reset(handle);
+  else handle = curl_easy_init();
+  if (!handle) return NULL;
+
+  if (share) curl_easy_setopt(handle, CURLOPT_SHARE, share);
+  curl_easy_setopt(handle, CURLOPT_USERAGENT, HTTP_USER_AGENT);
+  curl_easy_setopt(handle, CURLOPT_FOLLOWLOCATION, 1L);
+  curl_easy_setopt(handle, CURLOPT_TCP_KEEPALIVE, 1L);
+  curl_easy_setopt(handle, CURLOPT_MAXAGE_CONN, 300L);
+  curl_easy_setopt(handle, CURLOPT_DNS_CACHE_TIMEOUT, 600L);
+  curl_easy_setopt(handle, CURLOPT_NOSIGNAL, 1L);
+  // Empty string = offer every encoding this libcurl can decode
+  curl_easy_setopt(handle, CURLOPT_ACCEPT_ENCODING, "");
+
+  return handle;
+}
+
+void http_release(CURL* handle) {
+  if (!handle) return;
+
+  pthread_mutex_lock(&pool_lock);
+  if (pool_count < HTTP_POOL_SIZE) {
+    pool[pool_count++] = handle;
+    handle = NULL;
+  }
+  pthread_mutex_unlock(&pool_lock);
+
+  if (handle) curl_easy_cleanup(handle);
+}
+
+static size_t sink_write(void* data, size_t size, size_t nmemb, void* userdata) {
+  HttpSink* sink = userdata;
+  size_t written = sink->write
+    ? sink->write(data, size, nmemb, sink->userdata)
+    : fwrite(data, size, nmemb, sink->userdata) * size;
+  sink->decoded += written;
+  return written;
+}
+
+void http_set_sink(CURL* handle, HttpSink* sink, http_write_fn write, void* userdata) {
+  sink->write = write;
+  sink->userdata = userdata;
+  sink->decoded = 0;
+
+  curl_easy_setopt(handle, CURLOPT_WRITEFUNCTION, sink_write);
+  curl_easy_setopt(handle, CURLOPT_WRITEDATA, sink);
+  curl_easy_setopt(handle, CURLOPT_PRIVATE, sink);
+}
+
+CURLcode http_perform(CURL* handle) {
+  CURLcode res = curl_easy_perform(handle);
+  http_record_transfer(handle, res);
+  return res;
+}
+
+void http_record_transfer(CURL* handle, CURLcode res) {
+  long connects = 0;
+  curl_off_t wire = 0;
+  char* url = NULL;
+  HttpSink* sink = NULL;
+
+  curl_easy_getinfo(handle, CURLINFO_NUM_CONNECTS, &connects);
+  curl_easy_getinfo(handle, CURLINFO_SIZE_DOWNLOAD_T, &wire);
+  curl_easy_getinfo(handle, CURLINFO_EFFECTIVE_URL, &url);
+  curl_easy_getinfo(handle, CURLINFO_PRIVATE, (char**)&sink);
+  curl_off_t decoded = sink ? sink->decoded : wire;
+
+  pthread_mutex_lock(&stats_lock);
+  stats.transfers++;
+  if (res != CURLE_OK) stats.failures++;
+  if (connects > 0) stats.new_connections += connects;
+  else if (res == CURLE_OK) stats.handshakes_avoided++;
+
+  stats.wire_bytes += wire;
+  stats.decoded_bytes += decoded;
+
+  memmove(&stats.recent[1], &stats.recent[0], sizeof(HttpTransfer) * (HTTP_RECENT - 1));
+  snprintf(stats.recent[0].url, sizeof(stats.recent[0].url), "%s", url ? url : "");
+  stats.recent[0].wire = wire;
+  stats.recent[0].decoded = decoded;
+  if (stats.recent_count < HTTP_RECENT) stats.recent_count++;
+  pthread_mutex_unlock(&stats_lock);
+}
+
+void http_get_stats(HttpStats* out) {
+  pthread_mutex_lock(&stats_lock);
+  *out = stats;
+  pthread_mutex_unlock(&stats_lock);
+}
@@ -0,0 +1,64 @@
+#ifndef HTTP_H
+#define HTTP_H
+
+#include <curl/curl.h>
+
+#define HTTP_POOL_SIZE 8
+#define HTTP_RECENT 5
+#define HTTP_USER_AGENT "Mozilla/5.0 (compatible; NovelBot/1.0)"
+
+typedef size_t (*http_write_fn)(void* data, size_t size, size_t nmemb, void* userdata);
+
+/**
+ * Body consumer for a transfer. Bytes reach `write` already decoded (curl
+ * inflates gzip/deflate/br/zstd as they stream in); the sink counts what it
+ * forwards so it can be compared with what came over the wire. A NULL write
+ * fwrite()s into userdata, like libcurl's default.
+ */
+typedef struct {
+  http_write_fn write;
+  void* userdata;
+  curl_off_t decoded;
+} HttpSink;
+
+typedef struct {
+  char url[96];
+  curl_off_t wire;    // Body bytes received, still encoded
+  curl_off_t decoded; // Body bytes delivered to the consumer
+} HttpTransfer;
+
+typedef struct {
+  long transfers;          // Transfers performed through the pool
+  long failures;           // Transfers that returned an error
+  long new_connections;    // Transfers that had to connect (DNS + TCP + TLS)
+  long handshakes_avoided; // Transfers served over an already warm connection
+  curl_off_t wire_bytes;
+  curl_off_t decoded_bytes;
+  HttpTransfer recent[HTTP_RECENT]; // Most recent first
+  int recent_count;
+} HttpStats;
+
+// Sets up the process-wide share handle (DNS, TLS sessions, connections)
+void http_init(void);
+
+// Releases every pooled handle and the share handle
+void http_cleanup(void);
+
+// Borrows an easy handle wired to the shared state, reset to the defaults
+CURL* http_handle(void);
+
+// Returns a handle to the pool so its connections stay warm
+void http_release(CURL* handle);
+
+// Routes the response body through `sink`, which must outlive the transfer
+void http_set_sink(CURL* handle, HttpSink* sink, http_write_fn write, void* userdata);
+
+// curl_easy_perform() plus connection reuse and byte accounting
+CURLcode http_perform(CURL* handle);
+
+// Accounts a transfer finished elsewhere (e.g. on a multi handle)
+void http_record_transfer(CURL* handle, CURLcode res);
+
+void http_get_stats(HttpStats* out);
+
+#endif
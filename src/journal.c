@@ -0,0 +1,193 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "journal.h"
+#include "crc32.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+int journal_init(Journal* j, const char* path, const char* magic, size_t max_payload) {
+  memset(j, 0, sizeof(*j));
+  j->fd = -1;
+  j->tmp_fd = -1;
+  j->max_payload = max_payload;
+  memcpy(j->magic, magic, 4);
+  return snprintf(j->path, sizeof(j->path), "%s", path) < (int)sizeof(j->path);
+}
+
+static void frame(unsigned char head[JOURNAL_RECORD_HEADER], const void* payload, size_t len) {
+  uint32_t len32 = (uint32_t)len;
+  uint32_t crc = crc32(payload, len);
+  memcpy(head, &len32, 4);
+  memcpy(head + 4, &crc, 4);
+}
+
+// One write for header and payload, so a record is never split by another
+static int write_record(int fd, const void* payload, size_t len) {
+  unsigned char head[JOURNAL_RECORD_HEADER];
+  frame(head, payload, len);
+  struct iovec iov[2] = {
+    { .iov_base = head, .iov_len = sizeof(head) },
+    { .iov_base = (void*)payload, .iov_len = len },
+  };
+  return writev(fd, iov, 2) == (ssize_t)(sizeof(head) + len);
+}
+
+JournalLoad journal_load(Journal* j, journal_record_fn fn, void* userdata) {
+  int fd = open(j->path, O_RDWR);
+  if (fd < 0) {
+    j->unread = errno != ENOENT;
+    return j->unread ? JOURNAL_UNREAD : JOURNAL_MISSING;
+  }
+
+  FILE* f = fdopen(fd, "rb");
+  unsigned char* payload = malloc(j->max_payload + 1);
+  if (!f || !payload) {
+    if (f) fclose(f);
+    else close(fd);
+    free(payload);
+    j->unread = 1;
+    return JOURNAL_UNREAD;
+  }
+
+  char magic[4];
+  long good = 0;
+  long records = 0;
+  int header = fread(magic, 1, 4, f) == 4 && memcmp(magic, j->magic, 4) == 0;
+
+  if (header) {
+    good = 4;
+    unsigned char head[JOURNAL_RECORD_HEADER];
+    while (fread(head, 1, sizeof(head), f) == sizeof(head)) {
+      uint32_t len, crc;
+      memcpy(&len, head, 4);
+      memcpy(&crc, head + 4, 4);
+      if (len > j->max_payload || fread(payload, 1, len, f) != len) break;
+      if (crc32(payload, len) != crc) break;
+
+      payload[len] = '\0'; // Lets a record end in a string
+      if (!fn(payload, len, userdata)) break;
+      records++;
+      good += JOURNAL_RECORD_HEADER + len;
+    }
+  }
+  free(payload);
+  j->records = records;
+
+  // A read error says nothing about what is on disk, so leave it be
+  struct stat st;
+  if (ferror(f) || fstat(fd, &st) != 0) {
+    fclose(f);
+    j->unread = 1;
+    return JOURNAL_UNREAD;
+  }
+
+  JournalLoad result = JOURNAL_LOADED;
+  if (st.st_size > good) {
+    if (header && records > 0) {
+      if (ftruncate(fd, good) != 0) j->torn = 1;
+    } else {
+      // Another format or garbage: keep it for whoever wants to look
+      char bad[PATH_MAX + 4];
+      snprintf(bad, sizeof(bad), "%s.bad", j->path);
+      if (rename(j->path, bad) == 0) result = JOURNAL_RESET;
+      else {
+        j->unread = 1;
+        result = JOURNAL_UNREAD;
+      }
+    }
+  }
+  fclose(f);
+  return result;
+}
+
+int journal_append(Journal* j, const void* payload, size_t len) {
+  if (j->fd < 0) {
+    j->fd = open(j->path, O_WRONLY | O_APPEND | O_CREAT, 0644);
+    if (j->fd < 0) return 0;
+  }
+
+  struct stat st;
+  if (fstat(j->fd, &st) != 0) return 0;
+  if (st.st_size == 0 && write(j->fd, j->magic, 4) != 4) return 0;
+
+  // Roll back a short write instead of leaving a torn record
+  if (!write_record(j->fd, payload, len)) {
+    if (ftruncate(j->fd, st.st_size ? st.st_size : 4) != 0) return 0;
+    return 0;
+  }
+  j->records++;
+  return 1;
+}
+
+int journal_rewrite_begin(Journal* j) {
+  if (j->unread) return 0; // It would drop the records that weren't read
+
+  char tmp[PATH_MAX + 4];
+  snprintf(tmp, sizeof(tmp), "%s.tmp", j->path);
+  j->tmp_fd = open(tmp, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (j->tmp_fd < 0) return 0;
+
+  j->rewritten = 0;
+  if (write(j->tmp_fd, j->magic, 4) != 4) {
+    journal_rewrite_end(j, 0);
+    return 0;
+  }
+  return 1;
+}
+
+int journal_rewrite_put(Journal* j, const void* payload, size_t len) {
+  if (j->tmp_fd < 0 || !write_record(j->tmp_fd, payload, len)) return 0;
+  j->rewritten++;
+  return 1;
+}
+
+// Makes a rename in the journal's directory durable
+static void sync_dir(const char* path) {
+  char dir[PATH_MAX];
+  snprintf(dir, sizeof(dir), "%s", path);
+  char* slash = strrchr(dir, '/');
+  if (slash == dir) slash[1] = '\0';
+  else if (slash) *slash = '\0';
+  else snprintf(dir, sizeof(dir), ".");
+
+  int fd = open(dir, O_RDONLY | O_DIRECTORY);
+  if (fd < 0) return;
+  fsync(fd);
+  close(fd);
+}
+
+int journal_rewrite_end(Journal* j, int ok) {
+  if (j->tmp_fd < 0) return 0;
+
+  char tmp[PATH_MAX + 4];
+  snprintf(tmp, sizeof(tmp), "%s.tmp", j->path);
+  ok = ok && fsync(j->tmp_fd) == 0;
+  if (close(j->tmp_fd) != 0) ok = 0;
+  j->tmp_fd = -1;
+  if (!ok || rename(tmp, j->path) != 0) {
+    unlink(tmp);
+    return 0;
+  }
+  sync_dir(j->path);
+
+  // Appends go to the new file from here on
+  if (j->fd >= 0) close(j->fd);
+  j->fd = -1;
+  j->records = j->rewritten;
+  j->torn = 0;
+  return 1;
+}
+
+void journal_close(Journal* j) {
+  if (j->fd >= 0) close(j->fd);
+  if (j->tmp_fd >= 0) journal_rewrite_end(j, 0);
+  j->fd = -1;
+}
@@ -0,0 +1,63 @@
+#ifndef JOURNAL_H
+#define JOURNAL_H
+
+#include <stddef.h>
+#include <limits.h>
+
+#define JOURNAL_RECORD_HEADER 8 // Payload length and CRC-32, both uint32
+
+// Called for each record on load; returns 0 if the payload doesn't decode
+typedef int (*journal_record_fn)(const unsigned char* payload, size_t len, void* userdata);
+
+typedef enum {
+  JOURNAL_MISSING,  // No file yet
+  JOURNAL_LOADED,   // Replayed; a torn tail was cut off
+  JOURNAL_RESET,    // Not a journal we can read; moved aside to <path>.bad
+  JOURNAL_UNREAD,   // There but couldn't be read; left as it is
+} JournalLoad;
+
+/**
+ * An append-only file of CRC-checked records behind a 4-byte magic. Each
+ * append is one write, and a short one is rolled back, so a crash tears
+ * at most the last record, which the next load cuts off. The file is
+ * rewritten from memory through journal_rewrite_*(): the new copy is
+ * synced, renamed over the old one and the directory synced, so a crash
+ * leaves one whole journal or the other.
+ */
+typedef struct {
+  char path[PATH_MAX];
+  char magic[4];
+  size_t max_payload;
+  int fd;           // Opened for appending on first use
+  int tmp_fd;       // The rewrite in progress
+  long records;     // Records in the file, loaded or appended
+  long rewritten;
+  int torn;         // A torn tail that couldn't be cut off; rewrite it
+  int unread;       // The file couldn't be read, so it is never rewritten
+} Journal;
+
+// Returns 0 if path doesn't fit
+int journal_init(Journal* j, const char* path, const char* magic, size_t max_payload);
+
+/**
+ * Replays the file through fn, stopping at the first record that fails
+ * its length or CRC check or that fn rejects. Only a file with a valid
+ * magic and at least one good record is truncated there; one without is
+ * moved aside, and one that couldn't be read is left alone.
+ */
+JournalLoad journal_load(Journal* j, journal_record_fn fn, void* userdata);
+
+// Appends one record; returns 0 if it couldn't be written
+int journal_append(Journal* j, const void* payload, size_t len);
+
+// Starts writing a replacement file; returns 0 if it can't be
+int journal_rewrite_begin(Journal* j);
+
+int journal_rewrite_put(Journal* j, const void* payload, size_t len);
+
+// Puts the replacement in place if ok and everything was written
+int journal_rewrite_end(Journal* j, int ok);
+
+void journal_close(Journal* j);
+
+#endif
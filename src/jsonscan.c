@@ -0,0 +1,389 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "jsonscan.h"
+#include "entity.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+enum {
+  EXPECT_VALUE,   // Start of document, after ':' or inside an array
+  EXPECT_KEY,     // After '{' or ',' inside an object
+  EXPECT_COLON,
+  AFTER_VALUE,    // Waiting for ',' or the closing bracket
+  IN_STRING,
+  IN_ESCAPE,      // After a backslash
+  IN_UNICODE,     // Reading the four hex digits of \uXXXX
+  IN_LITERAL,     // Number, true, false or null
+  DOCUMENT_DONE,
+  SCAN_ERROR
+};
+
+void jsonscan_init(JsonScan* js, const char* const selectors[], int count, jsonscan_fn callback, void* userdata) {
+  memset(js, 0, sizeof(*js));
+  js->state = EXPECT_VALUE;
+  js->callback = callback;
+  js->userdata = userdata;
+  if (count > JSONSCAN_MAX_SELECTORS) count = JSONSCAN_MAX_SELECTORS;
+
+  size_t total = 0;
+  for (int i = 0; i < count; i++) total += strlen(selectors[i]) * 2 + 2;
+  js->selector_text = malloc(total + 1);
+  if (!js->selector_text) {
+    js->state = SCAN_ERROR;
+    return;
+  }
+
+  // Split "results[].title" into "results", "[]", "title"
+  char* out = js->selector_text;
+  for (int i = 0; i < count; i++) {
+    const char* p = selectors[i];
+    int n = 0;
+    while (*p && n < JSONSCAN_MAX_SEGMENTS) {
+      if (*p == '.') {
+        p++;
+        continue;
+      }
+      js->segments[i][n++] = out;
+      if (strncmp(p, "[]", 2) == 0) {
+        memcpy(out, "[]", 3);
+        out += 3;
+        p += 2;
+        continue;
+      }
+      while (*p && *p != '.' && strncmp(p, "[]", 2) != 0) *out++ = *p++;
+      *out++ = '\0';
+    }
+    js->segment_count[i] = n;
+  }
+  js->selectors = count;
+}
+
+void jsonscan_free(JsonScan* js) {
+  free(js->selector_text);
+  free(js->value);
+  js->selector_text = NULL;
+  js->value = NULL;
+  js->value_cap = 0;
+}
+
+// Selectors that reach the next child of the current container
+static uint32_t child_mask(JsonScan* js) {
+  if (js->depth == 0) return (1u << js->selectors) - 1;
+  JsonFrame* top = &js->stack[js->depth - 1];
+  if (top->container == '{') return top->value_mask;
+
+  uint32_t mask = 0;
+  int level = js->depth - 1;
+  for (int i = 0; i < js->selectors; i++) {
+    if ((top->mask >> i & 1) && level < js->segment_count[i] &&
+        strcmp(js->segments[i][level], "[]") == 0) {
+      mask |= 1u << i;
+    }
+  }
+  return mask;
+}
+
+// Of the selectors in mask, those whose path ends at the value about to start
+static uint32_t ending_here(JsonScan* js, uint32_t mask) {
+  uint32_t ends = 0;
+  for (int i = 0; i < js->selectors; i++) {
+    if ((mask >> i & 1) && js->segment_count[i] == js->depth) ends |= 1u << i;
+  }
+  return ends;
+}
+
+static void match_key(JsonScan* js) {
+  JsonFrame* top = &js->stack[js->depth - 1];
+  top->value_mask = 0;
+  if (!top->mask || js->key_len >= JSONSCAN_KEY_MAX) return;
+  js->key[js->key_len] = '\0';
+
+  int level = js->depth - 1;
+  for (int i = 0; i < js->selectors; i++) {
+    if ((top->mask >> i & 1) && level < js->segment_count[i] &&
+        strcmp(js->segments[i][level], js->key) == 0) {
+      top->value_mask |= 1u << i;
+    }
+  }
+}
+
+static void emit(JsonScan* js, uint32_t selectors, const char* value, size_t len) {
+  for (int i = 0; i < js->selectors; i++) {
+    if (selectors >> i & 1) js->callback(i, value, len, js->userdata);
+  }
+}
+
+static int append(JsonScan* js, const char* data, size_t len) {
+  if (js->is_key) {
+    // Keys longer than the buffer can't match a selector anyway
+    for (size_t i = 0; i < len; i++) {
+      if (js->key_len < JSONSCAN_KEY_MAX - 1) js->key[js->key_len] = data[i];
+      js->key_len++;
+    }
+    return 1;
+  }
+  if (!js->emit) return 1;
+
+  if (js->value_len + len >= js->value_cap) {
+    size_t cap = js->value_cap ? js->value_cap : 256;
+    while (js->value_len + len >= cap) cap *= 2;
+    char* ptr = realloc(js->value, cap);
+    if (!ptr) return 0;
+    js->value = ptr;
+    js->value_cap = cap;
+  }
+  memcpy(js->value + js->value_len, data, len);
+  js->value_len += len;
+  return 1;
+}
+
+static int append_codepoint(JsonScan* js, uint32_t cp) {
+  char utf8[4];
+  return append(js, utf8, utf8_encode(cp, utf8));
+}
+
+static void end_value(JsonScan* js) {
+  if (js->emit) {
+    if (js->value) js->value[js->value_len] = '\0';
+    emit(js, js->emit, js->value ? js->value : "", js->value_len);
+  }
+  js->emit = 0;
+  js->value_len = 0;
+  js->state = js->depth ? AFTER_VALUE : DOCUMENT_DONE;
+}
+
+static int end_string(JsonScan* js) {
+  if (js->high_surrogate) {
+    js->high_surrogate = 0;
+    if (!append_codepoint(js, 0xFFFD)) return 0;
+  }
+  if (js->is_key) {
+    js->is_key = 0;
+    match_key(js);
+    js->state = EXPECT_COLON;
+    return 1;
+  }
+  end_value(js);
+  return 1;
+}
+
+static int open_container(JsonScan* js, char c, uint32_t mask) {
+  if (js->depth >= JSONSCAN_MAX_DEPTH) return 0;
+
+  // Selectors that end here fire on close; the rest look one level deeper
+  uint32_t ends = ending_here(js, mask);
+  JsonFrame* frame = &js->stack[js->depth++];
+  frame->container = (uint8_t)c;
+  frame->ends = ends;
+  frame->mask = mask & ~ends;
+  frame->value_mask = 0;
+  js->state = c == '{' ? EXPECT_KEY : EXPECT_VALUE;
+  return 1;
+}
+
+static int close_container(JsonScan* js, char c) {
+  if (js->depth == 0) return 0;
+  JsonFrame* top = &js->stack[js->depth - 1];
+  if ((c == '}') != (top->container == '{')) return 0;
+
+  uint32_t ends = top->ends;
+  js->depth--;
+  if (ends) emit(js, ends, NULL, 0);
+  js->state = js->depth ? AFTER_VALUE : DOCUMENT_DONE;
+  return 1;
+}
+
+static int start_value(JsonScan* js, char c) {
+  uint32_t mask = child_mask(js);
+  if (c == '{' || c == '[') return open_container(js, c, mask);
+
+  js->emit = ending_here(js, mask);
+  js->value_len = 0;
+  js->is_key = 0;
+
+  if (c == '"') {
+    js->state = IN_STRING;
+    return 1;
+  }
+  if (c == '-' || (c >= '0' && c <= '9') || c == 't' || c == 'f' || c == 'n') {
+    js->state = IN_LITERAL;
+    return append(js, &c, 1);
+  }
+  return 0;
+}
+
+static int is_ws(char c) {
+  return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+
+static int literal_char(char c) {
+  return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || c == '-' || c == '+' || c == '.' || c == 'E';
+}
+
+static int hex_value(char c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  return -1;
+}
+
+static int escape(JsonScan* js, char c) {
+  static const char from[] = "\"\\/bfnrt";
+  static const char to[] = "\"\\/\b\f\n\r\t";
+
+  if (c == 'u') {
+    js->unicode = 0;
+    js->unicode_digits = 0;
+    js->state = IN_UNICODE;
+    return 1;
+  }
+  const char* hit = memchr(from, c, sizeof(from) - 1);
+  if (!hit) return 0;
+  js->state = IN_STRING;
+  return append(js, &to[hit - from], 1);
+}
+
+// Joins surrogate pairs; unpaired halves become U+FFFD like in browsers
+static int unicode_done(JsonScan* js) {
+  uint32_t cp = js->unicode;
+  js->state = IN_STRING;
+
+  if (cp >= 0xD800 && cp <= 0xDBFF) {
+    int ok = 1;
+    if (js->high_surrogate) ok = append_codepoint(js, 0xFFFD);
+    js->high_surrogate = cp;
+    return ok;
+  }
+  if (cp >= 0xDC00 && cp <= 0xDFFF) {
+    if (!js->high_surrogate) return append_codepoint(js, 0xFFFD);
+    cp = 0x10000 + ((js->high_surrogate - 0xD800) << 10) + (cp - 0xDC00);
+    js->high_surrogate = 0;
+    return append_codepoint(js, cp);
+  }
+  if (js->high_surrogate) {
+    js->high_surrogate = 0;
+    if (!append_codepoint(js, 0xFFFD)) return 0;
+  }
+  return append_codepoint(js, cp);
+}
+
+int jsonscan_feed(JsonScan* js, const char* data, size_t len) {
+  size_t i = 0;
+
+  while (i < len) {
+    char c = data[i];
+
+    switch (js->state) {
+      case IN_STRING: {
+        // Copy everything up to the next quote or backslash in one go
+        size_t start = i;
+        while (i < len && data[i] != '"' && data[i] != '\\') i++;
+        if (i > start && js->high_surrogate) {
+          js->high_surrogate = 0;
+          if (!append_codepoint(js, 0xFFFD)) goto fail;
+        }
+        if (!append(js, data + start, i - start)) goto fail;
+        if (i == len) return 1;
+
+        if (data[i++] == '"') {
+          if (!end_string(js)) goto fail;
+        } else {
+          js->state = IN_ESCAPE;
+        }
+        continue;
+      }
+
+      case IN_ESCAPE:
+        if (c != 'u' && js->high_surrogate) {
+          js->high_surrogate = 0;
+          if (!append_codepoint(js, 0xFFFD)) goto fail;
+        }
+        if (!escape(js, c)) goto fail;
+        i++;
+        continue;
+
+      case IN_UNICODE: {
+        int digit = hex_value(c);
+        if (digit < 0) goto fail;
+        js->unicode = js->unicode << 4 | (uint32_t)digit;
+        i++;
+        if (++js->unicode_digits == 4 && !unicode_done(js)) goto fail;
+        continue;
+      }
+
+      case IN_LITERAL: {
+        size_t start = i;
+        while (i < len && literal_char(data[i])) i++;
+        if (!append(js, data + start, i - start)) goto fail;
+        // The terminating byte belongs to the next token
+        if (i < len) end_value(js);
+        continue;
+      }
+
+      case SCAN_ERROR:
+        return 0;
+
+      default:
+        break;
+    }
+
+    i++;
+    if (is_ws(c)) continue;
+
+    switch (js->state) {
+      case EXPECT_VALUE:
+        if (c == ']' && js->depth && js->stack[js->depth - 1].container == '[') {
+          if (!close_container(js, c)) goto fail;
+        } else if (!start_value(js, c)) {
+          goto fail;
+        }
+        break;
+
+      case EXPECT_KEY:
+        if (c == '}') {
+          if (!close_container(js, c)) goto fail;
+        } else if (c == '"') {
+          js->is_key = 1;
+          js->key_len = 0;
+          js->state = IN_STRING;
+        } else {
+          goto fail;
+        }
+        break;
+
+      case EXPECT_COLON:
+        if (c != ':') goto fail;
+        js->state = EXPECT_VALUE;
+        break;
+
+      case AFTER_VALUE:
+        if (c == ',') {
+          js->state = js->stack[js->depth - 1].container == '{' ? EXPECT_KEY : EXPECT_VALUE;
+        } else if (!close_container(js, c)) {
+          goto fail;
+        }
+        break;
+
+      default:
+        // Only whitespace may follow the document
+        goto fail;
+    }
+  }
+  return 1;
+
+fail:
+  js->state = SCAN_ERROR;
+  return 0;
+}
+
+size_t jsonscan_write(void* data, size_t size, size_t nmemb, void* userdata) {
+  size_t total = size * nmemb;
+  return jsonscan_feed(userdata, data, total) ? total : 0;
+}
+
+int jsonscan_finish(JsonScan* js) {
+  // A bare number at the very end has no terminator to close it
+  if (js->state == IN_LITERAL && js->depth == 0) end_value(js);
+  return js->state == DOCUMENT_DONE;
+}
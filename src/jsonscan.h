@@ -0,0 +1,74 @@
+#ifndef JSONSCAN_H
+#define JSONSCAN_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define JSONSCAN_MAX_SELECTORS 8
+#define JSONSCAN_MAX_SEGMENTS 8
+#define JSONSCAN_MAX_DEPTH 64
+#define JSONSCAN_KEY_MAX 128
+
+/**
+ * Called for every value a selector matches. Scalars arrive unescaped
+ * (numbers and literals as their raw text); a selector that names a
+ * container fires when the container closes, with value == NULL, which is
+ * handy as a "record finished" signal.
+ */
+typedef void (*jsonscan_fn)(int selector, const char* value, size_t len, void* userdata);
+
+typedef struct {
+  uint8_t container;  // '{' or '['
+  uint32_t mask;      // Selectors whose path still matches at this level
+  uint32_t value_mask; // Selectors matching the member currently being read
+  uint32_t ends;      // Selectors that end exactly at this container
+} JsonFrame;
+
+/**
+ * Push parser that pulls only selected paths out of a JSON document as it
+ * streams in. Selectors are dotted paths where "[]" steps into any array
+ * element, e.g. "[].title" or "results[].formats.text/plain". Subtrees no
+ * selector can reach are tokenised but never copied, so memory stays at the
+ * size of the largest selected value.
+ */
+typedef struct {
+  const char* segments[JSONSCAN_MAX_SELECTORS][JSONSCAN_MAX_SEGMENTS];
+  int segment_count[JSONSCAN_MAX_SELECTORS];
+  char* selector_text;
+  int selectors;
+
+  jsonscan_fn callback;
+  void* userdata;
+
+  JsonFrame stack[JSONSCAN_MAX_DEPTH];
+  int depth;
+  int state;
+  uint32_t emit;       // Selectors the value being read completes
+  int is_key;
+
+  char key[JSONSCAN_KEY_MAX];
+  size_t key_len;
+
+  char* value;         // Capture buffer, reused across values
+  size_t value_len;
+  size_t value_cap;
+
+  uint32_t unicode;    // \uXXXX being read
+  int unicode_digits;
+  uint32_t high_surrogate;
+} JsonScan;
+
+void jsonscan_init(JsonScan* js, const char* const selectors[], int count, jsonscan_fn callback, void* userdata);
+
+// Consumes the next chunk; returns 0 once the document turned out malformed
+int jsonscan_feed(JsonScan* js, const char* data, size_t len);
+
+// curl CURLOPT_WRITEFUNCTION adapter, userdata is the JsonScan
+size_t jsonscan_write(void* data, size_t size, size_t nmemb, void* userdata);
+
+// Returns 1 if exactly one complete document was read
+int jsonscan_finish(JsonScan* js);
+
+void jsonscan_free(JsonScan* js);
+
+#endif
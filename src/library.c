@@ -1,51 +1,140 @@
 #define _POSIX_C_SOURCE 200809L
 
 #include "library.h"
+#include "catalog.h"
 #include "ui.h"
 #include "controller.h"
+#include "fulltext.h"
+#include "chapter_cache.h"
+#include "chapter_controller.h"
 
-#include <dirent.h>
 #include <stdlib.h>
 #include <string.h>
-#include <sys/stat.h>
 #include <ncurses.h>
 #include <limits.h>
+#include <ctype.h>
 
 void open_library() {
   char lib_path[PATH_MAX];
   get_user_path(lib_path, "library", sizeof(lib_path));
 
-  DIR *dir = opendir(lib_path);
-  if (!dir) {
-    // Ncurses-safe error message
-    clear();
-    mvprintw(0, 0, "Library folder could not be accessed.");
-    mvprintw(1, 0, "Press any key to return...");
-    getch();
-    return;
-  }
+  while (1) {
+    // Only what changed since the last visit is looked at again
+    int count = catalog_sync();
+    if (count < 0) {
+      // Ncurses-safe error message
+      clear();
+      mvprintw(0, 0, "Library folder could not be accessed.");
+      mvprintw(1, 0, "Press any key to return...");
+      getch();
+      return;
+    }
 
-  struct dirent *entry;
-  char *books[200];
-  int count = 0;
+    if (count == 0) {
+      clear();
+      attron(COLOR_PAIR(4));
+      mvprintw(0, 0, "Library is empty.");
+      mvprintw(1, 0, "Press any key to return...");
+      attroff(COLOR_PAIR(4));
+      refresh();
+      getch();
+      return;
+    }
 
-  while ((entry = readdir(dir)) != NULL && count < 200) {
-    char path[PATH_MAX];
-    if (snprintf(path, sizeof(path), "%s/%s", lib_path, entry->d_name) >= (int)sizeof(path)){
+    // Most recently read first, so the book being read is at the top
+    int* order = malloc(count * sizeof(int));
+    char** labels = malloc(count * sizeof(char*));
+    if (!order || !labels) {
+      free(order);
+      free(labels);
+      return;
+    }
+    catalog_order(order);
+    for (int i = 0; i < count; i++) labels[i] = catalog_book(order[i])->title;
+
+    int choice = display_menu(labels, count);
+    int book = choice >= 0 ? order[choice] : -1;
+    free(order);
+    free(labels);
+    if (book < 0) break;
+
+    char path[PATH_MAX + 256];
+    if (snprintf(path, sizeof(path), "%s/%s", lib_path, catalog_book(book)->name) >= (int)sizeof(path)){
       continue;
     }
 
-    struct stat st;
-    if (stat(path, &st) == 0 && S_ISREG(st.st_mode)) {
-      books[count++] = strdup(entry->d_name);
+    FILE *fp = fopen(path, "r");
+    if (fp) {
+      display_book(fp, catalog_book(book)->name);
+      fclose(fp);
+
+      int line;
+      size_t pos;
+      if (read_progress(catalog_book(book)->name, &line, &pos)) catalog_note_read(book, line, pos);
     }
   }
-  closedir(dir);
+}
+
+static void show_indexing(int done, int total, void* ud) {
+  (void) ud;
+  if (total == 0) return;
+  attron(COLOR_PAIR(4));
+  mvprintw(2, 0, "Indexing %d of %d files...", done, total);
+  attroff(COLOR_PAIR(4));
+  clrtoeol();
+  refresh();
+}
+
+// A cached chapter file is "<slug>.txt", the slug ending in the chapter number
+static void open_chapter(const char* file, const char* find) {
+  char slug[FULLTEXT_NAME_MAX];
+  snprintf(slug, sizeof(slug), "%s", file);
+  size_t len = strlen(slug);
+  if (len > 4 && strcmp(slug + len - 4, ".txt") == 0) slug[len -= 4] = '\0';
+
+  char* text = chapter_cache_get(slug);
+  if (!text) return; // Evicted since it was indexed
+
+  size_t digits = len;
+  while (digits > 0 && isdigit((unsigned char)slug[digits - 1])) digits--;
+  int number = digits < len ? atoi(slug + digits) : 0;
+
+  char title[FULLTEXT_NAME_MAX];
+  snprintf(title, sizeof(title), "%.*s", (int)(digits > 0 && slug[digits - 1] == '-' ? digits - 1 : len), slug);
+  display_chapter_search(title, number, text, find);
+  free(text);
+}
+
+void search_library() {
+  char query[100];
+
+  echo();
+  clear();
+  attron(COLOR_PAIR(4));
+  mvprintw(0, 0, "Search the library for: ");
+  attroff(COLOR_PAIR(4));
+  getnstr(query, sizeof(query) - 1);
+  noecho();
+  query[strcspn(query, "\n")] = 0;
+  if (!query[0]) return;
+
+  // Only what changed since the last search is read again
+  if (fulltext_sync(show_indexing, NULL) < 0) {
+    clear();
+    mvprintw(0, 0, "The search index could not be opened.");
+    mvprintw(1, 0, "Press any key to return...");
+    getch();
+    return;
+  }
+
+  // The menu scrolls, so every result the index keeps is listed
+  FulltextHit hits[FULLTEXT_MAX_RESULTS];
+  int count = fulltext_query(query, hits, FULLTEXT_MAX_RESULTS);
 
   if (count == 0) {
     clear();
     attron(COLOR_PAIR(4));
-    mvprintw(0, 0, "Library is empty.");
+    mvprintw(0, 0, "No matches in the library.");
     mvprintw(1, 0, "Press any key to return...");
     attroff(COLOR_PAIR(4));
     refresh();
@@ -53,24 +142,41 @@ void open_library() {
     return;
   }
 
+  char* labels[FULLTEXT_MAX_RESULTS];
+  for (int i = 0; i < count; i++) {
+    char label[FULLTEXT_NAME_MAX + 64];
+    snprintf(label, sizeof(label), "%s %s — %u match%s", hits[i].kind == FULLTEXT_BOOK ? "[Book]   " : "[Chapter]",
+             hits[i].name, hits[i].hits, hits[i].hits == 1 ? "" : "es");
+    labels[i] = strdup(label);
+  }
+
+  // The reader opens on the first phrase, or else the first word
+  char find[100];
+  fulltext_focus(query, find, sizeof(find));
+
+  char lib_path[PATH_MAX];
+  get_user_path(lib_path, "library", sizeof(lib_path));
+
   while (1) {
-    int choice = display_menu(books, count);
+    int choice = display_menu(labels, count);
     if (choice == -1) break;
 
-    char path[PATH_MAX]; // Changed from 512 to PATH_MAX
-    if (snprintf(path, sizeof(path), "%s/%s", lib_path, books[choice]) >= (int)sizeof(path)){
+    if (hits[choice].kind == FULLTEXT_CHAPTER) {
+      open_chapter(hits[choice].name, find);
       continue;
     }
 
-    FILE *fp = fopen(path, "r");
+    char path[PATH_MAX];
+    if (snprintf(path, sizeof(path), "%s/%s", lib_path, hits[choice].name) >= (int)sizeof(path)) continue;
+    FILE* fp = fopen(path, "r");
     if (fp) {
-      display_book(fp, books[choice]);
+      display_book_search(fp, hits[choice].name, find);
       fclose(fp);
     }
   }
 
   for (int i = 0; i < count; i++)
-    free(books[i]);
+    free(labels[i]);
 }
 
 FILE* in_Library(char *book_name) {
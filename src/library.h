@@ -5,6 +5,9 @@
 
 void open_library();
 
+// Full-text search over the library and the cached chapters
+void search_library();
+
 FILE* in_Library(char* book_name);
 
 #endif
@@ -0,0 +1,126 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "line_map.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+int line_map_open(LineMap* map, int fd) {
+  memset(map, 0, sizeof(*map));
+
+  struct stat st;
+  if (fstat(fd, &st) != 0) return 0;
+  if (st.st_size == 0) {
+    map->complete = 1;
+    return 1;
+  }
+
+  void* data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  if (data == MAP_FAILED) return 0;
+  posix_madvise(data, st.st_size, POSIX_MADV_SEQUENTIAL);
+
+  map->data = data;
+  map->size = st.st_size;
+  map->mapped = 1;
+  return 1;
+}
+
+void line_map_open_buffer(LineMap* map, const char* data, size_t size) {
+  memset(map, 0, sizeof(*map));
+  map->data = data;
+  map->size = size;
+  map->complete = size == 0;
+}
+
+// Finds line starts until line `want` is known or the file ends
+static void scan_to(LineMap* map, int want) {
+  while (!map->complete && map->lines <= want) {
+    if (map->lines % LINE_MAP_STRIDE == 0) {
+      int slot = map->lines / LINE_MAP_STRIDE;
+      if (slot >= map->checkpoint_cap) {
+        int cap = map->checkpoint_cap ? map->checkpoint_cap * 2 : 256;
+        size_t* ptr = realloc(map->checkpoints, cap * sizeof(size_t));
+        if (!ptr) return;
+        map->checkpoints = ptr;
+        map->checkpoint_cap = cap;
+      }
+      map->checkpoints[slot] = map->scanned;
+    }
+
+    const char* nl = memchr(map->data + map->scanned, '\n', map->size - map->scanned);
+    map->scanned = nl ? (size_t)(nl - map->data) + 1 : map->size;
+    map->lines++;
+    if (map->scanned >= map->size) map->complete = 1;
+  }
+}
+
+const char* line_map_line(LineMap* map, int i, size_t* len) {
+  if (i < 0) return NULL;
+  scan_to(map, i);
+  if (i >= map->lines) return NULL;
+
+  // Walk forward from the cursor or the closest checkpoint, whichever is nearer
+  int line = i - i % LINE_MAP_STRIDE;
+  size_t pos = map->checkpoints[line / LINE_MAP_STRIDE];
+  if (map->cursor_line <= i && map->cursor_line > line) {
+    line = map->cursor_line;
+    pos = map->cursor_pos;
+  }
+  for (; line < i; line++) {
+    const char* nl = memchr(map->data + pos, '\n', map->size - pos);
+    pos = (size_t)(nl - map->data) + 1; // Line i exists, so every line before it ends
+  }
+  map->cursor_line = i;
+  map->cursor_pos = pos;
+
+  const char* start = map->data + pos;
+  const char* nl = memchr(start, '\n', map->size - pos);
+  size_t n = nl ? (size_t)(nl - start) : map->size - pos;
+  if (n > 0 && start[n - 1] == '\r') n--; // Gutenberg texts use CRLF
+  *len = n;
+  return start;
+}
+
+int line_map_locate(LineMap* map, size_t offset, size_t* pos) {
+  if (offset >= map->size) offset = map->size ? map->size - 1 : 0;
+  while (!map->complete && map->scanned <= offset) scan_to(map, map->lines);
+  if (map->lines == 0) {
+    *pos = 0;
+    return 0;
+  }
+
+  // Last checkpoint at or before offset, then line by line from there
+  int lo = 0, hi = (map->lines - 1) / LINE_MAP_STRIDE;
+  while (lo < hi) {
+    int mid = (lo + hi + 1) / 2;
+    if (map->checkpoints[mid] <= offset) lo = mid;
+    else hi = mid - 1;
+  }
+
+  int line = lo * LINE_MAP_STRIDE;
+  size_t start = map->checkpoints[lo];
+  for (;;) {
+    const char* nl = memchr(map->data + start, '\n', map->size - start);
+    if (!nl || (size_t)(nl - map->data) >= offset) break;
+    start = (size_t)(nl - map->data) + 1;
+    line++;
+  }
+  *pos = offset - start;
+  return line;
+}
+
+int line_map_count(const LineMap* map) {
+  return map->lines;
+}
+
+int line_map_complete(const LineMap* map) {
+  return map->complete;
+}
+
+void line_map_close(LineMap* map) {
+  if (map->mapped) munmap((void*)map->data, map->size);
+  free(map->checkpoints);
+  memset(map, 0, sizeof(*map));
+}
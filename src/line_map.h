@@ -0,0 +1,53 @@
+#ifndef LINE_MAP_H
+#define LINE_MAP_H
+
+#include <stddef.h>
+
+// Lines between recorded offsets; a lookup scans at most this many
+#define LINE_MAP_STRIDE 64
+
+/**
+ * A text file mapped into memory and split into lines on demand. Lines
+ * are found only as far as someone has asked for, and only every
+ * LINE_MAP_STRIDE-th start is remembered, so opening is constant time and
+ * the index stays a small fraction of the file; the text itself is read
+ * straight from the page cache.
+ */
+typedef struct {
+  const char* data;
+  size_t size;
+  int mapped;            // Whether data is our own mapping of a file
+
+  size_t* checkpoints;   // Offset of lines 0, STRIDE, 2 * STRIDE, ...
+  int checkpoint_cap;
+  int lines;             // Lines found so far
+  size_t scanned;        // Where the next unfound line starts
+  int complete;          // Whether the whole file has been scanned
+
+  int cursor_line;       // Last line looked up, so reading on is O(1)
+  size_t cursor_pos;
+} LineMap;
+
+// Maps the file open on fd; returns 0 if it can't be read
+int line_map_open(LineMap* map, int fd);
+
+// Splits text already in memory, which must outlive the map
+void line_map_open_buffer(LineMap* map, const char* data, size_t size);
+
+/**
+ * Line i without its line break (not NUL-terminated), or NULL past the
+ * end of the file. Finds lines up to i first if needed.
+ */
+const char* line_map_line(LineMap* map, int i, size_t* len);
+
+// Line holding byte `offset` of the text, with *pos set to where in it
+int line_map_locate(LineMap* map, size_t offset, size_t* pos);
+
+// Lines found so far; the total once line_map_complete() is true
+int line_map_count(const LineMap* map);
+
+int line_map_complete(const LineMap* map);
+
+void line_map_close(LineMap* map);
+
+#endif
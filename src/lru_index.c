@@ -0,0 +1,335 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "lru_index.h"
+#include "crc32.h"
+#include "journal.h"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define INDEX_MAGIC "NCL2"
+#define RECORD_FIXED 17                      // Op byte, uint64 size, int64 time
+#define RECORD_MAX (RECORD_FIXED + LRU_KEY_MAX)
+
+// Rewrite the index once it is this long and mostly superseded records
+#define COMPACT_MIN_RECORDS 64
+#define COMPACT_RATIO 4
+
+enum { OP_ADD = 1, OP_TOUCH, OP_DEL };
+
+static uint32_t hash_key(const char* s) {
+  uint32_t h = 2166136261u;
+  while (*s) h = (h ^ (unsigned char)*s++) * 16777619u;
+  return h;
+}
+
+static LruEntry** find_link(const LruIndex* lru, const char* key) {
+  LruEntry** link = &lru->buckets[hash_key(key) & (lru->bucket_count - 1)];
+  while (*link && strcmp((*link)->key, key) != 0) link = &(*link)->chain;
+  return link;
+}
+
+static void unlink_recency(LruIndex* lru, LruEntry* e) {
+  if (e->newer) e->newer->older = e->older;
+  else lru->newest = e->older;
+  if (e->older) e->older->newer = e->newer;
+  else lru->oldest = e->newer;
+  e->newer = e->older = NULL;
+}
+
+static void push_newest(LruIndex* lru, LruEntry* e) {
+  e->older = lru->newest;
+  e->newer = NULL;
+  if (lru->newest) lru->newest->newer = e;
+  lru->newest = e;
+  if (!lru->oldest) lru->oldest = e;
+}
+
+static void grow_buckets(LruIndex* lru) {
+  if (lru->count * 2 < lru->bucket_count) return;
+
+  int count = lru->bucket_count * 2;
+  LruEntry** table = calloc(count, sizeof(LruEntry*));
+  if (!table) return;
+
+  for (int i = 0; i < lru->bucket_count; i++) {
+    LruEntry* e = lru->buckets[i];
+    while (e) {
+      LruEntry* next = e->chain;
+      uint32_t slot = hash_key(e->key) & (count - 1);
+      e->chain = table[slot];
+      table[slot] = e;
+      e = next;
+    }
+  }
+  free(lru->buckets);
+  lru->buckets = table;
+  lru->bucket_count = count;
+}
+
+/* ---- In-memory operations, shared by replay and the public calls ---- */
+
+static void apply_add(LruIndex* lru, const char* key, uint64_t size, time_t when) {
+  LruEntry** link = find_link(lru, key);
+  LruEntry* e = *link;
+
+  if (e) {
+    lru->bytes -= e->size;
+    unlink_recency(lru, e);
+  } else {
+    e = calloc(1, sizeof(LruEntry));
+    if (!e || !(e->key = strdup(key))) {
+      free(e);
+      return;
+    }
+    *link = e;
+    lru->count++;
+  }
+  e->size = size;
+  e->stored = e->used = when;
+  lru->bytes += size;
+  push_newest(lru, e);
+  grow_buckets(lru);
+}
+
+static int apply_touch(LruIndex* lru, const char* key, time_t when) {
+  LruEntry* e = *find_link(lru, key);
+  if (!e) return 0;
+  e->used = when;
+  if (lru->newest != e) {
+    unlink_recency(lru, e);
+    push_newest(lru, e);
+  }
+  return 1;
+}
+
+static void apply_del(LruIndex* lru, const char* key) {
+  LruEntry** link = find_link(lru, key);
+  LruEntry* e = *link;
+  if (!e) return;
+
+  *link = e->chain;
+  unlink_recency(lru, e);
+  lru->bytes -= e->size;
+  lru->count--;
+  free(e->key);
+  free(e);
+}
+
+/* ---- Index file ---- */
+
+static size_t encode(unsigned char* buf, int op, const char* key, uint64_t size, time_t when) {
+  size_t key_len = strlen(key);
+  int64_t stamp = (int64_t)when;
+
+  buf[0] = (unsigned char)op;
+  memcpy(buf + 1, &size, 8);
+  memcpy(buf + 9, &stamp, 8);
+  memcpy(buf + RECORD_FIXED, key, key_len);
+  return RECORD_FIXED + key_len;
+}
+
+static int compact(LruIndex* lru);
+
+static void append(LruIndex* lru, int op, const char* key, uint64_t size, time_t when) {
+  unsigned char buf[RECORD_MAX];
+  size_t len = encode(buf, op, key, size, when);
+  if (!journal_append(&lru->journal, buf, len)) return;
+
+  long records = lru->journal.records;
+  if (records >= COMPACT_MIN_RECORDS && records > COMPACT_RATIO * (long)lru->count)
+    compact(lru);
+}
+
+// Writes the live entries oldest first to a new index
+static int compact(LruIndex* lru) {
+  if (!journal_rewrite_begin(&lru->journal)) return 0;
+
+  int ok = 1;
+  unsigned char buf[RECORD_MAX];
+  for (LruEntry* e = lru->oldest; ok && e; e = e->newer) {
+    // A touch after the last write is folded into one more record
+    size_t len = encode(buf, OP_ADD, e->key, e->size, e->stored);
+    ok = journal_rewrite_put(&lru->journal, buf, len);
+    if (ok && e->used != e->stored) {
+      len = encode(buf, OP_TOUCH, e->key, 0, e->used);
+      ok = journal_rewrite_put(&lru->journal, buf, len);
+    }
+  }
+  return journal_rewrite_end(&lru->journal, ok);
+}
+
+static int replay(const unsigned char* payload, size_t len, void* userdata) {
+  LruIndex* lru = userdata;
+  if (len <= RECORD_FIXED) return 0;
+
+  uint64_t size;
+  int64_t stamp;
+  memcpy(&size, payload + 1, 8);
+  memcpy(&stamp, payload + 9, 8);
+  const char* key = (const char*)payload + RECORD_FIXED; // The journal ends it with a NUL
+
+  if (payload[0] == OP_ADD) apply_add(lru, key, size, (time_t)stamp);
+  else if (payload[0] == OP_TOUCH) apply_touch(lru, key, (time_t)stamp);
+  else if (payload[0] == OP_DEL) apply_del(lru, key);
+  else return 0;
+  return 1;
+}
+
+typedef struct {
+  char* name;
+  off_t size;
+  time_t mtime;
+} ImportedFile;
+
+static int by_mtime(const void* a, const void* b) {
+  time_t x = ((const ImportedFile*)a)->mtime, y = ((const ImportedFile*)b)->mtime;
+  return (x > y) - (x < y);
+}
+
+// First run in a directory that already holds files: adopt them, oldest first
+static void import_dir(LruIndex* lru, const char* index_name) {
+  DIR* dir = opendir(lru->dir);
+  if (!dir) return;
+
+  ImportedFile* files = NULL;
+  int count = 0, cap = 0;
+  struct dirent* entry;
+
+  while ((entry = readdir(dir)) != NULL) {
+    const char* name = entry->d_name;
+    size_t len = strlen(name);
+    if (name[0] == '.' || len > LRU_KEY_MAX || strncmp(name, index_name, strlen(index_name)) == 0) continue;
+    if (strstr(name, ".tmp")) continue;  // Half-written leftovers
+
+    char path[PATH_MAX + LRU_KEY_MAX + 2];
+    struct stat st;
+    snprintf(path, sizeof(path), "%s/%s", lru->dir, name);
+    if (stat(path, &st) != 0 || !S_ISREG(st.st_mode)) continue;
+
+    if (count == cap) {
+      cap = cap ? cap * 2 : 64;
+      ImportedFile* ptr = realloc(files, cap * sizeof(ImportedFile));
+      if (!ptr) break;
+      files = ptr;
+    }
+    files[count].name = strdup(name);
+    files[count].size = st.st_size;
+    files[count].mtime = st.st_mtime;
+    if (files[count].name) count++;
+  }
+  closedir(dir);
+
+  if (count) qsort(files, count, sizeof(ImportedFile), by_mtime);
+  for (int i = 0; i < count; i++) {
+    apply_add(lru, files[i].name, (uint64_t)files[i].size, files[i].mtime);
+    free(files[i].name);
+  }
+  free(files);
+  compact(lru);
+}
+
+int lru_open(LruIndex* lru, const char* dir, const char* index_name, uint64_t budget) {
+  memset(lru, 0, sizeof(*lru));
+  lru->journal.fd = lru->journal.tmp_fd = -1;
+  lru->budget = budget;
+  snprintf(lru->dir, sizeof(lru->dir), "%s", dir);
+  if (snprintf(lru->path, sizeof(lru->path), "%s/%s", dir, index_name) >= (int)sizeof(lru->path)) return 0;
+
+  lru->bucket_count = 64;
+  lru->buckets = calloc(lru->bucket_count, sizeof(LruEntry*));
+  if (!lru->buckets) return 0;
+
+  if (!journal_init(&lru->journal, lru->path, INDEX_MAGIC, RECORD_MAX)) return 0;
+
+  // Missing, or not an index we can read (set aside as .bad): adopt the files
+  JournalLoad state = journal_load(&lru->journal, replay, lru);
+  if (state == JOURNAL_MISSING || state == JOURNAL_RESET) import_dir(lru, index_name);
+  else if (lru->journal.torn) compact(lru);
+  return 1;
+}
+
+int lru_touch(LruIndex* lru, const char* key) {
+  time_t now = time(NULL);
+  if (!lru->buckets || !apply_touch(lru, key, now)) return 0;
+  append(lru, OP_TOUCH, key, 0, now);
+  return 1;
+}
+
+int lru_contains(const LruIndex* lru, const char* key) {
+  return lru_find(lru, key) != NULL;
+}
+
+const LruEntry* lru_find(const LruIndex* lru, const char* key) {
+  return lru->buckets ? *find_link(lru, key) : NULL;
+}
+
+void lru_file_key(char key[LRU_KEY_MAX + 1], const char* name, const char* ext) {
+  size_t ext_len = strlen(ext);
+  size_t limit = LRU_KEY_MAX - ext_len - 9; // Room for "-" and the hash
+  size_t n = 0;
+  int changed = 0;
+  for (; name[n] && n < limit; n++) {
+    char c = name[n];
+    int safe = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') ||
+               c == '-' || c == '_' || (c == '.' && n > 0);
+    key[n] = safe ? c : '_';
+    changed |= !safe;
+  }
+
+  // Names that lost bytes carry a hash of the whole, so two never share a file
+  if (changed || name[n]) n += snprintf(key + n, 10, "-%08x", (unsigned)crc32(name, strlen(name)));
+  memcpy(key + n, ext, ext_len + 1);
+}
+
+// Deletes the file; memory is updated before the record is appended so a
+// compaction triggered by the append already leaves the entry out
+static void drop(LruIndex* lru, LruEntry* e) {
+  char key[LRU_KEY_MAX + 1];
+  char path[PATH_MAX + LRU_KEY_MAX + 2];
+  snprintf(key, sizeof(key), "%s", e->key);
+  snprintf(path, sizeof(path), "%s/%s", lru->dir, key);
+  unlink(path);
+
+  apply_del(lru, key);
+  append(lru, OP_DEL, key, 0, 0);
+}
+
+void lru_insert(LruIndex* lru, const char* key, uint64_t size) {
+  if (!lru->buckets || strlen(key) > LRU_KEY_MAX) return;
+
+  time_t now = time(NULL);
+  apply_add(lru, key, size, now);
+  append(lru, OP_ADD, key, size, now);
+
+  while (lru->bytes > lru->budget && lru->oldest) {
+    drop(lru, lru->oldest);
+    lru->evictions++;
+  }
+}
+
+void lru_remove(LruIndex* lru, const char* key) {
+  if (!lru->buckets) return;
+  LruEntry* e = *find_link(lru, key);
+  if (e) drop(lru, e);
+}
+
+void lru_close(LruIndex* lru) {
+  journal_close(&lru->journal);
+
+  LruEntry* e = lru->oldest;
+  while (e) {
+    LruEntry* next = e->newer;
+    free(e->key);
+    free(e);
+    e = next;
+  }
+  free(lru->buckets);
+  memset(lru, 0, sizeof(*lru));
+  lru->journal.fd = lru->journal.tmp_fd = -1;
+}
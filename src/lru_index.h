@@ -0,0 +1,74 @@
+#ifndef LRU_INDEX_H
+#define LRU_INDEX_H
+
+#include <stdint.h>
+#include <limits.h>
+#include <time.h>
+
+#include "journal.h"
+
+#define LRU_KEY_MAX 255
+
+typedef struct LruEntry {
+  char* key;
+  uint64_t size;
+  time_t stored;            // When the file was last written
+  time_t used;              // When it was last inserted or touched
+  struct LruEntry* newer;
+  struct LruEntry* older;
+  struct LruEntry* chain;   // Next entry in the same hash bucket
+} LruEntry;
+
+/**
+ * Recency and size of the files in one cache directory. Keys are file
+ * names inside that directory. Every insert, touch and removal is a small
+ * CRC-checked record appended to an index file, so none of them depends on
+ * how many files are cached; the file is rewritten from memory when it
+ * grows well past the live entry count. Inserting past the byte budget
+ * deletes least recently used files until the cache fits again.
+ */
+typedef struct {
+  char dir[PATH_MAX];
+  char path[PATH_MAX];
+  uint64_t budget;
+
+  LruEntry* newest;
+  LruEntry* oldest;
+  LruEntry** buckets;
+  int bucket_count;
+  int count;
+  uint64_t bytes;
+
+  Journal journal;
+  long evictions;
+} LruIndex;
+
+// Loads (or creates) dir/index_name; returns 0 if the directory is unusable
+int lru_open(LruIndex* lru, const char* dir, const char* index_name, uint64_t budget);
+
+// Marks key as just used; returns 0 if it isn't cached
+int lru_touch(LruIndex* lru, const char* key);
+
+// Whether key is cached, without changing its recency
+int lru_contains(const LruIndex* lru, const char* key);
+
+// The entry for key, or NULL; valid until the next call that modifies lru
+const LruEntry* lru_find(const LruIndex* lru, const char* key);
+
+/**
+ * Builds a file name from arbitrary text: bytes outside [A-Za-z0-9._-]
+ * become '_'. A name that had to be changed or cut also gets "-" and a
+ * hash of the original, so distinct names never map to the same file
+ * while plain slugs keep their own name.
+ */
+void lru_file_key(char key[LRU_KEY_MAX + 1], const char* name, const char* ext);
+
+// Records a file just written to the cache, evicting others to fit the budget
+void lru_insert(LruIndex* lru, const char* key, uint64_t size);
+
+// Forgets key and deletes its file
+void lru_remove(LruIndex* lru, const char* key);
+
+void lru_close(LruIndex* lru);
+
+#endif
@@ -6,6 +6,8 @@
 #include "controller.h"
 #include "network.h"
 #include "library.h"
+#include "http.h"
+#include "fetcher.h"
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -20,6 +22,9 @@
 int main() {
   setlocale(LC_ALL, "");
   curl_global_init(CURL_GLOBAL_ALL);
+  http_init();
+  atexit(http_cleanup);
+  atexit(fetcher_shutdown);
 
   initscr();
   cbreak();
@@ -38,7 +43,7 @@ int main() {
     bkgd(COLOR_PAIR(1)); 
   }
 
-  char *main_options[] = {"Search Book (Gutenberg)", "Open Library", "Search WebNovel", "History", "Exit"};
+  char *main_options[] = {"Search Book (Gutenberg)", "Open Library", "Search Library", "Search WebNovel", "History", "Statistics", "Exit"};
   int size_main_options = sizeof(main_options) / sizeof(char*);
 
   while (1) {
@@ -1,127 +1,292 @@
 #include "network.h"
 #include "controller.h"
 #include "webnovel.h"
+#include "http.h"
+#include "extract.h"
+#include "jsonscan.h"
+#include "chapter_cache.h"
+#include "chapter_index.h"
+#include "fulltext.h"
+#include "fetcher.h"
+#include "event_loop.h"
+#include "revalidate.h"
 
 #include <curl/curl.h>
-#include <cjson/cJSON.h>
+#include <pthread.h>
 #include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
+#include <time.h>
 
-size_t write_callback(void *contents, size_t size, size_t nmemb, void *userp) {
-  size_t realsize = size * nmemb;
-  struct Memory *mem = (struct Memory *)userp;
-
-  char *ptr = realloc(mem->data, mem->size + realsize + 1);
-  if(ptr == NULL)
-    return 0;
-
-  mem->data = ptr;
-  memcpy(&(mem->data[mem->size]), contents, realsize);
-  mem->size += realsize;
-  mem->data[mem->size] = 0;
-
-  return realsize;
+// Runs on the fetch worker: the book goes to disk as it is inflated
+static size_t book_write(const char* data, size_t len, void* userdata) {
+  return fwrite(data, 1, len, userdata);
 }
 
-FILE* download_book(cJSON* results, int choice, char *options[])
+FILE* download_book(const char* download_url, const char* title)
 {
-  CURL* handle = curl_easy_init();
-  cJSON* formats = cJSON_GetObjectItemCaseSensitive(cJSON_GetArrayItem(results, choice), "formats");
-  cJSON* plain = cJSON_GetObjectItemCaseSensitive(formats, "text/plain; charset=utf-8");
-
-  if (!plain) {
+  if (!download_url) {
     // Note: Since we are in ncurses mode, printf might mess up the UI. 
     // Consider a mvprintw here instead.
-    curl_easy_cleanup(handle);
     return NULL;
   }
 
-  char* download_url = plain->valuestring;
-  
   // FIX STARTS HERE
   char lib_path[512];
   get_user_path(lib_path, "library", sizeof(lib_path)); // This creates the dir if missing
 
   char filedir[1024];
-  snprintf(filedir, sizeof(filedir), "%s/%s.txt", lib_path, options[choice]);
+  snprintf(filedir, sizeof(filedir), "%s/%s.txt", lib_path, title);
   // FIX ENDS HERE
 
   FILE* download = fopen(filedir, "wb");
   if (!download) {
-    curl_easy_cleanup(handle);
     return NULL;
   }
 
-  curl_easy_setopt(handle, CURLOPT_URL, download_url);
-  curl_easy_setopt(handle, CURLOPT_WRITEDATA, download);
-  curl_easy_setopt(handle, CURLOPT_FOLLOWLOCATION, 1L);
-
-  CURLcode result = curl_easy_perform(handle);
+  // Written to disk as it is inflated, never buffered whole
+  FetchSink sink = { .write = book_write, .userdata = download };
+  FetchJob* job = fetcher_submit(download_url, FETCH_PRIORITY_FOREGROUND, &sink);
+  char label[128];
+  snprintf(label, sizeof(label), "Downloading %.80s...", title);
+  FetchState state = event_await(job, label);
+  fetcher_release(job);
 
-  if (result != CURLE_OK) {
-    fclose(download);
-    curl_easy_cleanup(handle);
+  int ok = fclose(download) == 0 && state == FETCH_DONE;
+  if (!ok) {
+    // Half a book would pass for a whole one in the library
+    remove(filedir);
     return NULL;
   }
-
-  fclose(download);
-  curl_easy_cleanup(handle);
+  fulltext_add_book(filedir);
 
   return fopen(filedir, "r");
 }
 
-char* fetch_chapter_content(const char* chapter_slug)
+struct ChapterFetch {
+  char slug[CHAPTER_TEXT_MAX];
+  FetchJob* job;
+
+  // Owned by the fetch worker until finished is set
+  ChapterExtractor extractor;
+  char* text;
+  int finished;
+  int dropped; // Given up by the UI; the done callback frees it
+
+  // Paragraphs extracted so far, for showing before the rest arrives
+  char* partial;
+  size_t partial_len;
+  size_t partial_cap;
+};
+
+static pthread_mutex_t chapter_lock = PTHREAD_MUTEX_INITIALIZER;
+
+// Runs on the fetch worker: the chapter is extracted as it streams in
+static size_t chapter_write(const char* data, size_t len, void* userdata) {
+  ChapterFetch* f = userdata;
+  return extractor_feed(&f->extractor, data, len) ? len : 0;
+}
+
+// Runs on the fetch worker for each paragraph as it is finished
+static void chapter_paragraph(const char* text, size_t len, void* userdata) {
+  ChapterFetch* f = userdata;
+
+  pthread_mutex_lock(&chapter_lock);
+  size_t need = f->partial_len + len + 3;
+  if (need > f->partial_cap) {
+    size_t cap = f->partial_cap ? f->partial_cap * 2 : 4096;
+    while (cap < need) cap *= 2;
+    char* grown = realloc(f->partial, cap);
+    if (!grown) {
+      pthread_mutex_unlock(&chapter_lock);
+      return; // The preview just stops growing; the chapter still arrives
+    }
+    f->partial = grown;
+    f->partial_cap = cap;
+  }
+  memcpy(f->partial + f->partial_len, text, len);
+  memcpy(f->partial + f->partial_len + len, "\n\n", 3);
+  f->partial_len += len + 2;
+  pthread_mutex_unlock(&chapter_lock);
+}
+
+static void chapter_free(ChapterFetch* f) {
+  extractor_free(&f->extractor);
+  free(f->text);
+  free(f->partial);
+  free(f);
+}
+
+static void chapter_done(int ok, void* userdata) {
+  ChapterFetch* f = userdata;
+
+  size_t len = 0;
+  if (ok) f->text = extractor_finish(&f->extractor, &len);
+  else extractor_free(&f->extractor);
+
+  // Kept even if the reader has moved on; it may come back
+  if (f->text && len) chapter_cache_put(f->slug, f->text, len);
+
+  pthread_mutex_lock(&chapter_lock);
+  f->finished = 1;
+  int dropped = f->dropped;
+  pthread_mutex_unlock(&chapter_lock);
+
+  if (dropped) chapter_free(f);
+}
+
+ChapterFetch* chapter_fetch_start(const char* chapter_slug, FetchPriority priority)
 {
+  ChapterFetch* f = calloc(1, sizeof(ChapterFetch));
+  if (!f) return NULL;
+  snprintf(f->slug, sizeof(f->slug), "%s", chapter_slug);
+  extractor_init(&f->extractor, chapter_paragraph, f);
+
   char url[512];
   snprintf(url, sizeof(url), "https://wuxia.click/chapter/%s", chapter_slug);
-  return fetch_url(url);
+
+  // Extract while downloading so the page HTML is never buffered
+  FetchSink sink = { .write = chapter_write, .done = chapter_done, .userdata = f };
+  f->job = fetcher_submit(url, priority, &sink);
+  if (!f->job) {
+    chapter_free(f);
+    return NULL;
+  }
+  return f;
 }
 
-int fetch_novel_chapters(const char* slug, char chapters[3500][128],char chapter_titles[3500][128])
+const char* chapter_fetch_slug(const ChapterFetch* f)
 {
-  char url[512];
-  snprintf(url, sizeof(url), "https://wuxiaworld.eu/api/chapters/%s/", slug);
+  return f->slug;
+}
 
-  char* json_data = fetch_url(url);
-  if (!json_data) return 0;
+FetchJob* chapter_fetch_job(ChapterFetch* f)
+{
+  return f->job;
+}
 
-  cJSON* root = cJSON_Parse(json_data);
-  if (!root) {
-    free(json_data);
-    return 0;
+int chapter_fetch_finished(ChapterFetch* f)
+{
+  pthread_mutex_lock(&chapter_lock);
+  int finished = f->finished;
+  pthread_mutex_unlock(&chapter_lock);
+  return finished;
+}
+
+char* chapter_fetch_partial(ChapterFetch* f, size_t* seen)
+{
+  char* copy = NULL;
+  pthread_mutex_lock(&chapter_lock);
+  if (f->partial_len > *seen && (copy = malloc(f->partial_len + 1))) {
+    memcpy(copy, f->partial, f->partial_len + 1);
+    *seen = f->partial_len;
   }
+  pthread_mutex_unlock(&chapter_lock);
+  return copy;
+}
+
+char* chapter_fetch_take(ChapterFetch* f)
+{
+  fetcher_wait(f->job);
+  fetcher_release(f->job);
+  char* text = f->text;
+  f->text = NULL;
+  chapter_free(f);
+  return text;
+}
+
+void chapter_fetch_drop(ChapterFetch* f)
+{
+  if (!f) return;
+  if (fetcher_abandon(f->job, &chapter_lock, &f->finished, &f->dropped)) chapter_free(f);
+}
+
+static void gutendex_url(char* url, size_t size, const char* query)
+{
+  char* encoded = curl_easy_escape(NULL, query, 0);
+  snprintf(url, size, "https://gutendex.com/books/?search=%s", encoded ? encoded : "");
+  curl_free(encoded);
+}
+
+// Fed on the fetch worker while the UI waits for the job
+typedef struct {
+  JsonScan js;
+  HttpValidators* validators;
+} GutendexSearch;
+
+static size_t gutendex_write(const char* data, size_t len, void* userdata)
+{
+  GutendexSearch* search = userdata;
+  return jsonscan_feed(&search->js, data, len) ? len : 0;
+}
+
+static void gutendex_header(const char* line, size_t len, void* userdata)
+{
+  GutendexSearch* search = userdata;
+  http_validators_header(search->validators, line, len);
+}
+
+int search_gutendex(const char* query, BookResults* results)
+{
+  // Only count, titles and plain-text links are kept from the response
+  GutendexSearch search = { .validators = &results->validators };
+  book_results_reader(&search.js, results);
+
+  char url[512];
+  gutendex_url(url, sizeof(url), query);
+
+  FetchSink sink = { .header = gutendex_header, .write = gutendex_write, .userdata = &search };
+  FetchJob* job = fetcher_submit(url, FETCH_PRIORITY_FOREGROUND, &sink);
+  FetchState state = event_await(job, "Searching Gutendex...");
+  fetcher_release(job);
 
-  int count = 0;
+  int ok = state == FETCH_DONE && jsonscan_finish(&search.js);
+  jsonscan_free(&search.js);
+  if (!ok) book_results_free(results);
+  else results->fetched_at = time(NULL);
+  return state == FETCH_CANCELLED ? -1 : ok;
+}
 
-  if (cJSON_IsArray(root)) {
-    int size = cJSON_GetArraySize(root);
+Revalidation* revalidate_gutendex(const char* query, const BookResults* cached)
+{
+  char url[512];
+  gutendex_url(url, sizeof(url), query);
+  return revalidate_start(url, &cached->validators);
+}
 
-    for (int i = 0; i < size && count < 3500; i++) {
-      cJSON* item = cJSON_GetArrayItem(root, i);
-      cJSON* title_field = cJSON_GetObjectItem(item, "title");
+int gutendex_revalidated(Revalidation** rv, BookResults* results)
+{
+  RevalidateState state = revalidate_state(*rv);
+  if (state == REVALIDATE_PENDING) return 0;
 
-      if (cJSON_IsString(title_field) && title_field->valuestring) {
-        strncpy(chapter_titles[count],
-                title_field->valuestring,
-                255);
-        chapter_titles[count][255] = '\0';
-      }
-      cJSON* slug_field = cJSON_GetObjectItem(item, "novSlugChapSlug");
+  int updated = 0;
+  if (state == REVALIDATE_UNCHANGED) {
+    results->fetched_at = time(NULL);
+    updated = 1;
+  } else if (state == REVALIDATE_CHANGED) {
+    HttpValidators fresh;
+    size_t size = 0;
+    char* body = revalidate_take_body(*rv, &size, &fresh);
 
-      if (cJSON_IsString(slug_field) && slug_field->valuestring) {
-        strncpy(chapters[count],
-                slug_field->valuestring,
-                127);
+    BookResults parsed;
+    JsonScan js;
+    book_results_reader(&js, &parsed);
+    int ok = body && jsonscan_feed(&js, body, size) && jsonscan_finish(&js);
+    jsonscan_free(&js);
+    free(body);
 
-        chapters[count][127] = '\0';
-        count++;
-      }
+    if (ok) {
+      book_results_free(results);
+      *results = parsed;
+      results->validators = fresh;
+      results->fetched_at = time(NULL);
+      updated = 1;
+    } else {
+      book_results_free(&parsed);
     }
   }
 
-  cJSON_Delete(root);
-  free(json_data);
-
-  return count;
+  revalidate_release(*rv);
+  *rv = NULL;
+  return updated;
 }
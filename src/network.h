@@ -2,14 +2,51 @@
 #define NETWORK_H
 
 #include <stdio.h>
-#include <cjson/cJSON.h>
 
-size_t write_callback(void *ptr, size_t size, size_t nmemb, void *stream);
+#include "cache.h"
+#include "fetcher.h"
 
-FILE* download_book(cJSON *results, int choice, char *options[]);
+// Downloads into the library with progress shown; NULL if it failed or was cancelled
+FILE* download_book(const char* download_url, const char* title);
 
-int fetch_novel_chapters(const char* novel_slug, char chapters[3500][128], char chapter_titles[3500][128]);
+// Fills results from a Gutendex search; returns 0 on network or parse
+// failure and -1 if the user cancelled it
+int search_gutendex(const char* query, BookResults* results);
 
-char* fetch_chapter_content(const char* chapter_slug);
+// Starts checking a cached search against Gutendex in the background
+Revalidation* revalidate_gutendex(const char* query, const BookResults* cached);
+
+// Once the check finishes, refreshes results and releases *rv; returns 1
+// if results were confirmed or replaced and should be saved again
+int gutendex_revalidated(Revalidation** rv, BookResults* results);
+
+/**
+ * A chapter fetched on the fetch worker, its text extracted as the page
+ * streams in and cached once complete, so the reader never waits on the
+ * network with the keyboard dead.
+ */
+typedef struct ChapterFetch ChapterFetch;
+
+ChapterFetch* chapter_fetch_start(const char* chapter_slug, FetchPriority priority);
+
+const char* chapter_fetch_slug(const ChapterFetch* f);
+
+// For progress and state; owned by f
+FetchJob* chapter_fetch_job(ChapterFetch* f);
+
+// Whether the text is ready (or the fetch failed); never blocks
+int chapter_fetch_finished(ChapterFetch* f);
+
+/**
+ * The paragraphs that have arrived so far, if there are more than the
+ * *seen bytes already handed out; *seen is moved on. Caller frees.
+ */
+char* chapter_fetch_partial(ChapterFetch* f, size_t* seen);
+
+// Waits for the fetch if needed and frees f; returns the text or NULL, caller frees
+char* chapter_fetch_take(ChapterFetch* f);
+
+// Gives up on f, cancelling the transfer if it is still running
+void chapter_fetch_drop(ChapterFetch* f);
 
 #endif
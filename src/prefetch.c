@@ -0,0 +1,101 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "prefetch.h"
+#include "config.h"
+#include "chapter_cache.h"
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+static ChapterFetch* window[PREFETCH_MAX_DEPTH];
+static int window_count = 0;
+
+static PrefetchStats stats;
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+
+static int find_item(const char* slug) {
+  for (int i = 0; i < window_count; i++)
+    if (strcmp(chapter_fetch_slug(window[i]), slug) == 0) return i;
+  return -1;
+}
+
+static void remove_item(int idx) {
+  for (int i = idx; i < window_count - 1; i++) window[i] = window[i + 1];
+  window_count--;
+}
+
+void prefetch_chapters(const ChapterIndex* chapters, int current) {
+  int total = chapter_index_count(chapters);
+  int depth = config_get_int("prefetch_depth", PREFETCH_DEFAULT_DEPTH);
+  if (depth < 0) depth = 0;
+  if (depth > PREFETCH_MAX_DEPTH) depth = PREFETCH_MAX_DEPTH;
+
+  int first = current + 1;
+  int last = current + depth;
+  if (last > total - 1) last = total - 1;
+
+  char wanted[PREFETCH_MAX_DEPTH][CHAPTER_TEXT_MAX];
+  for (int c = first; c <= last; c++) chapter_index_slug(chapters, c, wanted[c - first], CHAPTER_TEXT_MAX);
+
+  // Cancel everything that fell out of the new window
+  for (int i = window_count - 1; i >= 0; i--) {
+    int keep = 0;
+    for (int c = first; c <= last; c++) {
+      if (strcmp(chapter_fetch_slug(window[i]), wanted[c - first]) == 0) { keep = 1; break; }
+    }
+    if (!keep) {
+      if (!chapter_fetch_finished(window[i])) {
+        pthread_mutex_lock(&lock);
+        stats.cancelled++;
+        pthread_mutex_unlock(&lock);
+      }
+      chapter_fetch_drop(window[i]);
+      remove_item(i);
+    }
+  }
+
+  // Queue the missing ones nearest first so they finish in reading order
+  for (int c = first; c <= last && window_count < PREFETCH_MAX_DEPTH; c++) {
+    if (find_item(wanted[c - first]) >= 0 || chapter_cache_has(wanted[c - first])) continue;
+
+    ChapterFetch* fetch = chapter_fetch_start(wanted[c - first], FETCH_PRIORITY_PREFETCH);
+    if (!fetch) break;
+
+    window[window_count++] = fetch;
+    pthread_mutex_lock(&lock);
+    stats.issued++;
+    pthread_mutex_unlock(&lock);
+  }
+}
+
+ChapterFetch* prefetch_claim(const char* chapter_slug) {
+  int idx = find_item(chapter_slug);
+  ChapterFetch* fetch = idx >= 0 ? window[idx] : NULL;
+  if (fetch) remove_item(idx);
+
+  // Still on the wire: joining it beats starting over, and it is no
+  // longer speculative, so it goes ahead of the rest of the window
+  int late = fetch && !chapter_fetch_finished(fetch);
+  if (late) fetcher_promote(chapter_fetch_job(fetch));
+
+  pthread_mutex_lock(&lock);
+  if (!fetch) stats.misses++;
+  else if (late) stats.late_hits++;
+  else stats.hits++;
+  pthread_mutex_unlock(&lock);
+  return fetch;
+}
+
+void prefetch_reset(void) {
+  while (window_count > 0) {
+    chapter_fetch_drop(window[window_count - 1]);
+    window_count--;
+  }
+}
+
+void prefetch_get_stats(PrefetchStats* out) {
+  pthread_mutex_lock(&lock);
+  *out = stats;
+  pthread_mutex_unlock(&lock);
+}
@@ -0,0 +1,38 @@
+#ifndef PREFETCH_H
+#define PREFETCH_H
+
+#include "chapter_index.h"
+#include "network.h"
+
+#define PREFETCH_DEFAULT_DEPTH 3
+#define PREFETCH_MAX_DEPTH 16
+
+typedef struct {
+  long issued;    // Chapters queued for background fetch
+  long hits;      // Opens served from a finished prefetch
+  long late_hits; // Opens that joined a prefetch still in flight
+  long misses;    // Opens that had to fetch in the foreground
+  long cancelled; // Prefetches dropped because the reader moved away
+} PrefetchStats;
+
+/**
+ * Keeps the chapters following `current` fetched and extracted in the
+ * background. Anything outside the new window is cancelled, so jumping to
+ * a distant chapter re-prioritises the queue around the new position.
+ * The depth comes from "prefetch_depth" in the config file.
+ */
+void prefetch_chapters(const ChapterIndex* chapters, int current);
+
+/**
+ * Hands over the prefetch of chapter_slug, finished or still in flight,
+ * without waiting for it; NULL if it was never queued. The caller takes it
+ * with chapter_fetch_take once chapter_fetch_finished says so.
+ */
+ChapterFetch* prefetch_claim(const char* chapter_slug);
+
+// Cancels everything, e.g. when leaving a novel
+void prefetch_reset(void);
+
+void prefetch_get_stats(PrefetchStats* out);
+
+#endif
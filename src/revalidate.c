@@ -0,0 +1,133 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "revalidate.h"
+#include "fetcher.h"
+#include "config.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+struct Revalidation {
+  FetchJob* job;
+  HttpValidators validators; // Written by the worker until finished is set
+  int ok;
+  int finished;
+  int orphaned; // Dropped by the UI; the done callback frees it
+};
+
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+
+// Copies the value of a "Name: value\r\n" line
+static void header_value(char* out, size_t size, const char* line, size_t len) {
+  const char* p = memchr(line, ':', len);
+  const char* end = line + len;
+  if (!p) return;
+  for (p++; p < end && (*p == ' ' || *p == '\t'); p++);
+  while (end > p && (end[-1] == '\r' || end[-1] == '\n' || end[-1] == ' ')) end--;
+  size_t n = end - p;
+  if (n >= size) n = 0; // Too long to send back; better none than a cut one
+  memcpy(out, p, n);
+  out[n] = '\0';
+}
+
+void http_validators_header(HttpValidators* v, const char* line, size_t len) {
+  if (len > 5 && memcmp(line, "HTTP/", 5) == 0) {
+    // A new response, e.g. after a redirect
+    const char* space = memchr(line, ' ', len);
+    v->status = space ? atol(space + 1) : 0;
+    v->etag[0] = v->last_modified[0] = '\0';
+  } else if (len > 5 && strncasecmp(line, "ETag:", 5) == 0) {
+    header_value(v->etag, sizeof(v->etag), line, len);
+  } else if (len > 14 && strncasecmp(line, "Last-Modified:", 14) == 0) {
+    header_value(v->last_modified, sizeof(v->last_modified), line, len);
+  }
+}
+
+size_t http_validators_curl(char* data, size_t size, size_t nmemb, void* userdata) {
+  http_validators_header(userdata, data, size * nmemb);
+  return size * nmemb;
+}
+
+void http_validators_request(const HttpValidators* v, char lines[2][HTTP_VALIDATOR_MAX + 32], const char* headers[3]) {
+  int n = 0;
+  if (v && v->etag[0]) {
+    snprintf(lines[n], sizeof(lines[n]), "If-None-Match: %s", v->etag);
+    headers[n] = lines[n];
+    n++;
+  }
+  if (v && v->last_modified[0]) {
+    snprintf(lines[n], sizeof(lines[n]), "If-Modified-Since: %s", v->last_modified);
+    headers[n] = lines[n];
+    n++;
+  }
+  headers[n] = NULL;
+}
+
+int revalidate_due(time_t fetched_at, const char* ttl_key, int fallback) {
+  int ttl = config_get_int(ttl_key, fallback);
+  return ttl <= 0 || time(NULL) - fetched_at >= ttl;
+}
+
+static void revalidation_header(const char* line, size_t len, void* userdata) {
+  Revalidation* rv = userdata;
+  http_validators_header(&rv->validators, line, len);
+}
+
+static void revalidation_done(int ok, void* userdata) {
+  Revalidation* rv = userdata;
+
+  pthread_mutex_lock(&lock);
+  rv->ok = ok;
+  rv->finished = 1;
+  int orphaned = rv->orphaned;
+  pthread_mutex_unlock(&lock);
+
+  if (orphaned) free(rv);
+}
+
+Revalidation* revalidate_start(const char* url, const HttpValidators* cached) {
+  Revalidation* rv = calloc(1, sizeof(Revalidation));
+  if (!rv) return NULL;
+
+  char lines[2][HTTP_VALIDATOR_MAX + 32];
+  const char* headers[3];
+  http_validators_request(cached, lines, headers);
+
+  // The body is collected in memory; only changed responses have one
+  FetchSink sink = {
+    .header = revalidation_header, .done = revalidation_done,
+    .userdata = rv, .request_headers = headers,
+  };
+  rv->job = fetcher_submit(url, FETCH_PRIORITY_PREFETCH, &sink);
+  if (!rv->job) {
+    free(rv);
+    return NULL;
+  }
+  return rv;
+}
+
+RevalidateState revalidate_state(Revalidation* rv) {
+  pthread_mutex_lock(&lock);
+  int finished = rv->finished;
+  pthread_mutex_unlock(&lock);
+
+  if (!finished) return REVALIDATE_PENDING;
+  if (!rv->ok) return REVALIDATE_FAILED;
+  if (rv->validators.status == 304) return REVALIDATE_UNCHANGED;
+  if (rv->validators.status == 200) return REVALIDATE_CHANGED;
+  return REVALIDATE_FAILED;
+}
+
+char* revalidate_take_body(Revalidation* rv, size_t* size, HttpValidators* fresh) {
+  if (revalidate_state(rv) != REVALIDATE_CHANGED) return NULL;
+  if (fresh) *fresh = rv->validators;
+  return fetcher_take_body(rv->job, size);
+}
+
+void revalidate_release(Revalidation* rv) {
+  if (!rv) return;
+  if (fetcher_abandon(rv->job, &lock, &rv->finished, &rv->orphaned)) free(rv);
+}
@@ -0,0 +1,53 @@
+#ifndef REVALIDATE_H
+#define REVALIDATE_H
+
+#include <stddef.h>
+#include <time.h>
+
+#define HTTP_VALIDATOR_MAX 256
+
+// What a response said about itself, so a later request can ask if it changed
+typedef struct {
+  long status;
+  char etag[HTTP_VALIDATOR_MAX];
+  char last_modified[HTTP_VALIDATOR_MAX];
+} HttpValidators;
+
+// Feeds one response header line; a status line starts a new response
+void http_validators_header(HttpValidators* v, const char* line, size_t len);
+
+// CURLOPT_HEADERFUNCTION adapter; userdata is an HttpValidators
+size_t http_validators_curl(char* data, size_t size, size_t nmemb, void* userdata);
+
+// Points headers (NULL-terminated) at If-None-Match / If-Modified-Since lines built in lines
+void http_validators_request(const HttpValidators* v, char lines[2][HTTP_VALIDATOR_MAX + 32], const char* headers[3]);
+
+// Whether a copy fetched at fetched_at is older than the "ttl_key" setting (seconds)
+int revalidate_due(time_t fetched_at, const char* ttl_key, int fallback);
+
+typedef enum {
+  REVALIDATE_PENDING,
+  REVALIDATE_UNCHANGED, // 304: the cached copy is still current
+  REVALIDATE_CHANGED,   // A new body is ready to take
+  REVALIDATE_FAILED
+} RevalidateState;
+
+typedef struct Revalidation Revalidation;
+
+/**
+ * Stale-while-revalidate: a screen shows its cached copy at once and, when
+ * that is past its TTL, asks the server in the background whether it
+ * changed, sending the validators stored with the copy. Screens poll the
+ * state between key presses and swap fresh data in when it arrives.
+ */
+Revalidation* revalidate_start(const char* url, const HttpValidators* cached);
+
+RevalidateState revalidate_state(Revalidation* rv);
+
+// After REVALIDATE_CHANGED: hands over the body (caller frees) and its validators
+char* revalidate_take_body(Revalidation* rv, size_t* size, HttpValidators* fresh);
+
+// Drops the revalidation, cancelling it if it is still running
+void revalidate_release(Revalidation* rv);
+
+#endif
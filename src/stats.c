@@ -0,0 +1,155 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "stats.h"
+#include "http.h"
+#include "prefetch.h"
+#include "textscan.h"
+#include "webnovel.h"
+#include "chapter_cache.h"
+#include "cache.h"
+#include "chapter_list.h"
+#include "fulltext.h"
+#include "catalog.h"
+#include "chapter_controller.h"
+
+#include <ncurses.h>
+#include <stdio.h>
+
+static double kb(curl_off_t bytes) {
+  return bytes / 1024.0;
+}
+
+static void section(int* row, int col, const char* title) {
+  if (*row > 3) (*row)++;
+  attron(COLOR_PAIR(2));
+  mvprintw((*row)++, col, "%s", title);
+  attroff(COLOR_PAIR(2));
+}
+
+/**
+ * ncurses writes straight to the terminal's file descriptor, so its output
+ * is measured from the kernel's count of bytes this thread passed to
+ * write(). Only the UI thread draws, and nothing else it does between two
+ * readings writes, so the difference is what one screen update cost.
+ */
+long long thread_bytes_written(void) {
+  FILE* f = fopen("/proc/thread-self/io", "r");
+  if (!f) return -1;
+
+  char line[64];
+  long long wchar = -1;
+  while (fgets(line, sizeof(line), f)) {
+    if (sscanf(line, "wchar: %lld", &wchar) == 1) break;
+  }
+  fclose(f);
+  return wchar;
+}
+
+static double percent(long part, long whole) {
+  return whole ? 100.0 * part / whole : 0.0;
+}
+
+void show_stats_screen(void) {
+  HttpStats http;
+  http_get_stats(&http);
+  PrefetchStats prefetch;
+  prefetch_get_stats(&prefetch);
+  PageCacheStats pages;
+  page_cache_get_stats(&pages);
+  ChapterCacheStats chapters;
+  chapter_cache_get_stats(&chapters);
+  SearchCacheStats searches;
+  search_cache_get_stats(&searches);
+  ChapterListStats lists;
+  chapter_list_get_stats(&lists);
+  ReaderStats reader;
+  reader_get_stats(&reader);
+  FulltextStats index;
+  fulltext_get_stats(&index);
+  CatalogStats catalog;
+  catalog_get_stats(&catalog);
+
+  int rows, cols;
+  getmaxyx(stdscr, rows, cols);
+  (void) rows;
+
+  clear();
+  attron(COLOR_PAIR(4));
+  mvprintw(0, 0, "📊 Session Statistics");
+  attroff(COLOR_PAIR(4));
+  attron(COLOR_PAIR(5) | A_DIM);
+  mvprintw(1, 0, "═══════════════════════════════════════════════════════════════");
+  attroff(COLOR_PAIR(5) | A_DIM);
+
+  int row = 3, col = 0;
+  section(&row, col, "HTTP");
+  mvprintw(row++, col + 2, "Transfers:           %ld (%ld failed)", http.transfers, http.failures);
+  mvprintw(row++, col + 2, "New connections:     %ld", http.new_connections);
+  mvprintw(row++, col + 2, "Handshakes avoided:  %ld", http.handshakes_avoided);
+  mvprintw(row++, col + 2, "On the wire:         %.1f KB (%.1f KB decoded)", kb(http.wire_bytes), kb(http.decoded_bytes));
+  for (int i = 0; i < http.recent_count; i++) {
+    mvprintw(row++, col + 4, "%8.1f KB -> %8.1f KB  %.40s",
+             kb(http.recent[i].wire), kb(http.recent[i].decoded), http.recent[i].url);
+  }
+
+  long opens = prefetch.hits + prefetch.late_hits + prefetch.misses;
+  section(&row, col, "Chapter prefetch");
+  mvprintw(row++, col + 2, "Queued:              %ld (%ld cancelled)", prefetch.issued, prefetch.cancelled);
+  mvprintw(row++, col + 2, "Hits:                %ld (+%ld still in flight)", prefetch.hits, prefetch.late_hits);
+  mvprintw(row++, col + 2, "Misses:              %ld", prefetch.misses);
+  mvprintw(row++, col + 2, "Hit rate:            %.1f%%", percent(prefetch.hits + prefetch.late_hits, opens));
+  mvprintw(row++, col + 2, "Text kernel:         %s", textscan_kernel());
+
+  section(&row, col, "Chapter reader");
+  mvprintw(row++, col + 2, "Screen updates:      %ld (%.0f B on average)", reader.frames,
+           reader.frames ? (double)reader.bytes / reader.frames : 0.0);
+  mvprintw(row++, col + 2, "Last update:         %lld B (last scroll %lld B)", reader.last_frame, reader.last_scroll);
+
+  // Caches go in a second column when the terminal is wide enough
+  int bottom = row;
+  if (cols >= 140) {
+    row = 3;
+    col = 72;
+  }
+
+  long lookups = pages.hits + pages.misses;
+  section(&row, col, "Search pages (this session)");
+  mvprintw(row++, col + 2, "Hits:                %ld of %ld (%.1f%%)", pages.hits, lookups, percent(pages.hits, lookups));
+  mvprintw(row++, col + 2, "Fetched ahead:       %ld (%ld paged to)", pages.speculated, pages.speculative_hits);
+  mvprintw(row++, col + 2, "Evicted:             %ld", pages.evictions);
+
+  long searched = searches.hits + searches.misses;
+  section(&row, col, "Book search cache");
+  mvprintw(row++, col + 2, "Hits:                %ld of %ld (%.1f%%)", searches.hits, searched, percent(searches.hits, searched));
+  mvprintw(row++, col + 2, "On disk:             %d searches, %.1f of %.0f KB (%ld evicted)",
+           searches.entries, searches.bytes / 1024.0, searches.budget / 1024.0, searches.evictions);
+
+  long reads = chapters.hits + chapters.misses;
+  section(&row, col, "Chapter cache");
+  mvprintw(row++, col + 2, "Hits:                %ld of %ld (%.1f%%)", chapters.hits, reads, percent(chapters.hits, reads));
+  mvprintw(row++, col + 2, "Read from disk:      %.1f KB", chapters.bytes_served / 1024.0);
+  mvprintw(row++, col + 2, "On disk:             %d chapters, %.1f of %.0f MB (%ld evicted)",
+           chapters.entries, chapters.bytes / 1048576.0, chapters.budget / 1048576.0, chapters.evictions);
+
+  section(&row, col, "Library catalog");
+  mvprintw(row++, col + 2, "Books:               %d", catalog.books);
+  mvprintw(row++, col + 2, "Kept current by:     %ld listings, %ld single-file changes", catalog.rescans, catalog.changes);
+
+  section(&row, col, "Chapter lists");
+  mvprintw(row++, col + 2, "Opened from disk:    %ld (%ld downloaded in full)", lists.loaded, lists.fetched);
+  mvprintw(row++, col + 2, "Refreshes:           %ld unchanged, %ld new chapters", lists.unchanged, lists.new_chapters);
+  mvprintw(row++, col + 2, "Fetched ahead:       %ld", lists.warmed);
+
+  section(&row, col, "Full-text index");
+  mvprintw(row++, col + 2, "On disk:             %d files in %d segments, %.1f MB",
+           index.documents, index.segments, index.bytes / 1048576.0);
+  mvprintw(row++, col + 2, "Indexed:             %ld files (%ld merges)", index.indexed, index.merges);
+  mvprintw(row++, col + 2, "Queries:             %ld (last %.1f ms)", index.queries, index.last_query_us / 1000.0);
+
+  if (row < bottom) row = bottom;
+  attron(COLOR_PAIR(4));
+  mvprintw(row + 1, 0, "Press any key to return...");
+  attroff(COLOR_PAIR(4));
+  refresh();
+  getch();
+}
@@ -0,0 +1,10 @@
+#ifndef STATS_H
+#define STATS_H
+
+// Shows the runtime counters collected by the network and cache layers
+void show_stats_screen(void);
+
+// Bytes the calling thread has written so far, from /proc; -1 where unavailable
+long long thread_bytes_written(void);
+
+#endif
@@ -0,0 +1,160 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "text_search.h"
+#include "textscan.h"
+
+#include <stdio.h>
+#include <string.h>
+
+void text_search_init(TextSearch* s, LineMap* map) {
+  memset(s, 0, sizeof(*s));
+  s->map = map;
+}
+
+static const char* find(const TextSearch* s, const char* from, const char* to) {
+  if (to <= from) return NULL;
+  return textscan_find(from, to - from, s->query, s->len);
+}
+
+// First match at or after byte `from`, wrapping around to the start
+static const char* find_from(const TextSearch* s, size_t from) {
+  const char* data = s->map->data;
+  size_t size = s->map->size;
+  if (s->len == 0 || !data) return NULL;
+
+  const char* hit = find(s, data + from, data + size);
+  if (!hit) {
+    size_t stop = from + s->len - 1;
+    hit = find(s, data, data + (stop < size ? stop : size));
+  }
+  return hit;
+}
+
+// Last match starting before `hit`, wrapping around to the end
+static const char* find_before(const TextSearch* s, const char* hit) {
+  const char* data = s->map->data;
+  const char* end = data + s->map->size;
+
+  const char* last = NULL;
+  const char* p = data;
+  const char* limit = hit + s->len - 1;
+  const char* q;
+  while ((q = find(s, p, limit)) != NULL) {
+    last = q;
+    p = q + 1;
+  }
+  if (last) return last;
+
+  for (p = hit + 1; (q = find(s, p, end)) != NULL; p = q + 1) last = q;
+  return last ? last : hit;
+}
+
+static void research(TextSearch* s) {
+  s->hit = find_from(s, s->origin);
+}
+
+void text_search_start(TextSearch* s, const char* query, size_t from) {
+  snprintf(s->query, sizeof(s->query), "%s", query);
+  s->len = strlen(s->query);
+  s->origin = from < s->map->size ? from : 0;
+  s->origin_top = (WrapPos){0, 0};
+  s->editing = 0;
+  research(s);
+}
+
+SearchAction text_search_key(TextSearch* s, int ch, WrapPos top) {
+  if (!s->editing) {
+    if (ch == '/') {
+      size_t len;
+      const char* line = line_map_line(s->map, top.line, &len);
+      s->origin = line ? (size_t)(line - s->map->data) + top.pos : 0;
+      s->origin_top = top;
+      s->len = 0;
+      s->query[0] = '\0';
+      s->hit = NULL;
+      s->editing = 1;
+      return SEARCH_UPDATED;
+    }
+    if ((ch == 'n' || ch == 'N') && s->len > 0) {
+      if (!s->hit) research(s);
+      else if (ch == 'n') s->hit = find_from(s, s->hit - s->map->data + 1);
+      else s->hit = find_before(s, s->hit);
+      return SEARCH_UPDATED;
+    }
+    return SEARCH_IGNORED;
+  }
+
+  switch (ch) {
+    case 27: // Esc
+      s->editing = 0;
+      s->len = 0;
+      s->query[0] = '\0';
+      s->hit = NULL;
+      return SEARCH_CANCELLED;
+
+    case '\n': case '\r': case KEY_ENTER:
+      s->editing = 0;
+      return SEARCH_UPDATED;
+
+    case KEY_BACKSPACE: case 127: case '\b':
+      // Drop a whole UTF-8 character, continuation bytes and all
+      while (s->len > 0 && ((unsigned char)s->query[--s->len] & 0xC0) == 0x80) {}
+      s->query[s->len] = '\0';
+      research(s);
+      return SEARCH_UPDATED;
+  }
+
+  if (ch >= ' ' && ch <= 0xFF && ch != 127 && s->len + 1 < TEXT_SEARCH_MAX) {
+    s->query[s->len++] = (char)ch;
+    s->query[s->len] = '\0';
+    research(s);
+    return SEARCH_UPDATED;
+  }
+  return SEARCH_IGNORED;
+}
+
+WrapPos text_search_pos(const TextSearch* s) {
+  WrapPos at = {0, 0};
+  if (s->hit) at.line = line_map_locate(s->map, s->hit - s->map->data, &at.pos);
+  return at;
+}
+
+void text_search_draw(WINDOW* win, int y, int x, const TextSearch* s, const char* text, size_t len) {
+  wmove(win, y, x);
+  if (s->len == 0) {
+    waddnstr(win, text, (int)len);
+    return;
+  }
+
+  // A match may start on the row before or run on to the next one
+  const char* data = s->map->data;
+  size_t row = text - data;
+  size_t from = row >= s->len - 1 ? row - (s->len - 1) : 0;
+  size_t stop = row + len + s->len - 1;
+  if (stop > s->map->size) stop = s->map->size;
+
+  const char* to = text + len;
+  const char* done = text;
+  const char* m;
+  while ((m = find(s, data + from, data + stop)) != NULL && m < to) {
+    const char* end = m + s->len < to ? m + s->len : to;
+    if (end > done) {
+      if (m > done) waddnstr(win, done, (int)(m - done));
+      const char* start = m > done ? m : done;
+      attr_t attr = m == s->hit ? A_REVERSE | A_BOLD : A_REVERSE;
+      wattron(win, attr);
+      waddnstr(win, start, (int)(end - start));
+      wattroff(win, attr);
+      done = end;
+    }
+    from = m - data + 1;
+  }
+  if (done < to) waddnstr(win, done, (int)(to - done));
+}
+
+void text_search_status(const TextSearch* s, char* out, size_t size) {
+  if (s->editing) snprintf(out, size, "/%s", s->query);
+  else if (s->len > 0 && !s->hit) snprintf(out, size, "Not found: %s   / Search again   q Back", s->query);
+  else if (s->len > 0) snprintf(out, size, "/%s   n Next   N Previous   / New search", s->query);
+  else out[0] = '\0';
+}
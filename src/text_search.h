@@ -0,0 +1,50 @@
+#ifndef TEXT_SEARCH_H
+#define TEXT_SEARCH_H
+
+#include <ncurses.h>
+
+#include "line_map.h"
+#include "wrap.h"
+
+#define TEXT_SEARCH_MAX 128
+
+// What a reader does after handing a key to text_search_key()
+typedef enum {
+  SEARCH_IGNORED,  // Not a search key; handle it as usual
+  SEARCH_UPDATED,  // Redraw, bringing the current match into view
+  SEARCH_CANCELLED // Redraw from where the search started
+} SearchAction;
+
+/**
+ * `/` search inside a reader. The whole text is searched again on every
+ * keystroke, ignoring ASCII case, from where the prompt was opened; n and
+ * N then step through the matches, wrapping around at either end.
+ */
+typedef struct {
+  LineMap* map;
+  char query[TEXT_SEARCH_MAX];
+  size_t len;
+  int editing;         // Whether the prompt is open
+  size_t origin;       // Byte the search started from
+  WrapPos origin_top;  // View to go back to on Esc
+  const char* hit;     // Current match, or NULL
+} TextSearch;
+
+void text_search_init(TextSearch* s, LineMap* map);
+
+// Searches for query from byte `from` as if it had been typed, without the prompt
+void text_search_start(TextSearch* s, const char* query, size_t from);
+
+// Feeds a key pressed while the view starts at top
+SearchAction text_search_key(TextSearch* s, int ch, WrapPos top);
+
+// Where the current match is; only meaningful while s->hit is set
+WrapPos text_search_pos(const TextSearch* s);
+
+// Draws len bytes of text at y, x with the matches in them highlighted
+void text_search_draw(WINDOW* win, int y, int x, const TextSearch* s, const char* text, size_t len);
+
+// The prompt, or how the last search went; empty when there is nothing to say
+void text_search_status(const TextSearch* s, char* out, size_t size);
+
+#endif
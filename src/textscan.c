@@ -0,0 +1,238 @@
+#include "textscan.h"
+
+#include <pthread.h>
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__x86_64__) || (defined(__i386__) && defined(__SSE2__))
+#define TEXTSCAN_X86 1
+#include <immintrin.h>
+#endif
+
+static int breaks_space(char c) {
+  return c == '<' || textscan_is_space(c);
+}
+
+static size_t plain_run_scalar(const char* p, size_t len) {
+  for (size_t i = 0; i < len; i++) {
+    char c = p[i];
+    if (c == '<' || c == '&' || (c != ' ' && textscan_is_space(c))) return i;
+    if (c == ' ' && (i + 1 == len || breaks_space(p[i + 1]))) return i;
+  }
+  return len;
+}
+
+static inline unsigned char fold(unsigned char c) {
+  return c >= 'A' && c <= 'Z' ? c + ('a' - 'A') : c;
+}
+
+static int equal_folded(const char* a, const char* b, size_t n) {
+  for (size_t i = 0; i < n; i++) {
+    if (fold(a[i]) != fold(b[i])) return 0;
+  }
+  return 1;
+}
+
+// 0x20 for letters, whose two cases differ only in that bit
+static inline unsigned char case_bit(unsigned char c) {
+  return (fold(c) >= 'a' && fold(c) <= 'z') ? 0x20 : 0;
+}
+
+static const char* find_scalar(const char* hay, size_t len, const char* needle, size_t n) {
+  if (n > len) return NULL;
+
+  size_t shift[256];
+  for (int c = 0; c < 256; c++) shift[c] = n;
+  for (size_t i = 0; i + 1 < n; i++) {
+    unsigned char c = fold(needle[i]);
+    shift[c] = n - 1 - i;
+    if (case_bit(c)) shift[c - 0x20] = n - 1 - i;
+  }
+
+  unsigned char last = fold(needle[n - 1]);
+  for (size_t i = 0; i + n <= len; i += shift[(unsigned char)hay[i + n - 1]]) {
+    if (fold(hay[i + n - 1]) == last && equal_folded(hay + i, needle, n - 1)) return hay + i;
+  }
+  return NULL;
+}
+
+#ifdef TEXTSCAN_X86
+
+/**
+ * Each block is compared against its own bytes and the bytes one further
+ * on, so "space followed by whitespace or '<'" is a plain AND of two masks.
+ * \t..\r is tested as (c - '\t') <= 4 unsigned, via min_epu8 since SSE2
+ * has no unsigned compare. Needs one byte of lookahead past the block.
+ */
+static size_t plain_run_sse2(const char* p, size_t len) {
+  const __m128i lt = _mm_set1_epi8('<');
+  const __m128i amp = _mm_set1_epi8('&');
+  const __m128i sp = _mm_set1_epi8(' ');
+  const __m128i tab = _mm_set1_epi8('\t');
+  const __m128i span = _mm_set1_epi8('\r' - '\t');
+
+  size_t i = 0;
+  for (; i + 17 <= len; i += 16) {
+    __m128i v = _mm_loadu_si128((const __m128i*)(p + i));
+    __m128i n = _mm_loadu_si128((const __m128i*)(p + i + 1));
+
+    __m128i ctl = _mm_sub_epi8(v, tab);
+    __m128i next_ctl = _mm_sub_epi8(n, tab);
+    __m128i next_breaks = _mm_or_si128(
+      _mm_or_si128(_mm_cmpeq_epi8(n, sp), _mm_cmpeq_epi8(n, lt)),
+      _mm_cmpeq_epi8(_mm_min_epu8(next_ctl, span), next_ctl));
+
+    __m128i hit = _mm_or_si128(
+      _mm_or_si128(_mm_cmpeq_epi8(v, lt), _mm_cmpeq_epi8(v, amp)),
+      _mm_or_si128(_mm_cmpeq_epi8(_mm_min_epu8(ctl, span), ctl),
+                   _mm_and_si128(_mm_cmpeq_epi8(v, sp), next_breaks)));
+
+    int mask = _mm_movemask_epi8(hit);
+    if (mask) return i + __builtin_ctz(mask);
+  }
+  return i + plain_run_scalar(p + i, len - i);
+}
+
+// OR-ing in 0x20 makes both cases of a letter compare equal; other bytes compare as they are
+static const char* find_sse2(const char* hay, size_t len, const char* needle, size_t n) {
+  if (n > len) return NULL;
+
+  unsigned char first = needle[0], last = needle[n - 1];
+  const __m128i first_bit = _mm_set1_epi8(case_bit(first));
+  const __m128i last_bit = _mm_set1_epi8(case_bit(last));
+  const __m128i first_v = _mm_set1_epi8(first | case_bit(first));
+  const __m128i last_v = _mm_set1_epi8(last | case_bit(last));
+
+  size_t i = 0;
+  for (; i + n - 1 + 16 <= len; i += 16) {
+    __m128i a = _mm_or_si128(_mm_loadu_si128((const __m128i*)(hay + i)), first_bit);
+    __m128i b = _mm_or_si128(_mm_loadu_si128((const __m128i*)(hay + i + n - 1)), last_bit);
+    unsigned mask = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(a, first_v), _mm_cmpeq_epi8(b, last_v)));
+    while (mask) {
+      size_t at = i + __builtin_ctz(mask);
+      if (equal_folded(hay + at, needle, n)) return hay + at;
+      mask &= mask - 1;
+    }
+  }
+  return find_scalar(hay + i, len - i, needle, n);
+}
+
+__attribute__((target("avx2")))
+static const char* find_avx2(const char* hay, size_t len, const char* needle, size_t n) {
+  if (n > len) return NULL;
+
+  unsigned char first = needle[0], last = needle[n - 1];
+  const __m256i first_bit = _mm256_set1_epi8(case_bit(first));
+  const __m256i last_bit = _mm256_set1_epi8(case_bit(last));
+  const __m256i first_v = _mm256_set1_epi8(first | case_bit(first));
+  const __m256i last_v = _mm256_set1_epi8(last | case_bit(last));
+
+  size_t i = 0;
+  for (; i + n - 1 + 32 <= len; i += 32) {
+    __m256i a = _mm256_or_si256(_mm256_loadu_si256((const __m256i*)(hay + i)), first_bit);
+    __m256i b = _mm256_or_si256(_mm256_loadu_si256((const __m256i*)(hay + i + n - 1)), last_bit);
+    uint32_t mask = (uint32_t)_mm256_movemask_epi8(
+      _mm256_and_si256(_mm256_cmpeq_epi8(a, first_v), _mm256_cmpeq_epi8(b, last_v)));
+    while (mask) {
+      size_t at = i + __builtin_ctz(mask);
+      if (equal_folded(hay + at, needle, n)) return hay + at;
+      mask &= mask - 1;
+    }
+  }
+  return find_sse2(hay + i, len - i, needle, n);
+}
+
+__attribute__((target("avx2")))
+static size_t plain_run_avx2(const char* p, size_t len) {
+  const __m256i lt = _mm256_set1_epi8('<');
+  const __m256i amp = _mm256_set1_epi8('&');
+  const __m256i sp = _mm256_set1_epi8(' ');
+  const __m256i tab = _mm256_set1_epi8('\t');
+  const __m256i span = _mm256_set1_epi8('\r' - '\t');
+
+  size_t i = 0;
+  for (; i + 33 <= len; i += 32) {
+    __m256i v = _mm256_loadu_si256((const __m256i*)(p + i));
+    __m256i n = _mm256_loadu_si256((const __m256i*)(p + i + 1));
+
+    __m256i ctl = _mm256_sub_epi8(v, tab);
+    __m256i next_ctl = _mm256_sub_epi8(n, tab);
+    __m256i next_breaks = _mm256_or_si256(
+      _mm256_or_si256(_mm256_cmpeq_epi8(n, sp), _mm256_cmpeq_epi8(n, lt)),
+      _mm256_cmpeq_epi8(_mm256_min_epu8(next_ctl, span), next_ctl));
+
+    __m256i hit = _mm256_or_si256(
+      _mm256_or_si256(_mm256_cmpeq_epi8(v, lt), _mm256_cmpeq_epi8(v, amp)),
+      _mm256_or_si256(_mm256_cmpeq_epi8(_mm256_min_epu8(ctl, span), ctl),
+                      _mm256_and_si256(_mm256_cmpeq_epi8(v, sp), next_breaks)));
+
+    unsigned mask = (unsigned)_mm256_movemask_epi8(hit);
+    if (mask) return i + __builtin_ctz(mask);
+  }
+  return i + plain_run_sse2(p + i, len - i);
+}
+
+#endif
+
+static size_t (*kernel)(const char*, size_t) = NULL;
+static const char* (*find_kernel)(const char*, size_t, const char*, size_t) = NULL;
+static const char* kernel_name = "scalar";
+static pthread_once_t kernel_once = PTHREAD_ONCE_INIT;
+
+static void pick_kernel(void) {
+  kernel = plain_run_scalar;
+  find_kernel = find_scalar;
+#ifdef TEXTSCAN_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    kernel = plain_run_avx2;
+    find_kernel = find_avx2;
+    kernel_name = "avx2";
+  } else {
+    kernel = plain_run_sse2;
+    find_kernel = find_sse2;
+    kernel_name = "sse2";
+  }
+#endif
+}
+
+size_t textscan_plain_run(const char* p, size_t len) {
+  pthread_once(&kernel_once, pick_kernel);
+  return kernel(p, len);
+}
+
+const char* textscan_find(const char* hay, size_t len, const char* needle, size_t n) {
+  if (n == 0) return hay;
+  pthread_once(&kernel_once, pick_kernel);
+  return find_kernel(hay, len, needle, n);
+}
+
+const char* textscan_kernel(void) {
+  pthread_once(&kernel_once, pick_kernel);
+  return kernel_name;
+}
+
+int textscan_use_kernel(const char* name) {
+  pthread_once(&kernel_once, pick_kernel);
+  if (strcmp(name, "scalar") == 0) {
+    kernel = plain_run_scalar;
+    find_kernel = find_scalar;
+    kernel_name = "scalar";
+    return 1;
+  }
+#ifdef TEXTSCAN_X86
+  if (strcmp(name, "sse2") == 0) {
+    kernel = plain_run_sse2;
+    find_kernel = find_sse2;
+    kernel_name = "sse2";
+    return 1;
+  }
+  if (strcmp(name, "avx2") == 0 && __builtin_cpu_supports("avx2")) {
+    kernel = plain_run_avx2;
+    find_kernel = find_avx2;
+    kernel_name = "avx2";
+    return 1;
+  }
+#endif
+  return 0;
+}
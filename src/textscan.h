@@ -0,0 +1,37 @@
+#ifndef TEXTSCAN_H
+#define TEXTSCAN_H
+
+#include <stddef.h>
+
+/**
+ * Length of the leading run that can be copied verbatim from a text node:
+ * stops at '<', '&', \t..\r, and at a space that starts a whitespace run,
+ * precedes a tag or ends the buffer. Single spaces between words stay in
+ * the run. Picks an AVX2, SSE2 or scalar kernel on first use.
+ */
+size_t textscan_plain_run(const char* p, size_t len);
+
+// The whitespace set the kernels agree on: space, \t, \n, \v, \f, \r
+static inline int textscan_is_space(char c) {
+  return c == ' ' || (unsigned char)(c - '\t') <= '\r' - '\t';
+}
+
+/**
+ * First occurrence of needle in hay ignoring ASCII case, or NULL. The
+ * vector kernels compare the needle's first and last bytes at every
+ * offset a block at a time and check only where both agree; the scalar
+ * one is Horspool.
+ */
+const char* textscan_find(const char* hay, size_t len, const char* needle, size_t n);
+
+// Name of the kernel in use, for the statistics screen
+const char* textscan_kernel(void);
+
+/**
+ * Switches to the "scalar", "sse2" or "avx2" kernel, so benchmarks can
+ * compare them; returns 0 if this CPU can't run it. Not for use while
+ * another thread scans.
+ */
+int textscan_use_kernel(const char* name);
+
+#endif
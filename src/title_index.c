@@ -0,0 +1,245 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "title_index.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+// Trigrams kept per title; CHAPTER_TEXT_MAX bytes never make more
+#define TITLE_GRAMS 512
+
+static int by_value(const void* a, const void* b) {
+  uint32_t x = *(const uint32_t*)a, y = *(const uint32_t*)b;
+  return (x > y) - (x < y);
+}
+
+static int by_rank(const void* a, const void* b) {
+  uint64_t x = *(const uint64_t*)a, y = *(const uint64_t*)b;
+  return (x > y) - (x < y);
+}
+
+/**
+ * Distinct trigrams of text, sorted, as three bytes in a word. Words are
+ * ASCII letters and digits, lower-cased, plus any byte of a multibyte
+ * character; with prefix set the last word is left open at the end, so
+ * "chap" already matches "Chapter".
+ */
+static int trigrams(const char* text, int prefix, uint32_t* out, int max) {
+  int n = 0;
+  uint32_t window = 0;
+  int in_word = 0;
+
+  for (const unsigned char* p = (const unsigned char*)text;; p++) {
+    unsigned char c = *p;
+    int word = (c >= '0' && c <= '9') || ((c | 0x20) >= 'a' && (c | 0x20) <= 'z') || c >= 0x80;
+    if (word) {
+      if (!in_word) window = ' ' << 8 | ' ';
+      if (c >= 'A' && c <= 'Z') c += 'a' - 'A';
+      window = (window << 8 | c) & 0xFFFFFF;
+      if (n < max) out[n++] = window;
+      in_word = 1;
+      continue;
+    }
+    if (in_word && (c || !prefix) && n < max) out[n++] = (window << 8 | ' ') & 0xFFFFFF;
+    in_word = 0;
+    if (!c) break;
+  }
+
+  qsort(out, n, sizeof(uint32_t), by_value);
+  int distinct = 0;
+  for (int i = 0; i < n; i++) {
+    if (distinct == 0 || out[distinct - 1] != out[i]) out[distinct++] = out[i];
+  }
+  return distinct;
+}
+
+static uint32_t slot_of(const TitleIndex* t, uint32_t key) {
+  uint32_t h = (key * 2654435761u) & (t->size - 1);
+  while (t->keys[h] && t->keys[h] != key) h = (h + 1) & (t->size - 1);
+  return h;
+}
+
+static const uint32_t* list_of(const TitleIndex* t, uint32_t key, uint32_t* len) {
+  uint32_t h = slot_of(t, key);
+  *len = t->keys[h] ? t->lens[h] : 0;
+  return t->keys[h] ? t->lists[h] : NULL;
+}
+
+static int grow_table(TitleIndex* t) {
+  uint32_t size = t->size ? t->size * 2 : 4096;
+  uint32_t* keys = calloc(size, sizeof(uint32_t));
+  uint32_t** lists = calloc(size, sizeof(uint32_t*));
+  uint32_t* lens = calloc(size, sizeof(uint32_t));
+  uint32_t* caps = calloc(size, sizeof(uint32_t));
+  if (!keys || !lists || !lens || !caps) {
+    free(keys);
+    free(lists);
+    free(lens);
+    free(caps);
+    return 0;
+  }
+
+  TitleIndex old = *t;
+  t->keys = keys;
+  t->lists = lists;
+  t->lens = lens;
+  t->caps = caps;
+  t->size = size;
+  for (uint32_t i = 0; i < old.size; i++) {
+    if (!old.keys[i]) continue;
+    uint32_t h = slot_of(t, old.keys[i]);
+    keys[h] = old.keys[i];
+    lists[h] = old.lists[i];
+    lens[h] = old.lens[i];
+    caps[h] = old.caps[i];
+  }
+  free(old.keys);
+  free(old.lists);
+  free(old.lens);
+  free(old.caps);
+  return 1;
+}
+
+static int add(TitleIndex* t, uint32_t key, uint32_t title) {
+  if ((t->used + 1) * 2 > t->size && !grow_table(t)) return 0;
+
+  uint32_t h = slot_of(t, key);
+  if (!t->keys[h]) {
+    t->keys[h] = key;
+    t->used++;
+  }
+  if (t->lens[h] == t->caps[h]) {
+    uint32_t cap = t->caps[h] ? t->caps[h] * 2 : 4;
+    uint32_t* list = realloc(t->lists[h], cap * sizeof(uint32_t));
+    if (!list) return 0;
+    t->lists[h] = list;
+    t->caps[h] = cap;
+  }
+  t->lists[h][t->lens[h]++] = title;
+  return 1;
+}
+
+int title_index_build(TitleIndex* t, const ChapterIndex* chapters) {
+  memset(t, 0, sizeof(*t));
+  int total = chapter_index_count(chapters);
+  size_t slots = total > 0 ? (size_t)total : 1;
+  t->grams = malloc(slots * sizeof(uint16_t));
+  t->candidates = malloc(slots * sizeof(uint32_t));
+  t->misses = malloc(slots);
+  int ok = t->grams && t->candidates && t->misses && grow_table(t);
+
+  char title[CHAPTER_TEXT_MAX];
+  uint32_t grams[TITLE_GRAMS];
+  for (int i = 0; ok && i < total; i++) {
+    int n = trigrams(chapter_index_title(chapters, i, title, sizeof(title)), 0, grams, TITLE_GRAMS);
+    t->grams[i] = n;
+    for (int g = 0; ok && g < n; g++) ok = add(t, grams[g], i);
+  }
+
+  if (!ok) {
+    title_index_free(t);
+    return 0;
+  }
+  t->count = total;
+  return 1;
+}
+
+// Every title sharing a trigram with the query and lacking few enough of them
+static void collect(TitleIndex* t, const uint32_t* grams, int n) {
+  // Hits are counted per title in misses, then packed down in place
+  memset(t->misses, 0, t->count);
+  for (int g = 0; g < n; g++) {
+    uint32_t len;
+    const uint32_t* list = list_of(t, grams[g], &len);
+    for (uint32_t i = 0; i < len; i++) t->misses[list[i]]++;
+  }
+
+  int kept = 0;
+  for (int i = 0; i < t->count; i++) {
+    int hits = t->misses[i];
+    if (hits == 0 || n - hits > TITLE_MAX_MISSES) continue;
+    t->candidates[kept] = i;
+    t->misses[kept++] = n - hits;
+  }
+  t->candidate_count = kept;
+}
+
+// The query grew: candidates are only checked against its new trigrams
+static void narrow(TitleIndex* t, const uint32_t* grams, int n) {
+  int old = 0;
+  for (int g = 0; g < n; g++) {
+    while (old < t->query_count && t->query[old] < grams[g]) old++;
+    if (old < t->query_count && t->query[old] == grams[g]) continue;
+
+    uint32_t len, at = 0;
+    const uint32_t* list = list_of(t, grams[g], &len);
+    for (int c = 0; c < t->candidate_count; c++) {
+      while (at < len && list[at] < t->candidates[c]) at++;
+      if (at == len || list[at] != t->candidates[c]) t->misses[c]++;
+    }
+  }
+
+  int kept = 0;
+  for (int c = 0; c < t->candidate_count; c++) {
+    if (t->misses[c] > TITLE_MAX_MISSES) continue;
+    t->candidates[kept] = t->candidates[c];
+    t->misses[kept++] = t->misses[c];
+  }
+  t->candidate_count = kept;
+}
+
+// Whether sorted a is contained in sorted b
+static int subset(const uint32_t* a, int na, const uint32_t* b, int nb) {
+  int j = 0;
+  for (int i = 0; i < na; i++) {
+    while (j < nb && b[j] < a[i]) j++;
+    if (j == nb || b[j] != a[i]) return 0;
+  }
+  return 1;
+}
+
+int title_index_search(TitleIndex* t, const char* query, int* out, int max) {
+  uint32_t grams[TITLE_QUERY_GRAMS];
+  int n = trigrams(query, 1, grams, TITLE_QUERY_GRAMS);
+  if (n == 0 || t->count == 0) {
+    t->query_count = 0;
+    t->candidate_count = 0;
+    return 0;
+  }
+
+  // Below this many trigrams a title sharing none would still count, so
+  // the candidates are not everything the longer query could match
+  if (t->query_count > TITLE_MAX_MISSES && subset(t->query, t->query_count, grams, n)) narrow(t, grams, n);
+  else collect(t, grams, n);
+  memcpy(t->query, grams, n * sizeof(uint32_t));
+  t->query_count = n;
+
+  // A typo costs up to three trigrams; short queries have to match outright
+  int allowed = n / 3 < TITLE_MAX_MISSES ? n / 3 : TITLE_MAX_MISSES;
+  uint64_t* ranked = malloc((t->candidate_count ? t->candidate_count : 1) * sizeof(uint64_t));
+  if (!ranked) return 0;
+  int count = 0;
+  for (int c = 0; c < t->candidate_count; c++) {
+    if (t->misses[c] > allowed) continue;
+    uint32_t id = t->candidates[c];
+    ranked[count++] = (uint64_t)t->misses[c] << 48 | (uint64_t)t->grams[id] << 32 | id;
+  }
+  qsort(ranked, count, sizeof(uint64_t), by_rank);
+
+  if (count > max) count = max;
+  for (int i = 0; i < count; i++) out[i] = (uint32_t)ranked[i];
+  free(ranked);
+  return count;
+}
+
+void title_index_free(TitleIndex* t) {
+  for (uint32_t i = 0; i < t->size; i++) free(t->lists[i]);
+  free(t->keys);
+  free(t->lists);
+  free(t->lens);
+  free(t->caps);
+  free(t->grams);
+  free(t->candidates);
+  free(t->misses);
+  memset(t, 0, sizeof(*t));
+}
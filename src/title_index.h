@@ -0,0 +1,51 @@
+#ifndef TITLE_INDEX_H
+#define TITLE_INDEX_H
+
+#include <stdint.h>
+
+#include "chapter_index.h"
+
+// Query trigrams a title may lack and still be listed
+#define TITLE_MAX_MISSES 8
+#define TITLE_QUERY_GRAMS 64
+
+/**
+ * Trigram index over a novel's chapter titles, for typo-tolerant search.
+ * Titles are folded to lower-case ASCII words, each padded as "  word ",
+ * and every title lists the distinct three-byte windows of that. A title
+ * matches when it holds all but a few of the query's trigrams.
+ *
+ * The candidates of the last query are kept: while the query only grows,
+ * the next search checks just those against the new trigrams instead of
+ * going through the lists again.
+ */
+typedef struct {
+  uint32_t* keys;       // Open addressing; 0 is an empty slot
+  uint32_t** lists;     // Titles holding each trigram, ascending
+  uint32_t* lens;
+  uint32_t* caps;
+  uint32_t size, used;
+
+  uint16_t* grams;      // Distinct trigrams per title
+  int count;
+
+  uint32_t query[TITLE_QUERY_GRAMS];
+  int query_count;
+  uint32_t* candidates; // Titles within TITLE_MAX_MISSES of query, ascending
+  uint8_t* misses;
+  int candidate_count;
+} TitleIndex;
+
+// Returns 0 if out of memory, leaving the index empty
+int title_index_build(TitleIndex* t, const ChapterIndex* chapters);
+
+/**
+ * Chapters whose titles match query, closest first: fewest missing
+ * trigrams, then shortest title, then reading order. The last word of
+ * the query is taken as a prefix. Fills up to max and returns how many.
+ */
+int title_index_search(TitleIndex* t, const char* query, int* out, int max);
+
+void title_index_free(TitleIndex* t);
+
+#endif
@@ -3,6 +3,10 @@
 
 #include "ui.h"
 #include "controller.h"
+#include "revalidate.h"
+#include "line_map.h"
+#include "wrap.h"
+#include "text_search.h"
 
 #include <stdlib.h>
 #include <string.h>
@@ -13,7 +17,6 @@
 #include <dirent.h>
 #include <sys/stat.h>
 
-#define MAX_LINE 1024
 #define ITEMS_PER_PAGE 12
 
 void truncate_with_ellipsis(char *dest, const char *src, int max_width)
@@ -36,8 +39,27 @@ void truncate_with_ellipsis(char *dest, const char *src, int max_width)
   strcat(dest, "...");
 }
 
-int display_menu(char *options[], int n_options) {
-  int highlight = 0;
+/**
+ * Waits for a key. A live screen passes the revalidation of what it shows,
+ * wakes up every so often while that runs, and gets MENU_UPDATED once it
+ * has finished so it can swap fresh data in.
+ */
+static int wait_key(Revalidation* rv) {
+  if (!rv) return getch();
+
+  while (1) {
+    if (revalidate_state(rv) != REVALIDATE_PENDING) return MENU_UPDATED;
+
+    timeout(250);
+    int c = getch();
+    timeout(-1);
+    if (c != ERR) return c;
+  }
+}
+
+static int run_menu(char *options[], int n_options, MenuView* view, Revalidation* rv) {
+  int highlight = view->highlight < n_options ? view->highlight : 0;
+  int top = view->top; // First option on screen
   int choice = -1;
   int c;
 
@@ -45,32 +67,45 @@ int display_menu(char *options[], int n_options) {
   getmaxyx(stdscr, rows, cols);
   char truncated[512];
 
+  // Numbers get as many columns as the last one needs
+  int digits = snprintf(NULL, 0, "%d", n_options);
+  int text_col = 3 + (digits > 2 ? digits : 2);
+
   while (1) {
+    // Only the options that fit are drawn, however long the list
+    int visible = rows > 1 ? rows - 1 : 1;
+    if (highlight < top) top = highlight;
+    if (highlight >= top + visible) top = highlight - visible + 1;
+
     clear();
 
-    for (int i = 0; i < n_options; i++) {
+    for (int i = top; i < n_options && i < top + visible; i++) {
+      int row = i - top;
 
       if (i == highlight) {
         attron(COLOR_PAIR(5));
-        mvprintw(i, 0, "▌");
+        mvprintw(row, 0, "▌");
         attroff(COLOR_PAIR(5));
 
         attron(COLOR_PAIR(5) | A_DIM);
-        mvprintw(i, 2, "%d\n", i+1);
-        truncate_with_ellipsis(truncated, options[i], cols - 6);
-        mvprintw(i, 5, "%s", truncated);
+        mvprintw(row, 2, "%d\n", i+1);
+        truncate_with_ellipsis(truncated, options[i], cols - text_col - 1);
+        mvprintw(row, text_col, "%s", truncated);
         attroff(COLOR_PAIR(5) | A_DIM);
       } else {
-        mvprintw(i, 2, "%d\n", i+1);
-        truncate_with_ellipsis(truncated, options[i], cols - 6);
-        mvprintw(i, 5, "%s", truncated);
+        mvprintw(row, 2, "%d\n", i+1);
+        truncate_with_ellipsis(truncated, options[i], cols - text_col - 1);
+        mvprintw(row, text_col, "%s", truncated);
       }
     }
     attron(COLOR_PAIR(4));
-    mvprintw(rows - 1, 2, "↑↓ Move   ← Prev Page   q Back   Enter Open");
+    mvprintw(rows - 1, 2, "↑↓ Move   PgUp/PgDn Page   ← Prev Page   q Back   Enter Open");
     attroff(COLOR_PAIR(4));
 
-    c = getch();
+    view->highlight = highlight;
+    view->top = top;
+    c = wait_key(rv);
+    if (c == MENU_UPDATED) return MENU_UPDATED;
 
     switch (c) {
       case KEY_UP:
@@ -85,6 +120,18 @@ int display_menu(char *options[], int n_options) {
           highlight = 0;
         break;
 
+      case KEY_PPAGE:
+        highlight = highlight > visible ? highlight - visible : 0;
+        break;
+
+      case KEY_NPAGE:
+        highlight = highlight + visible < n_options ? highlight + visible : n_options - 1;
+        break;
+
+      case KEY_RESIZE:
+        getmaxyx(stdscr, rows, cols);
+        break;
+
       case 10:  // Enter key
         choice = highlight;
         break;
@@ -102,36 +149,55 @@ int display_menu(char *options[], int n_options) {
   return choice;
 }
 
-int display_webnovel_list(
-  char title[][256],
-  int count,
-  char yearly_views[][256],
-  char chapters[][256],
-  char ratings[][256],
-  char slugs[][256],
-  int *current_page)
+int display_menu(char *options[], int n_options) {
+  MenuView view = {0};
+  return run_menu(options, n_options, &view, NULL);
+}
+
+int display_live_menu(char *options[], int n_options, MenuView* view, Revalidation* rv) {
+  return run_menu(options, n_options, view, rv);
+}
+
+int display_webnovel_list(const PageCache* page, int *current_page, WebnovelListView* view,
+                          void (*on_highlight)(const NovelCard* card))
 {
-  (void) slugs;
-  int highlight = 0;
+  const NovelCard* cards = page->cards;
+  int count = page->count;
+  int highlight = view->highlight;
   int choice = -1;
   int c;
 
-  char search[256] = "";
-  int search_len = 0;
+  // Typed into the view, so a redraw for fresh results keeps it
+  char* search = view->filter;
+  int search_len = strlen(search);
 
-  int filtered[50];
+  int filtered[PAGE_CARDS_MAX];
   int filtered_count = 0;
+  int filtered_len = -1; // search_len the filter was made for
 
   while (1) {
 
     clear();
-    filtered_count = 0;
 
-    for (int i = 0; i < count; i++) {
-      if (strcasestr(title[i], search) != NULL) {
-        filtered[filtered_count++] = i;
+    // A longer search can only drop cards, so only the matches are checked
+    if (filtered_len >= 0 && search_len > filtered_len) {
+      int kept = 0;
+      for (int i = 0; i < filtered_count; i++) {
+        if (strcasestr(cards[filtered[i]].title, search) != NULL) filtered[kept++] = filtered[i];
+      }
+      filtered_count = kept;
+    } else if (search_len != filtered_len) {
+      filtered_count = 0;
+      for (int i = 0; i < count; i++) {
+        if (strcasestr(cards[i].title, search) != NULL) {
+          filtered[filtered_count++] = i;
+        }
       }
     }
+    filtered_len = search_len;
+    if (highlight >= filtered_count) highlight = filtered_count > 0 ? filtered_count - 1 : 0;
+    view->highlight = highlight;
+    if (on_highlight && filtered_count > 0) on_highlight(&cards[filtered[highlight]]);
 
     int rows, cols;
     getmaxyx(stdscr, rows, cols);
@@ -158,11 +224,11 @@ int display_webnovel_list(
         attron(COLOR_PAIR(5));
         mvprintw(row, 0, "▌");
         mvprintw(row, 1, "%d", 12*(*current_page - 1) + i + 1);
-        mvprintw(row, 5, "%s (Views:%s | Ch:%s | Rating:%s)", title[idx], yearly_views[idx], chapters[idx], ratings[idx]);
+        mvprintw(row, 5, "%s (Views:%s | Ch:%s | Rating:%s)", cards[idx].title, cards[idx].yearly_views, cards[idx].chapters, cards[idx].rating);
         attroff(COLOR_PAIR(5));
       } else {
         mvprintw(row, 1, "%d", 12*(*current_page - 1) + i + 1);
-        mvprintw(row, 5, "%s (Views:%s | Ch:%s | Rating:%s)", title[idx], yearly_views[idx], chapters[idx], ratings[idx]);
+        mvprintw(row, 5, "%s (Views:%s | Ch:%s | Rating:%s)", cards[idx].title, cards[idx].yearly_views, cards[idx].chapters, cards[idx].rating);
       }
 
       row++;
@@ -175,9 +241,12 @@ int display_webnovel_list(
     move(0, 19 + search_len);
     curs_set(1);
 
-    c = getch();
+    c = wait_key(page->revalidation);
 
-    if (c == 27) {
+    if (c == MENU_UPDATED) {
+      return MENU_UPDATED;
+    }
+    else if (c == 27) {
       return -2;
     }
     else if (c == KEY_BACKSPACE || c == 127) {
@@ -185,7 +254,7 @@ int display_webnovel_list(
         search[--search_len] = '\0';
       }
     }
-    else if (isprint(c) && search_len < 255) {
+    else if (isprint(c) && search_len < (int)sizeof(view->filter) - 1) {
       search[search_len++] = c;
       search[search_len] = '\0';
     }
@@ -228,113 +297,136 @@ int display_webnovel_list(
   return choice;
 }
 
+static void progress_file_path(char* path, size_t size, const char* book_title) {
+  char progress_dir[512];
+  get_user_path(progress_dir, "progress", sizeof(progress_dir));
+  snprintf(path, size, "%s/%s.txt", progress_dir, book_title);
+}
+
+int read_progress(const char* book_title, int* line, size_t* pos) {
+  char progress_path[1024];
+  progress_file_path(progress_path, sizeof(progress_path), book_title);
+
+  FILE* progress_file = fopen(progress_path, "r");
+  if (!progress_file) return 0;
+  *line = 0;
+  *pos = 0;
+  if (fscanf(progress_file, "%d %zu", line, pos) < 1 || *line < 0) *line = 0;
+  fclose(progress_file);
+  return 1;
+}
+
+/**
+ * Library reader. The book is mapped rather than read, and lines are
+ * found and wrapped only as far as the reader scrolls, so the first page
+ * of a multi-megabyte book shows as quickly as that of a short one, and
+ * so does the page after a resize.
+ */
 int display_book(FILE* fp, const char* book_title) {
+  return display_book_search(fp, book_title, NULL);
+}
+
+int display_book_search(FILE* fp, const char* book_title, const char* find) {
   if (!fp) {
     perror("File open failed");
     return -2;
   }
 
-  char **lines = NULL;
-  int capacity = 0;
-  int count = 0;
+  LineMap book;
+  if (!line_map_open(&book, fileno(fp))) return -2;
 
-  char buffer[MAX_LINE];
+  WrapIndex wrap;
+  wrap_init(&wrap, &book, 1);
+  TextSearch search;
+  text_search_init(&search, &book);
+  int reveal = find && *find;
+  if (reveal) text_search_start(&search, find, 0);
 
-  while (fgets(buffer, MAX_LINE, fp)) {
-
-    buffer[strcspn(buffer, "\n")] = '\0';
-
-    if (count >= capacity) {
-      capacity = capacity == 0 ? 100 : capacity * 2;
-      lines = realloc(lines, capacity * sizeof(char *));
-    }
-
-    lines[count] = strdup(buffer);
-    count++;
-  }
-
-  int offset = 0;
-
-  char progress_dir[512];
-  get_user_path(progress_dir, "progress", sizeof(progress_dir));
+  // Progress is the line and byte at the top, so it holds at any width
+  WrapPos top = {0, 0};
+  read_progress(book_title, &top.line, &top.pos);
 
   char progress_path[1024];
-  snprintf(progress_path, sizeof(progress_path), "%s/%s.txt", progress_dir, book_title);
-
-  FILE* progress_file = fopen(progress_path, "r");
-  // Use progress_file instead of the hardcoded ".progress"
-  if (progress_file) {
-    fscanf(progress_file, "%d", &offset);
-    fclose(progress_file);
-  }
+  progress_file_path(progress_path, sizeof(progress_path), book_title);
 
   int ch;
+  int result = 0;
 
   while (1) {
-    clear();
     int rows, cols;
     getmaxyx(stdscr, rows, cols);
-
-    int screen_row = 0;
-    for (int i = offset; i < count && screen_row < rows - 1; i++) {
-
-      char *line = lines[i];
-      int len = strlen(line);
-      int start = 0;
-
-      while (start < len && screen_row < rows - 1) {
-        mvprintw(screen_row, 0, "%.*s", cols - 1, line + start);
-        start += cols - 1;
-        screen_row++;
-      }
+    int text_h = rows > 1 ? rows - 1 : 1;
+
+    if (wrap_set_width(&wrap, cols - 1)) top = wrap_snap(&wrap, top);
+    if (reveal && search.hit) wrap_reveal(&wrap, &top, text_h, text_search_pos(&search));
+    reveal = 0;
+    // Never past the last screenful; rows beyond it aren't looked for
+    wrap_clamp_bottom(&wrap, &top, text_h);
+
+    erase();
+
+    WrapPos at = top;
+    for (int screen_row = 0; screen_row < text_h; screen_row++) {
+      size_t len;
+      const char* text = wrap_row(&wrap, at, &len);
+      if (!text) break;
+      text_search_draw(stdscr, screen_row, 0, &search, text, len);
+      if (wrap_step(&wrap, &at, 1) == 0) break;
     }
 
+    char status[TEXT_SEARCH_MAX + 64];
+    text_search_status(&search, status, sizeof(status));
     attron(COLOR_PAIR(4));
-    mvprintw(rows - 1, 0, "<- Main Menu   q = Quit   ↑↓ Scroll   PgUp/PgDn page");
+    if (status[0]) mvprintw(rows - 1, 0, "%s", status);
+    else mvprintw(rows - 1, 0, "<- Main Menu   q = Quit   ↑↓ Scroll   PgUp/PgDn page   / Search");
+    int row = wrap_row_number(&wrap, top);
+    int total = wrap_total(&wrap);
+    if (row >= 0 && total > 0 && !search.editing) {
+      long seen = (long)row + text_h;
+      printw("   %ld%%", (seen < total ? seen : total) * 100 / total);
+    }
     attroff(COLOR_PAIR(4));
 
     refresh();
 
-    ch = getch();
+    // The rest of the book is measured between keys for the position above
+    if (total < 0) {
+      timeout(0);
+      while ((ch = getch()) == ERR && wrap_measure(&wrap, WRAP_MEASURE_SLICE)) {}
+      timeout(-1);
+      if (ch == ERR) continue;
+    } else {
+      ch = getch();
+    }
 
-    if (ch == KEY_UP && offset > 0)
-      offset--;
-    else if (ch == KEY_DOWN && offset < count - 1)
-      offset++;
+    SearchAction found = text_search_key(&search, ch, top);
+    if (found == SEARCH_CANCELLED)
+      top = wrap_snap(&wrap, search.origin_top);
+    else if (found == SEARCH_UPDATED && search.hit)
+      wrap_reveal(&wrap, &top, text_h, text_search_pos(&search));
+    else if (found != SEARCH_IGNORED)
+      continue;
+    else if (ch == KEY_UP)
+      wrap_step(&wrap, &top, -1);
+    else if (ch == KEY_DOWN)
+      wrap_step(&wrap, &top, 1);
     else if (ch == KEY_NPAGE)
-      offset += rows;
+      wrap_step(&wrap, &top, text_h);
     else if (ch == KEY_PPAGE)
-      offset -= rows;
-    else if (ch == 'q' || ch == KEY_LEFT){
-      progress_file = fopen(progress_path, "w");
-      if (progress_file) {
-        fprintf(progress_file, "%d\n", offset);
-        fclose(progress_file);
-      }
-
-      for (int i = 0; i < count; i++)
-        free(lines[i]);
-      return -1;
+      wrap_step(&wrap, &top, -text_h);
+    else if (ch == 'q' || ch == KEY_LEFT) {
+      result = -1;
+      break;
     }
-
-    if (offset < 0)
-      offset = 0;
-
-    int max_offset = count - rows + 1;
-    if (max_offset < 0)
-      max_offset = 0;
-    if (offset > max_offset)
-      offset = max_offset;
   }
 
-  progress_file = fopen(progress_path, "w");
+  FILE* progress_file = fopen(progress_path, "w");
   if (progress_file) {
-    fprintf(progress_file, "%d\n", offset);
+    fprintf(progress_file, "%d %zu\n", top.line, top.pos);
     fclose(progress_file);
   }
 
-  for (int i = 0; i < count; i++)
-    free(lines[i]);
-  free(lines);
-  return 0;
+  wrap_free(&wrap);
+  line_map_close(&book);
+  return result;
 }
@@ -3,22 +3,41 @@
 
 #include <stdio.h>
 
-#define MAX_LINE 1024
+#include "cache.h"
 
 #define MAX_RESULTS 300
 
-int display_webnovel_list(
-    char title[][256],
-    int count,
-    char yearly_views[][256],
-    char chapters[][256],
-    char ratings[][256],
-    char slugs[][256],
-    int* current_page
-);
+// Returned by live screens when background data arrived; redisplay to show it
+#define MENU_UPDATED -3
+
+// The webnovel list's filter and cursor, kept by the caller across redraws
+typedef struct {
+  char filter[256];
+  int highlight;
+} WebnovelListView;
+
+// -2 to leave, -1 after a page change, MENU_UPDATED once the page's revalidation finishes, or the chosen card
+// on_highlight, if given, is told about the card under the cursor whenever it is drawn
+int display_webnovel_list(const PageCache* page, int* current_page, WebnovelListView* view,
+                          void (*on_highlight)(const NovelCard* card));
 
 int display_menu(char *options[], int n_options);
 
+// A menu's cursor, kept by the caller across redraws
+typedef struct {
+  int highlight;
+  int top; // First option on screen
+} MenuView;
+
+// display_menu() on the caller's view that returns MENU_UPDATED once rv, if given, finishes
+int display_live_menu(char *options[], int n_options, MenuView* view, Revalidation* rv);
+
 int display_book(FILE *fp, const char* book_title);
 
+// display_book() opened on the first match of find instead of the saved position
+int display_book_search(FILE *fp, const char* book_title, const char* find);
+
+// Where the reader left book_title; 0 if it was never opened
+int read_progress(const char* book_title, int* line, size_t* pos);
+
 #endif
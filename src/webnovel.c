@@ -5,6 +5,13 @@
 #include "ui.h"
 #include "cache.h"
 #include "chapter_controller.h"
+#include "chapter_list.h"
+#include "http.h"
+#include "acmatch.h"
+#include "entity.h"
+#include "crc32.h"
+#include "revalidate.h"
+#include "event_loop.h"
 
 #include <curl/curl.h>
 #include <stdio.h>
@@ -12,201 +19,692 @@
 #include <string.h>
 #include <ctype.h>
 #include <ncurses.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <time.h>
 
 #define MAX_RESULTS 300
-#define MAX_PAGES 50
-PageCache page_cache[MAX_PAGES];
+#define MAX_CARDS 12
 
-struct Memory {
-  char *data;
-  size_t size;
-};
+// Search pages stay cached across searches until pushed out by newer ones
+static PageCache page_cache[PAGE_CACHE_SLOTS];
+static unsigned long page_clock = 0;
+static PageCacheStats page_stats;
 
-PageCache* get_cached_page(int page)
+static PageCache* find_page(const char* query, int page)
 {
-  for (int i = 0; i < MAX_PAGES; i++) {
+  for (int i = 0; i < PAGE_CACHE_SLOTS; i++) {
     if (page_cache[i].is_valid &&
-      page_cache[i].page_number == page)
+      page_cache[i].page_number == page &&
+      strcmp(page_cache[i].query, query) == 0) {
       return &page_cache[i];
+    }
   }
   return NULL;
 }
 
-void clear_cache()
+PageCache* get_cached_page(const char* query, int page)
+{
+  PageCache* found = find_page(query, page);
+  if (found) {
+    found->last_used = ++page_clock;
+    page_stats.hits++;
+  } else {
+    page_stats.misses++;
+  }
+  return found;
+}
+
+// An empty slot, or the least recently used one emptied out
+static PageCache* claim_page_slot(void)
+{
+  PageCache* victim = &page_cache[0];
+  for (int i = 0; i < PAGE_CACHE_SLOTS; i++) {
+    if (!page_cache[i].is_valid) return &page_cache[i];
+    if (page_cache[i].last_used < victim->last_used) victim = &page_cache[i];
+  }
+
+  revalidate_release(victim->revalidation);
+  free(victim->arena);
+  memset(victim, 0, sizeof(*victim));
+  page_stats.evictions++;
+  return victim;
+}
+
+void page_cache_get_stats(PageCacheStats* out)
 {
-  for (int i = 0; i < MAX_PAGES; i++) {
-    page_cache[i].is_valid = 0;
-    page_cache[i].page_number = -1;
-    page_cache[i].count = 0;
+  *out = page_stats;
+}
+
+enum {
+  MARK_SLUG,
+  MARK_CARD,
+  MARK_RATING,
+  MARK_STAR,
+  MARK_TITLE,
+  MARK_VIEWS,
+  MARK_VIEWS_LABEL,
+  MARK_CHAPTERS,
+  MARK_CHAPTERS_LABEL
+};
+
+static ACMatcher card_matcher;
+
+// Every marker a search-result card is parsed from, compiled once; NULL if
+// one didn't fit, since a matcher missing a marker would silently lose fields
+static const ACMatcher* get_card_matcher(void) {
+  static int complete;
+  if (!card_matcher.built) {
+    ac_init(&card_matcher);
+    complete = ac_add(&card_matcher, "/novel/", MARK_SLUG) &&
+               ac_add(&card_matcher, "mantine-Card-root", MARK_CARD) &&
+               ac_add(&card_matcher, "mantine-807m0k", MARK_RATING) &&
+               ac_add(&card_matcher, "⭐", MARK_STAR) &&
+               ac_add(&card_matcher, "mantine-pdrfb7", MARK_TITLE) &&
+               ac_add(&card_matcher, "mantine-w7z63c", MARK_VIEWS) &&
+               ac_add(&card_matcher, "Views:", MARK_VIEWS_LABEL) &&
+               ac_add(&card_matcher, "mantine-175mpop", MARK_CHAPTERS) &&
+               ac_add(&card_matcher, "Chapters:", MARK_CHAPTERS_LABEL);
+    ac_build(&card_matcher);
   }
+  return complete ? &card_matcher : NULL;
+}
+
+static const char* find_byte(const char* p, const char* end, char c, size_t limit) {
+  if ((size_t)(end - p) > limit) end = p + limit;
+  return memchr(p, c, end - p);
+}
+
+static const char* skip_to_digit(const char* p, const char* end) {
+  const char* limit = (end - p > 64) ? p + 64 : end;
+  while (p < limit && !isdigit((unsigned char)*p)) p++;
+  return p;
 }
 
+// Copies [start, end) into dest when its length lies strictly between min and max
+static int copy_field(char dest[256], const char* start, const char* end, int min, int max) {
+  int len = end - start;
+  if (len <= min || len >= max) return 0;
+  memcpy(dest, start, len);
+  dest[len] = '\0';
+  return 1;
+}
+
+/**
+ * Parses the search-results page in a single pass. The automaton reports
+ * each marker as it is reached; a card starts at mantine-Card-root and
+ * owns every field marker up to the next one, so short or long cards can't
+ * bleed into their neighbours. Field values are read from bounded windows
+ * right after their marker and scanning resumes past them, so the page is
+ * walked once: O(n) in its size.
+ */
 int extract_novel_info(char *html, char titles[12][256], char yearly_views[12][256], char chapters[12][256], char ratings[12][256], char slugs[12][256]) {
-  int count = 0;
-
-  char *card_pos = html;
-  while (count < 15) {
-    char *slug_pos = strstr(card_pos, "/novel/");
-    if (!slug_pos) break;
-    if (slug_pos) {
-      slug_pos += 7;
-      char *slug_end = strchr(slug_pos, '"');
-      if (slug_end && slug_end - slug_pos < 100) {
-        int len = slug_end - slug_pos;
-        strncpy(slugs[count], slug_pos, len);
-        slugs[count][len] = '\0';
+  const ACMatcher* ac = get_card_matcher();
+  if (!ac) return 0;
+  const char* p = html;
+  const char* end = html + strlen(html);
+  const char* match;
+  int state = 0;
+
+  int card = -1;
+  int expect = -1;                 // Label the last class marker promised
+  const char* pending_slug = NULL; // Link seen before the card it belongs to
+  int pending_len = 0;
+
+  int id;
+  while ((id = ac_next(ac, &state, &p, end, &match)) >= 0) {
+    if (id == MARK_SLUG) {
+      const char* slug_end = find_byte(p, end, '"', 100);
+      if (!slug_end) continue;
+
+      if (card >= 0 && !slugs[card][0]) {
+        copy_field(slugs[card], p, slug_end, 0, 100);
+      } else {
+        pending_slug = p;
+        pending_len = slug_end - p;
       }
+      continue;
     }
 
-    card_pos = strstr(card_pos, "mantine-Card-root");
-    if (!card_pos) break;
-
-    char *rating_pos = strstr(card_pos, "mantine-807m0k");
-    if (rating_pos) {
-      rating_pos = strstr(rating_pos, "⭐");
-      rating_pos+=2;
-      while(*rating_pos && !isdigit(*rating_pos)) rating_pos++;
-      char *rating_end = rating_pos;
-      while (*rating_end && (*rating_end == '.' || isdigit(*rating_end))) rating_end++;
-
-      int len = rating_end - rating_pos;
-      if (len > 0 && len < 10) {
-        strncpy(ratings[count], rating_pos, len);
-        ratings[count][len] = '\0';
+    if (id == MARK_CARD) {
+      if (card + 1 >= MAX_CARDS) break;
+      card++;
+      titles[card][0] = yearly_views[card][0] = chapters[card][0] = '\0';
+      ratings[card][0] = slugs[card][0] = '\0';
+      expect = -1;
+
+      if (pending_slug) {
+        copy_field(slugs[card], pending_slug, pending_slug + pending_len, 0, 100);
+        pending_slug = NULL;
       }
+      continue;
     }
 
-    char *title_pos = strstr(card_pos, "mantine-pdrfb7");
-    if (title_pos) {
-      title_pos = strstr(title_pos, ">");
-      if (title_pos) {
+    if (card < 0) continue;
+
+    switch (id) {
+      case MARK_RATING: expect = MARK_STAR; break;
+      case MARK_VIEWS: expect = MARK_VIEWS_LABEL; break;
+      case MARK_CHAPTERS: expect = MARK_CHAPTERS_LABEL; break;
+
+      case MARK_TITLE: {
+        const char* title_pos = find_byte(p, end, '>', 512);
+        if (!title_pos) break;
         title_pos++;
-        char *title_end = strchr(title_pos, '<');
-        if (title_end && title_end - title_pos > 3 && title_end - title_pos < 80) {
-          int len = title_end - title_pos;
-          strncpy(titles[count], title_pos, len);
-          titles[count][len] = '\0';
-
-          for (int i = 0; titles[count][i]; i++) {
-            if (titles[count][i] == '&' && strncmp(titles[count] + i, "&amp;", 5) == 0) {
-              memmove(titles[count] + i, titles[count] + i + 4, strlen(titles[count] + i));
-              titles[count][i] = ' ';
-            }
-          }
+        const char* title_end = find_byte(title_pos, end, '<', 256);
+        if (!title_end) break;
+
+        int len = title_end - title_pos;
+        if (!titles[card][0] && len > 3 && len < 80)
+          entity_decode_text(titles[card], 256, title_pos, len);
+        p = title_end;
+        state = 0;
+        break;
+      }
+
+      case MARK_STAR:
+      case MARK_VIEWS_LABEL:
+      case MARK_CHAPTERS_LABEL: {
+        if (id != expect) break;
+        expect = -1;
+
+        const char* value = skip_to_digit(p, end);
+        const char* value_end = value;
+        if (id == MARK_STAR) {
+          while (value_end < end && (*value_end == '.' || isdigit((unsigned char)*value_end))) value_end++;
+          if (!ratings[card][0]) copy_field(ratings[card], value, value_end, 0, 10);
+        } else {
+          while (value_end < end && value_end - value < 20 && !isspace((unsigned char)*value_end) && *value_end != '<') value_end++;
+          char* dest = (id == MARK_VIEWS_LABEL) ? yearly_views[card] : chapters[card];
+          if (!dest[0]) copy_field(dest, value, value_end, 0, 20);
         }
+        p = value_end;
+        state = 0;
+        break;
       }
     }
+  }
 
-    char *views_pos = strstr(card_pos, "mantine-w7z63c");
-    if (views_pos) {
-      views_pos = strstr(views_pos, "Views:");
-      if (views_pos) {
-        views_pos += 6;
-        while (*views_pos && !isdigit(*views_pos)) views_pos++;
+  return card + 1;
+}
 
-        char *views_end = views_pos;
-        while (*views_end && !isspace(*views_end) && *views_end != '<') views_end++;
+static void page_header(const char* line, size_t len, void* userdata) {
+  http_validators_header(userdata, line, len);
+}
 
-        int len = (views_end - views_pos);
-        if (len > 0 && len < 20) {
-          strncpy(yearly_views[count], views_pos, len);
-          yearly_views[count][len] = '\0';
-        }
-      }
-    }
+char *fetch_url(const char *url, HttpValidators* validators, const char* label, FetchState* state) {
+  FetchSink sink = { .header = validators ? page_header : NULL, .userdata = validators };
+  FetchJob* job = fetcher_submit(url, FETCH_PRIORITY_FOREGROUND, &sink);
+  *state = event_await(job, label);
 
-    char *chap_pos = strstr(card_pos, "mantine-175mpop");
-    if (chap_pos) {
-      chap_pos = strstr(chap_pos, "Chapters:");
-      if (chap_pos) {
-        chap_pos += 9;
-        while (*chap_pos && !isdigit(*chap_pos)) chap_pos++;
+  size_t size = 0;
+  char* body = *state == FETCH_DONE ? fetcher_take_body(job, &size) : NULL;
+  fetcher_release(job);
 
-        char *chap_end = chap_pos;
-        while (*chap_end && !isspace(*chap_end) && *chap_end != '<') chap_end++;
+  if (body && size < 100) {
+    free(body);
+    return NULL;
+  }
+  return body;
+}
 
-        int len = chap_end - chap_pos;
-        if (len > 0 && len < 20) {
-          strncpy(chapters[count], chap_pos, len);
-          chapters[count][len] = '\0';
-        }
-      }
+// Packs the parsed fields of every card into one arena
+static int store_page(PageCache* out_page, char fields[5][MAX_CARDS][256], int count)
+{
+  size_t total = 0;
+  for (int f = 0; f < 5; f++)
+    for (int i = 0; i < count; i++) total += strlen(fields[f][i]) + 1;
+
+  char* arena = malloc(total);
+  if (!arena) return 0;
+
+  char* p = arena;
+  const char** slots[5];
+  for (int i = 0; i < count; i++) {
+    NovelCard* card = &out_page->cards[i];
+    slots[0] = &card->title;
+    slots[1] = &card->yearly_views;
+    slots[2] = &card->chapters;
+    slots[3] = &card->rating;
+    slots[4] = &card->slug;
+
+    for (int f = 0; f < 5; f++) {
+      size_t len = strlen(fields[f][i]) + 1;
+      memcpy(p, fields[f][i], len);
+      *slots[f] = p;
+      p += len;
     }
+  }
+
+  out_page->arena = arena;
+  out_page->count = count;
+  return 1;
+}
 
-    count++;
-    card_pos += 1000;
+static const char* card_field(const NovelCard* card, int f)
+{
+  switch (f) {
+    case 0: return card->title;
+    case 1: return card->yearly_views;
+    case 2: return card->chapters;
+    case 3: return card->rating;
+    default: return card->slug;
   }
-  return count;
 }
 
-char *fetch_url(const char *url) {
-  CURL *curl = curl_easy_init();
-  if (!curl) return NULL;
+static void page_name(char* name, size_t size, const char* query, int page)
+{
+  snprintf(name, size, "%s_p%d", query, page);
+}
 
-  struct Memory chunk = { .data = NULL, .size = 0 };
-  curl_easy_setopt(curl, CURLOPT_URL, url);
-  curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, write_callback);
-  curl_easy_setopt(curl, CURLOPT_WRITEDATA, &chunk);
-  curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
-  curl_easy_setopt(curl, CURLOPT_USERAGENT, "Mozilla/5.0 (compatible; NovelBot/1.0)");
-  curl_easy_setopt(curl, CURLOPT_TIMEOUT, 10L);
-  curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 0L);
+/*
+ * Saved page layout, integers in host byte order:
+ *
+ *   "NCP1"  u32 crc  i64 fetched_at  u32 count
+ *   u16-prefixed etag, last_modified and query
+ *   count x 5 u16-prefixed card fields, in store_page() order
+ *
+ * The CRC covers everything after itself.
+ */
+#define PAGE_MAGIC "NCP1"
+#define PAGE_HEADER 20
+
+// Keeps the page on disk next to the book searches, so a later session starts from it
+static void save_page(const PageCache* page)
+{
+  size_t len = PAGE_HEADER + 6 + cache_text_len(page->validators.etag) +
+               cache_text_len(page->validators.last_modified) + cache_text_len(page->query);
+  for (int i = 0; i < page->count; i++)
+    for (int f = 0; f < 5; f++) len += 2 + cache_text_len(card_field(&page->cards[i], f));
+
+  unsigned char* buf = malloc(len);
+  if (!buf) return;
+  unsigned char* p = buf + PAGE_HEADER;
+  p += cache_put_text(p, page->validators.etag, cache_text_len(page->validators.etag));
+  p += cache_put_text(p, page->validators.last_modified, cache_text_len(page->validators.last_modified));
+  p += cache_put_text(p, page->query, cache_text_len(page->query));
+  for (int i = 0; i < page->count; i++) {
+    for (int f = 0; f < 5; f++) {
+      const char* field = card_field(&page->cards[i], f);
+      p += cache_put_text(p, field, cache_text_len(field));
+    }
+  }
 
-  CURLcode res = curl_easy_perform(curl);
-  curl_easy_cleanup(curl);
+  int64_t fetched_at = page->fetched_at;
+  uint32_t count = page->count;
+  memcpy(buf, PAGE_MAGIC, 4);
+  memcpy(buf + 8, &fetched_at, 8);
+  memcpy(buf + 16, &count, 4);
+  uint32_t crc = crc32(buf + 8, len - 8);
+  memcpy(buf + 4, &crc, 4);
+
+  char name[300];
+  page_name(name, sizeof(name), page->query, page->page_number);
+  search_cache_put(name, ".page", buf, len);
+  free(buf);
+}
 
-  if (res != CURLE_OK || chunk.size < 100) {
-    free(chunk.data);
-    return NULL;
-  }
-  return chunk.data;
+typedef struct {
+  const char* query;
+  int count;
+  int64_t fetched_at;
+  HttpValidators validators;
+  char fields[5][MAX_CARDS][256];
+} SavedPage;
+
+static int decode_page(const unsigned char* data, size_t size, void* userdata)
+{
+  SavedPage* saved = userdata;
+  uint32_t crc, count;
+  char query[256];
+  if (size < PAGE_HEADER || memcmp(data, PAGE_MAGIC, 4) != 0) return 0;
+  memcpy(&crc, data + 4, 4);
+  memcpy(&saved->fetched_at, data + 8, 8);
+  memcpy(&count, data + 16, 4);
+  if (count == 0 || count > MAX_CARDS || crc32(data + 8, size - 8) != crc) return 0;
+
+  const unsigned char* p = data + PAGE_HEADER;
+  const unsigned char* end = data + size;
+  HttpValidators* v = &saved->validators;
+  int ok = cache_get_text(&p, end, v->etag, sizeof(v->etag)) &&
+           cache_get_text(&p, end, v->last_modified, sizeof(v->last_modified)) &&
+           cache_get_text(&p, end, query, sizeof(query));
+  for (uint32_t i = 0; ok && i < count; i++)
+    for (int f = 0; ok && f < 5; f++) ok = cache_get_text(&p, end, saved->fields[f][i], 256);
+
+  saved->count = count;
+  // Different queries can share a file name; a foreign page is just a miss
+  return ok && p == end && strcmp(query, saved->query) == 0;
 }
 
-int fetch_page(int current_page, PageCache* out_page, char* escaped)
+static PageCache* load_page(const char* query, int current_page)
 {
-  if (!out_page)
-    return -1;
+  char name[300];
+  SavedPage* saved = calloc(1, sizeof(SavedPage));
+  if (!saved) return NULL;
+  saved->query = query;
+  page_name(name, sizeof(name), query, current_page);
+
+  PageCache* page = NULL;
+  if (search_cache_read(name, ".page", decode_page, saved)) {
+    page = claim_page_slot();
+    if (store_page(page, saved->fields, saved->count)) {
+      snprintf(page->query, sizeof(page->query), "%s", query);
+      page->page_number = current_page;
+      page->fetched_at = saved->fetched_at;
+      page->validators = saved->validators;
+      page->last_used = ++page_clock;
+      page->is_valid = 1;
+    } else {
+      page = NULL;
+    }
+  }
+  free(saved);
+  return page;
+}
 
-  char url[512];
-  snprintf(url, sizeof(url),
+static void page_url(char* url, size_t size, const char* escaped, int current_page)
+{
+  snprintf(url, size,
            "https://wuxia.click/search/%s?page=%d&order_by=-total_views",
            escaped, current_page);
+}
+
+// Applies a finished background check of page; returns 1 if it was replaced
+static int page_revalidated(PageCache* page)
+{
+  RevalidateState state = revalidate_state(page->revalidation);
+  if (state == REVALIDATE_PENDING) return 0;
+
+  int replaced = 0;
+  if (state == REVALIDATE_UNCHANGED) {
+    page->fetched_at = time(NULL);
+    save_page(page);
+  } else if (state == REVALIDATE_CHANGED) {
+    HttpValidators fresh;
+    char* html = revalidate_take_body(page->revalidation, NULL, &fresh);
+    char fields[5][MAX_CARDS][256] = {0};
+    int count = html ? extract_novel_info(html, fields[0], fields[1], fields[2], fields[3], fields[4]) : 0;
+    free(html);
+
+    char* old_arena = page->arena;
+    if (count > 0 && store_page(page, fields, count)) {
+      free(old_arena);
+      page->validators = fresh;
+      page->fetched_at = time(NULL);
+      save_page(page);
+      replaced = 1;
+    }
+  }
+
+  revalidate_release(page->revalidation);
+  page->revalidation = NULL;
+  return replaced;
+}
+
+// Puts a freshly parsed page in memory and on disk
+static PageCache* keep_page(const char* query, int current_page, char fields[5][MAX_CARDS][256], int count,
+                            const HttpValidators* validators)
+{
+  PageCache* out_page = claim_page_slot();
+  if (!store_page(out_page, fields, count))
+    return NULL;
+
+  snprintf(out_page->query, sizeof(out_page->query), "%s", query);
+  out_page->page_number = current_page;
+  out_page->fetched_at = time(NULL);
+  out_page->validators = *validators;
+  out_page->last_used = ++page_clock;
+  out_page->is_valid = 1;
+  save_page(out_page);
+
+  return out_page;
+}
 
+PageCache* fetch_page(const char* query, int current_page, char* escaped, FetchState* state)
+{
+  char url[512];
+  page_url(url, sizeof(url), escaped, current_page);
+
+  char label[64];
+  snprintf(label, sizeof(label), "Fetching page %d...", current_page);
   clear();
-  attron(COLOR_PAIR(2));
-  mvprintw(0, 0, "Fetching page %d...", current_page);
-  attroff(COLOR_PAIR(2));
-  refresh();
 
   /* ---- Fetch HTML ---- */
-  char* html = fetch_url(url);
+  HttpValidators validators = {0};
+  char* html = fetch_url(url, &validators, label, state);
   if (!html) {
-    return -1;
+    return NULL;
   }
 
-  char titles[12][256] = {0};
-  char yearly_views[12][256] = {0};
-  char chapters[12][256] = {0};
-  char ratings[12][256] = {0};
-  char slugs[12][256] = {0};
-  int count = extract_novel_info(html, titles, yearly_views, chapters, ratings, slugs);
+  // titles, yearly views, chapters, ratings, slugs
+  char fields[5][MAX_CARDS][256] = {0};
+  int count = extract_novel_info(html, fields[0], fields[1], fields[2], fields[3], fields[4]);
 
   free(html);
 
   if (count <= 0)
-    return -1;
+    return NULL;
+  return keep_page(query, current_page, fields, count, &validators);
+}
 
-  out_page->page_number = current_page;
-  out_page->count = count;
-  out_page->is_valid = 1;
+// Pages either side of the one shown that are fetched ahead of a flip
+#define SPECULATIVE_PAGES 2
 
-  memcpy(out_page->titles, titles, sizeof(titles));
-  memcpy(out_page->slugs, slugs, sizeof(slugs));
-  memcpy(out_page->ratings, ratings, sizeof(ratings));
-  memcpy(out_page->yearly_views, yearly_views, sizeof(yearly_views));
-  memcpy(out_page->chapters, chapters, sizeof(chapters));
+typedef struct {
+  char query[256];
+  int page_number;
+  FetchJob* job;
+
+  // Owned by the fetch worker until finished is set
+  HttpValidators validators;
+  char* html;
+  size_t size;
+  char (*fields)[MAX_CARDS][256];
+  int count;
+  int finished;
+  int orphaned; // Dropped by the UI; the done callback frees it
+} Speculation;
+
+static Speculation* speculations[SPECULATIVE_PAGES];
+static pthread_mutex_t speculation_lock = PTHREAD_MUTEX_INITIALIZER;
+
+// Pages of one query that came back empty or failed, so they are not
+// asked for again on every flip past the last page
+#define DEAD_PAGES_MAX 8
 
-  return count;
+static struct {
+  char query[256];
+  int pages[DEAD_PAGES_MAX];
+  int count;
+} dead_pages;
+
+static void note_dead_page(const char* query, int page)
+{
+  if (strcmp(dead_pages.query, query) != 0) {
+    snprintf(dead_pages.query, sizeof(dead_pages.query), "%s", query);
+    dead_pages.count = 0;
+  }
+  // The oldest is forgotten first; a full list is rare outside outages
+  if (dead_pages.count == DEAD_PAGES_MAX) {
+    memmove(dead_pages.pages, dead_pages.pages + 1, (DEAD_PAGES_MAX - 1) * sizeof(int));
+    dead_pages.count--;
+  }
+  dead_pages.pages[dead_pages.count++] = page;
+}
+
+static int is_dead_page(const char* query, int page)
+{
+  if (strcmp(dead_pages.query, query) != 0) return 0;
+  for (int i = 0; i < dead_pages.count; i++) {
+    if (dead_pages.pages[i] == page) return 1;
+  }
+  return 0;
+}
+
+static void speculation_header(const char* line, size_t len, void* userdata)
+{
+  Speculation* spec = userdata;
+  http_validators_header(&spec->validators, line, len);
+}
+
+static size_t speculation_write(const char* data, size_t len, void* userdata)
+{
+  Speculation* spec = userdata;
+  char* grown = realloc(spec->html, spec->size + len + 1);
+  if (!grown) return 0;
+  spec->html = grown;
+  memcpy(spec->html + spec->size, data, len);
+  spec->size += len;
+  spec->html[spec->size] = '\0';
+  return len;
+}
+
+static void speculation_free(Speculation* spec)
+{
+  free(spec->html);
+  free(spec->fields);
+  free(spec);
+}
+
+// Runs on the fetch worker, so a page is parsed before it is asked for
+static void speculation_done(int ok, void* userdata)
+{
+  Speculation* spec = userdata;
+
+  if (ok && spec->size >= 100) {
+    spec->fields = calloc(5, sizeof(*spec->fields));
+    if (spec->fields)
+      spec->count = extract_novel_info(spec->html, spec->fields[0], spec->fields[1], spec->fields[2],
+                                       spec->fields[3], spec->fields[4]);
+  }
+  free(spec->html);
+  spec->html = NULL;
+
+  pthread_mutex_lock(&speculation_lock);
+  spec->finished = 1;
+  int orphaned = spec->orphaned;
+  pthread_mutex_unlock(&speculation_lock);
+
+  if (orphaned) speculation_free(spec);
+}
+
+static int speculation_finished(Speculation* spec)
+{
+  pthread_mutex_lock(&speculation_lock);
+  int finished = spec->finished;
+  pthread_mutex_unlock(&speculation_lock);
+  return finished;
+}
+
+static void speculation_drop(int slot)
+{
+  Speculation* spec = speculations[slot];
+  if (!spec) return;
+  speculations[slot] = NULL;
+  if (fetcher_abandon(spec->job, &speculation_lock, &spec->finished, &spec->orphaned)) speculation_free(spec);
+}
+
+// Moves a finished speculation into the page cache
+static PageCache* speculation_keep(int slot)
+{
+  Speculation* spec = speculations[slot];
+  PageCache* page = NULL;
+  if (spec->count > 0) page = keep_page(spec->query, spec->page_number, spec->fields, spec->count, &spec->validators);
+  else note_dead_page(spec->query, spec->page_number);
+  speculation_drop(slot);
+  return page;
+}
+
+static int speculation_slot(const char* query, int page)
+{
+  for (int i = 0; i < SPECULATIVE_PAGES; i++) {
+    if (speculations[i] && speculations[i]->page_number == page && strcmp(speculations[i]->query, query) == 0)
+      return i;
+  }
+  return -1;
+}
+
+/**
+ * Fetches the pages before and after current_page in the background unless
+ * they are already in memory or on disk, or came back empty or failed for
+ * this query before, and drops speculation about any other page. Finished ones are parsed by then and only need storing.
+ */
+static void speculate_pages(const char* query, char* escaped, int current_page)
+{
+  int wanted[SPECULATIVE_PAGES] = { current_page + 1, current_page - 1 };
+
+  for (int i = 0; i < SPECULATIVE_PAGES; i++) {
+    Speculation* spec = speculations[i];
+    if (!spec) continue;
+    int keep = strcmp(spec->query, query) == 0 &&
+               (spec->page_number == wanted[0] || spec->page_number == wanted[1]);
+    if (keep && speculation_finished(spec)) speculation_keep(i);
+    else if (!keep) speculation_drop(i);
+  }
+
+  get_card_matcher(); // Built here, never first on the worker
+  for (int w = 0; w < SPECULATIVE_PAGES; w++) {
+    int page = wanted[w];
+    if (page < 1 || is_dead_page(query, page)) continue;
+    if (find_page(query, page) || speculation_slot(query, page) >= 0) continue;
+    if (load_page(query, page)) continue;
+
+    int slot = 0;
+    while (slot < SPECULATIVE_PAGES && speculations[slot]) slot++;
+    if (slot == SPECULATIVE_PAGES) break;
+
+    Speculation* spec = calloc(1, sizeof(Speculation));
+    if (!spec) break;
+    snprintf(spec->query, sizeof(spec->query), "%s", query);
+    spec->page_number = page;
+
+    char url[512];
+    page_url(url, sizeof(url), escaped, page);
+    FetchSink sink = {
+      .header = speculation_header, .write = speculation_write, .done = speculation_done, .userdata = spec,
+    };
+    spec->job = fetcher_submit(url, FETCH_PRIORITY_PREFETCH, &sink);
+    if (!spec->job) {
+      free(spec);
+      break;
+    }
+    speculations[slot] = spec;
+    page_stats.speculated++;
+  }
+}
+
+/**
+ * The page, if it was being fetched ahead: joined with progress shown if
+ * it has not arrived yet. NULL if there was no such speculation or it
+ * failed; *state says if the user cancelled it.
+ */
+static PageCache* take_speculated_page(const char* query, int current_page, FetchState* state)
+{
+  *state = FETCH_FAILED;
+  int slot = speculation_slot(query, current_page);
+  if (slot < 0) return NULL;
+
+  // The user is waiting on it now, not just maybe later
+  fetcher_promote(speculations[slot]->job);
+
+  char label[64];
+  snprintf(label, sizeof(label), "Fetching page %d...", current_page);
+  *state = event_await(speculations[slot]->job, label);
+  if (*state == FETCH_FAILED) note_dead_page(query, current_page);
+  if (*state != FETCH_DONE) {
+    speculation_drop(slot);
+    return NULL;
+  }
+
+  PageCache* page = speculation_keep(slot);
+  if (page) page_stats.speculative_hits++;
+  return page;
+}
+
+static void warm_chapter_list(const NovelCard* card)
+{
+  chapter_list_warm(card->slug);
 }
 
 void search_webnovel() {
@@ -225,19 +723,31 @@ void search_webnovel() {
   getnstr(query, sizeof(query) - 1);
   noecho();
 
-  CURL *curl = curl_easy_init();
-  char *escaped = curl_easy_escape(curl, query, 0);
+  char *escaped = curl_easy_escape(NULL, query, 0);
 
-  clear_cache();
   int current_page = 1;
+  WebnovelListView view = {0};
 
   while (1) {
 
-    PageCache* cached = get_cached_page(current_page);
-    int count, action;
+    // Pages render from memory or disk first; stale ones are checked meanwhile
+    PageCache* cached = get_cached_page(query, current_page);
+    int action;
+
+    if (!cached) cached = load_page(query, current_page);
+    if (cached && !cached->revalidation &&
+        revalidate_due(cached->fetched_at, "novel_search_ttl", NOVEL_SEARCH_DEFAULT_TTL)) {
+      char url[512];
+      page_url(url, sizeof(url), escaped, current_page);
+      cached->revalidation = revalidate_start(url, &cached->validators);
+    }
 
     if (!cached) {
-      if (fetch_page(current_page, &page_cache[current_page], escaped) <= 0){
+      FetchState state;
+      cached = take_speculated_page(query, current_page, &state);
+      if (!cached && state != FETCH_CANCELLED) cached = fetch_page(query, current_page, escaped, &state);
+      if (!cached && state == FETCH_CANCELLED) break;
+      if (!cached){
         clear();
         attron(COLOR_PAIR(4));
         mvprintw(0, 0, "No Search Results Found.");
@@ -247,35 +757,36 @@ void search_webnovel() {
         getch();
         break;
       }
-
-      cached = &page_cache[current_page];
     }
 
-    count = cached->count;
+    if (cached->revalidation) page_revalidated(cached);
+    // Flips to either side are served from memory by the time they come
+    speculate_pages(query, escaped, current_page);
+    action = display_webnovel_list(cached, &current_page, &view, warm_chapter_list);
 
-    action = display_webnovel_list(
-      cached->titles,
-      count,
-      cached->yearly_views,
-      cached->chapters,
-      cached->ratings,
-      cached->slugs,
-      &current_page
-    );
-
-    if (action == -2) {
+    if (action == MENU_UPDATED) {
+      continue;
+    }
+    else if (action == -1) {
+      memset(&view, 0, sizeof(view)); // A new page starts unfiltered
+    }
+    else if (action == -2) {
       break;
     }
     else if (action >= 0) {
-      char novel_chapters[3500][128] = {0};
-      char novel_chapter_titles[3500][128] = {0};
+      ChapterIndex novel_chapters;
+      chapter_index_init(&novel_chapters);
+
+      const NovelCard* card = &cached->cards[action];
 
-      int total_chapters = fetch_novel_chapters(cached->slugs[action], novel_chapters, novel_chapter_titles);
-      show_chapter_browser(novel_chapters, novel_chapter_titles, total_chapters, cached->titles[action], cached->slugs[action], 0);
+      chapter_list_open(card->slug, &novel_chapters);
+      show_chapter_browser(&novel_chapters, card->title, card->slug, 0);
+      chapter_list_close();
+      chapter_index_free(&novel_chapters);
     }
   }
 
+  for (int i = 0; i < SPECULATIVE_PAGES; i++) speculation_drop(i);
   curl_free(escaped);
-  curl_easy_cleanup(curl);
   endwin();
 }
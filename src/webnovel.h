@@ -1,6 +1,9 @@
 #ifndef WEBNOVEL_H
 #define WEBNOVEL_H
 
+#include "cache.h"
+#include "fetcher.h"
+
 int extract_novel_info(
     char *html, 
     char titles[12][256], 
@@ -12,6 +15,13 @@ int extract_novel_info(
 
 void search_webnovel();
 
-char *fetch_url(const char *url);
+void page_cache_get_stats(PageCacheStats* out);
+
+/**
+ * Fetches url into memory, showing label and progress until it arrives or
+ * Esc cancels it; *state says which. validators, when given, receive the
+ * response's ETag and Last-Modified.
+ */
+char *fetch_url(const char *url, HttpValidators* validators, const char* label, FetchState* state);
 
 #endif
@@ -0,0 +1,283 @@
+#define _POSIX_C_SOURCE 200809L
+#define _XOPEN_SOURCE 700 // wcwidth
+
+#include "wrap.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <wchar.h>
+
+/**
+ * Lays out the row of s starting at `start` in `width` columns. Returns
+ * where its text ends and sets *next to where the following row starts,
+ * which is len for the last row. Breaks after a word or a double-width
+ * character when one fits, and in the middle of a word otherwise.
+ */
+static size_t fit_row(const char* s, size_t len, size_t start, int width, size_t* next) {
+  mbstate_t state;
+  memset(&state, 0, sizeof(state));
+
+  size_t p = start;
+  size_t brk = start;
+  int col = 0;
+  int in_word = 0;
+
+  while (p < len) {
+    unsigned char c = s[p];
+    size_t n = 1;
+    int cw = 1;
+    wchar_t wc = c;
+
+    if (c == '\t') {
+      cw = 8 - col % 8;
+    } else if (c < 0x20 || c == 0x7f) {
+      cw = 2; // Drawn as ^X
+    } else if (c >= 0x80) {
+      n = mbrtowc(&wc, s + p, len - p, &state);
+      if (n == (size_t)-1 || n == (size_t)-2) {
+        memset(&state, 0, sizeof(state)); // Invalid byte; take it as one column
+        n = 1;
+        wc = 0;
+      } else if ((cw = wcwidth(wc)) < 0) {
+        cw = 1;
+      }
+    }
+
+    if (col + cw > width && p > start) break;
+
+    if (c == ' ' || c == '\t') {
+      if (in_word) brk = p;
+      in_word = 0;
+    } else {
+      in_word = 1;
+    }
+    col += cw;
+    p += n;
+    if (cw == 2) brk = p; // CJK text may break between any two characters
+  }
+
+  if (p >= len) {
+    *next = len;
+    return len;
+  }
+
+  if ((s[p] == ' ' || s[p] == '\t') && in_word) brk = p;
+  if (brk == start) brk = p; // One word wider than the row
+
+  size_t q = brk;
+  while (q < len && (s[q] == ' ' || s[q] == '\t')) q++;
+  *next = q;
+  return brk;
+}
+
+// Start of row n of a line
+static size_t row_start(const char* s, size_t len, int width, int n) {
+  size_t pos = 0;
+  while (n-- > 0) fit_row(s, len, pos, width, &pos);
+  return pos;
+}
+
+// Which row of a line holds byte pos
+static int row_index(const char* s, size_t len, int width, size_t pos) {
+  size_t start = 0, next;
+  int idx = 0;
+  for (;;) {
+    fit_row(s, len, start, width, &next);
+    if (next > pos || next >= len) return idx;
+    start = next;
+    idx++;
+  }
+}
+
+static int count_rows(const char* s, size_t len, int width) {
+  size_t next = 0;
+  int n = 0;
+  do {
+    fit_row(s, len, next, width, &next);
+    n++;
+  } while (next < len);
+  return n;
+}
+
+// Rows line i takes, measuring and remembering it if needed; 0 past the end
+static int line_rows(WrapIndex* w, int i) {
+  if (i < w->cap && w->rows[i] != 0 && w->rows[i] != UINT16_MAX) return w->rows[i];
+
+  size_t len;
+  const char* s = line_map_line(w->map, i, &len);
+  if (!s) return 0;
+  int n = count_rows(s, len, w->width);
+
+  if (i >= w->cap) {
+    int cap = w->cap ? w->cap : 1024;
+    while (cap <= i) cap *= 2;
+    uint16_t* ptr = realloc(w->rows, cap * sizeof(uint16_t));
+    if (!ptr) return n;
+    memset(ptr + w->cap, 0, (cap - w->cap) * sizeof(uint16_t));
+    w->rows = ptr;
+    w->cap = cap;
+  }
+  // A line this long is simply counted again each time
+  w->rows[i] = n < UINT16_MAX ? n : UINT16_MAX;
+  return n;
+}
+
+void wrap_init(WrapIndex* w, LineMap* map, int width) {
+  memset(w, 0, sizeof(*w));
+  w->map = map;
+  w->width = width > 0 ? width : 1;
+  w->total = -1;
+}
+
+int wrap_set_width(WrapIndex* w, int width) {
+  if (width < 1) width = 1;
+  if (width == w->width) return 0;
+
+  w->width = width;
+  if (w->rows) memset(w->rows, 0, w->cap * sizeof(uint16_t));
+  w->sweep = 0;
+  w->total = -1;
+  return 1;
+}
+
+WrapPos wrap_snap(WrapIndex* w, WrapPos at) {
+  size_t len;
+  const char* s = line_map_line(w->map, at.line, &len);
+  if (!s) {
+    WrapPos last = {line_map_count(w->map) - 1, 0};
+    if (last.line < 0) last.line = 0;
+    return last;
+  }
+
+  if (at.pos > len) at.pos = len;
+  at.pos = row_start(s, len, w->width, row_index(s, len, w->width, at.pos));
+  return at;
+}
+
+int wrap_step(WrapIndex* w, WrapPos* at, int delta) {
+  int moved = 0;
+  size_t len;
+
+  while (delta > 0) {
+    const char* s = line_map_line(w->map, at->line, &len);
+    if (!s) break;
+
+    // A measured line is skipped whole when the move goes past it
+    int known = at->line < w->cap && w->rows[at->line] != UINT16_MAX ? w->rows[at->line] : 0;
+    if (at->pos == 0 && known && known <= delta && line_map_line(w->map, at->line + 1, &len)) {
+      moved += known;
+      delta -= known;
+      at->line++;
+      continue;
+    }
+
+    size_t next;
+    fit_row(s, len, at->pos, w->width, &next);
+    if (next < len) {
+      at->pos = next;
+    } else {
+      if (!line_map_line(w->map, at->line + 1, &len)) break;
+      at->line++;
+      at->pos = 0;
+    }
+    moved++;
+    delta--;
+  }
+
+  while (delta < 0) {
+    const char* s = line_map_line(w->map, at->line, &len);
+    int idx = s && at->pos > 0 ? row_index(s, len, w->width, at->pos) : 0;
+    if (idx > 0) {
+      int k = idx < -delta ? idx : -delta;
+      at->pos = row_start(s, len, w->width, idx - k);
+      moved -= k;
+      delta += k;
+      continue;
+    }
+    if (at->line == 0) break;
+
+    // Into the previous line: its last row costs one, its first all of them
+    at->line--;
+    int rows = line_rows(w, at->line);
+    int k = rows < -delta ? rows : -delta;
+    s = line_map_line(w->map, at->line, &len);
+    at->pos = row_start(s, len, w->width, rows - k);
+    moved -= k;
+    delta += k;
+  }
+
+  return moved;
+}
+
+int wrap_clamp_bottom(WrapIndex* w, WrapPos* at, int height) {
+  WrapPos probe = *at;
+  int below = wrap_step(w, &probe, height - 1);
+  if (below >= height - 1) return 0;
+  return wrap_step(w, at, below - (height - 1));
+}
+
+static int before(WrapPos a, WrapPos b) {
+  return a.line < b.line || (a.line == b.line && a.pos < b.pos);
+}
+
+int wrap_reveal(WrapIndex* w, WrapPos* top, int height, WrapPos at) {
+  at = wrap_snap(w, at);
+  if (!before(at, *top)) {
+    WrapPos bottom = *top;
+    wrap_step(w, &bottom, height - 1);
+    if (!before(bottom, at)) return 0;
+  }
+
+  // A third of the way down, so what follows is in view too
+  *top = at;
+  wrap_step(w, top, -(height / 3));
+  wrap_clamp_bottom(w, top, height);
+  return 1;
+}
+
+const char* wrap_row(WrapIndex* w, WrapPos at, size_t* len) {
+  size_t line_len;
+  const char* s = line_map_line(w->map, at.line, &line_len);
+  if (!s) return NULL;
+
+  size_t next;
+  *len = fit_row(s, line_len, at.pos, w->width, &next) - at.pos;
+  return s + at.pos;
+}
+
+int wrap_measure(WrapIndex* w, int budget) {
+  if (w->total >= 0) return 0;
+
+  size_t len;
+  while (budget-- > 0 && line_map_line(w->map, w->sweep, &len)) {
+    line_rows(w, w->sweep);
+    w->sweep++;
+  }
+  if (line_map_line(w->map, w->sweep, &len)) return 1;
+
+  long total = 0;
+  for (int i = 0; i < w->sweep; i++) total += line_rows(w, i);
+  w->total = total < INT32_MAX ? (int)total : INT32_MAX;
+  return 0;
+}
+
+int wrap_row_number(WrapIndex* w, WrapPos at) {
+  if (w->total < 0) return -1;
+
+  long row = 0;
+  for (int i = 0; i < at.line; i++) row += line_rows(w, i);
+
+  size_t len;
+  const char* s = line_map_line(w->map, at.line, &len);
+  if (s) row += row_index(s, len, w->width, at.pos);
+  return row < INT32_MAX ? (int)row : INT32_MAX;
+}
+
+int wrap_total(const WrapIndex* w) {
+  return w->total;
+}
+
+void wrap_free(WrapIndex* w) {
+  free(w->rows);
+  memset(w, 0, sizeof(*w));
+}
@@ -0,0 +1,68 @@
+#ifndef WRAP_H
+#define WRAP_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "line_map.h"
+
+// Lines wrap_measure() is asked to do between two checks for a key
+#define WRAP_MEASURE_SLICE 2048
+
+// A screen row: the line it belongs to and the byte it starts at
+typedef struct {
+  int line;
+  size_t pos;
+} WrapPos;
+
+/**
+ * Word wrap over the lines of a LineMap, measured in terminal columns so
+ * multibyte and double-width text break where it is drawn. Rows are never
+ * stored: the index only remembers how many rows each line takes, filled
+ * in as lines are looked at or by wrap_measure() while the reader is idle.
+ * Positions are byte offsets, so they survive a change of width.
+ */
+typedef struct {
+  LineMap* map;
+  int width;
+  uint16_t* rows;   // Rows each line takes at width; 0 if not measured yet
+  int cap;
+  int sweep;        // Next line wrap_measure() looks at
+  int total;        // Rows in all, or -1 until every line is measured
+} WrapIndex;
+
+void wrap_init(WrapIndex* w, LineMap* map, int width);
+
+// Rewraps at a new width, lazily; returns whether the width changed
+int wrap_set_width(WrapIndex* w, int width);
+
+/**
+ * Start of the row holding byte `at.pos` of `at.line`. Only that line is
+ * rewrapped, so it puts the view back after a resize in constant time;
+ * a line past the end becomes the last one.
+ */
+WrapPos wrap_snap(WrapIndex* w, WrapPos at);
+
+// Moves delta rows (negative is up), stopping at either end; returns rows moved
+int wrap_step(WrapIndex* w, WrapPos* at, int delta);
+
+// Moves up if fewer than `height` rows are left from at; returns rows moved
+int wrap_clamp_bottom(WrapIndex* w, WrapPos* at, int height);
+
+// Moves a view of `height` rows starting at top so it shows `at`; returns whether it moved
+int wrap_reveal(WrapIndex* w, WrapPos* top, int height, WrapPos at);
+
+// Text of the row at `at`, without the spaces it breaks on; NULL past the end
+const char* wrap_row(WrapIndex* w, WrapPos at, size_t* len);
+
+// Measures up to budget more lines; returns whether any are left
+int wrap_measure(WrapIndex* w, int budget);
+
+// Index of the row at `at`, or -1 while the total is still unknown
+int wrap_row_number(WrapIndex* w, WrapPos at);
+
+int wrap_total(const WrapIndex* w);
+
+void wrap_free(WrapIndex* w);
+
+#endif